@@ -0,0 +1,16 @@
+#
+# SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+# SPDX-License-Identifier: Apache-2.0
+#
+
+set(BENCHMARK_PATH "BENCHMARK-NOTFOUND" CACHE PATH "Path to Google Benchmark")
+
+if(EXISTS ${BENCHMARK_PATH}/CMakeLists.txt)
+    if(NOT TARGET benchmark)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        add_subdirectory(${BENCHMARK_PATH} benchmark SYSTEM EXCLUDE_FROM_ALL)
+    endif()
+else()
+    find_package(benchmark REQUIRED)
+endif()
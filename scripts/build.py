@@ -47,6 +47,7 @@ class Builder:
         self.test_dir = pathlib.Path(self.build_dir) / "src" / "tests"
         self.threads = args.threads
         self.run_tests = args.test
+        self.build_benchmarks = args.benchmark
         self.build_type = args.build_type
         self.target_platform = args.target_platform
         self.cmake_toolchain_for_android = args.cmake_toolchain_for_android
@@ -57,6 +58,7 @@ class Builder:
         self.vgf_lib_path = absolute(args.vgf_lib_path)
         self.json_path = absolute(args.json_path)
         self.gtest_path = absolute(args.gtest_path)
+        self.benchmark_path = absolute(args.benchmark_path)
         self.flatbuffers_path = absolute(args.flatbuffers_path)
         self.glslang_path = absolute(args.glslang_path)
         self.dxc_path = absolute(args.dxc_path)
@@ -238,6 +240,10 @@ class Builder:
             cmake_setup_cmd.append(f"-DGTEST_PATH={self.gtest_path}")
             cmake_setup_cmd.append(f"-DPYBIND11_PATH={self.pybind11_path}")
 
+        if self.build_benchmarks:
+            cmake_setup_cmd.append("-DSCENARIO_RUNNER_BUILD_BENCHMARKS=ON")
+            cmake_setup_cmd.append(f"-DBENCHMARK_PATH={self.benchmark_path}")
+
         if self.doc:
             cmake_setup_cmd.append("-DSCENARIO_RUNNER_BUILD_DOCS=ON")
 
@@ -591,6 +597,12 @@ def parse_arguments(argv=None):
         action="store_true",
         default=False,
     )
+    parser.add_argument(
+        "--benchmark",
+        help="Build the host microbenchmarks. Default: %(default)s",
+        action="store_true",
+        default=False,
+    )
     parser.add_argument(
         "--build-type",
         help="Type of build to perform. Default: %(default)s",
@@ -661,6 +673,11 @@ def parse_arguments(argv=None):
         help="Path to googletest repo. Default: %(default)s",
         default=f"{DEPENDENCY_DIR / 'googletest'}",
     )
+    parser.add_argument(
+        "--benchmark-path",
+        help="Path to Google Benchmark repo. Default: %(default)s",
+        default=f"{DEPENDENCY_DIR / 'benchmark'}",
+    )
     parser.add_argument(
         "--flatbuffers-path",
         help="Path to flatbuffers repo. Default: %(default)s",
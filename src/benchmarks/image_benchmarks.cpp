@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dds_reader.hpp"
+#include "png_reader.hpp"
+
+#include "vgf-utils/temp_folder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+constexpr uint32_t rgba8ElementSize = 4;
+
+std::vector<char> makeRgba8Pixels(uint32_t extent) {
+    std::vector<char> pixels(static_cast<size_t>(extent) * extent * rgba8ElementSize);
+    for (size_t index = 0; index < pixels.size(); ++index) {
+        pixels[index] = static_cast<char>(index * 31 % 251);
+    }
+    return pixels;
+}
+
+void BM_SaveDataToPNG(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto path = tempFolder.relative("output.png").string();
+    const auto extent = static_cast<uint32_t>(state.range(0));
+    const auto pixels = makeRgba8Pixels(extent);
+    const ImageSaveOptions options{{1, extent, extent, rgba8ElementSize}, vk::Format::eR8G8B8A8Unorm, pixels};
+
+    for (auto _ : state) {
+        saveDataToPNG(path, options);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pixels.size()));
+}
+BENCHMARK(BM_SaveDataToPNG)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+void BM_LoadDataFromPNG(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto path = tempFolder.relative("input.png").string();
+    const auto extent = static_cast<uint32_t>(state.range(0));
+    const auto pixels = makeRgba8Pixels(extent);
+    saveDataToPNG(path, {{1, extent, extent, rgba8ElementSize}, vk::Format::eR8G8B8A8Unorm, pixels});
+
+    for (auto _ : state) {
+        auto result = loadDataFromPNG(path, {});
+        benchmark::DoNotOptimize(result.data.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pixels.size()));
+}
+BENCHMARK(BM_LoadDataFromPNG)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+void BM_LoadDataFromDDS(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto path = tempFolder.relative("input.dds").string();
+    const auto extent = static_cast<uint32_t>(state.range(0));
+    const auto pixels = makeRgba8Pixels(extent);
+    {
+        const auto header = generateDefaultDDSHeader(extent, extent, rgba8ElementSize, DXGI_FORMAT_R8G8B8A8_UNORM);
+        std::ofstream file(path, std::ofstream::binary);
+        saveHeaderToDDS(header, file);
+        file.write(pixels.data(), static_cast<std::streamsize>(pixels.size()));
+    }
+
+    for (auto _ : state) {
+        auto result = loadDataFromDDS(path, {});
+        benchmark::DoNotOptimize(result.data.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pixels.size()));
+}
+BENCHMARK(BM_LoadDataFromDDS)->Arg(256)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "json_writer.hpp"
+#include "perf_counter.hpp"
+#include "scenario_desc.hpp"
+
+#include "nlohmann/json.hpp"
+#include "vgf-utils/temp_folder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+/// \brief Scenario with @p dispatchCount compute dispatches, each reading and writing its own buffers
+std::string generateScenario(int64_t dispatchCount) {
+    nlohmann::json resources = nlohmann::json::array();
+    nlohmann::json commands = nlohmann::json::array();
+    resources.push_back(
+        {{"shader", {{"uid", "shader"}, {"src", "shader.spv"}, {"entry", "main"}, {"type", "SPIR-V"}}}});
+    for (int64_t index = 0; index < dispatchCount; ++index) {
+        const auto input = "input_" + std::to_string(index);
+        const auto output = "output_" + std::to_string(index);
+        resources.push_back({{"buffer", {{"uid", input}, {"size", 4096}, {"shader_access", "readonly"}}}});
+        resources.push_back({{"buffer", {{"uid", output}, {"size", 4096}, {"shader_access", "writeonly"}}}});
+        commands.push_back({{"dispatch_compute",
+                             {{"bindings",
+                               {{{"set", 0}, {"id", 0}, {"resource_ref", input}},
+                                {{"set", 0}, {"id", 1}, {"resource_ref", output}}}},
+                              {"shader_ref", "shader"},
+                              {"rangeND", {1024, 1, 1}}}}});
+    }
+    return nlohmann::json{{"resources", resources}, {"commands", commands}}.dump();
+}
+
+void BM_ParseScenario(benchmark::State &state) {
+    const auto scenario = generateScenario(state.range(0));
+    for (auto _ : state) {
+        ScenarioSpec spec(scenario);
+        benchmark::DoNotOptimize(spec.commands.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scenario.size()));
+}
+BENCHMARK(BM_ParseScenario)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+void BM_WritePerfCounters(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto path = tempFolder.relative("perf_counters.json");
+    PerfCounterRegistry registry(64);
+    for (int64_t counter = 0; counter < state.range(0); ++counter) {
+        const auto id = registry.registerCounter("Counter " + std::to_string(counter), PerfCategory::RunScenario);
+        for (int64_t sample = 0; sample < 1000; ++sample) {
+            registry.record(id, sample);
+        }
+    }
+    for (auto _ : state) {
+        writePerfCounters(registry, path);
+    }
+}
+BENCHMARK(BM_WritePerfCounters)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+void BM_WriteProfilingData(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    RuntimeProfilingData profilingData;
+    profilingData.timestampPeriod = 1.0f;
+    for (int64_t command = 0; command < state.range(0); ++command) {
+        profilingData.commands.push_back({"ComputeDispatch", "dispatch_" + std::to_string(command)});
+        profilingData.timestamps.push_back(static_cast<uint64_t>(command) * 100);
+        profilingData.timestamps.push_back(static_cast<uint64_t>(command) * 100 + 50);
+    }
+    ProfilingWriter writer(tempFolder.relative("profiling.jsonl"));
+    int iteration = 0;
+    for (auto _ : state) {
+        writer.write(profilingData, {}, iteration++);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_WriteProfilingData)->Arg(16)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "logging.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+using namespace mlsdk::logging;
+
+namespace {
+
+/// Mirrors the messages logged for every command while a command buffer is recorded
+const std::string commandName = "dispatch_compute_add";
+
+void discardMessage(const std::string &, LogLevel, const std::string &message) { benchmark::DoNotOptimize(message); }
+
+/// Filtered messages built and passed to the logging functions, as before the logging macros
+void BM_RecordingLogFilteredEager(benchmark::State &state) {
+    setDefaultHandler(discardMessage);
+    setDefaultLogLevel(LogLevel::Error);
+    for (auto _ : state) {
+        for (int64_t command = 0; command < state.range(0); ++command) {
+            info("Dispatch compute");
+            debug("Command " + commandName + " #" + std::to_string(command) + " recorded");
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    setDefaultLogLevel(LogLevel::Info);
+}
+BENCHMARK(BM_RecordingLogFilteredEager)->RangeMultiplier(8)->Range(64, 4096);
+
+/// Filtered messages through the logging macros, which skip building the message
+void BM_RecordingLogFilteredMacro(benchmark::State &state) {
+    setDefaultHandler(discardMessage);
+    setDefaultLogLevel(LogLevel::Error);
+    for (auto _ : state) {
+        for (int64_t command = 0; command < state.range(0); ++command) {
+            MLSDK_LOG_INFO("Dispatch compute");
+            MLSDK_LOG_DEBUG("Command " + commandName + " #" + std::to_string(command) + " recorded");
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    setDefaultLogLevel(LogLevel::Info);
+}
+BENCHMARK(BM_RecordingLogFilteredMacro)->RangeMultiplier(8)->Range(64, 4096);
+
+/// Enabled messages formatted by a handler on the calling thread or on the asynchronous sink
+void BM_RecordingLogEnabled(benchmark::State &state) {
+    const bool async = state.range(0) != 0;
+    std::ostringstream output;
+    setDefaultHandler([&output](const std::string &logger, LogLevel logLevel, const std::string &message) {
+        output << logger << " " << logLevel << " " << message << "\n";
+    });
+    setDefaultLogLevel(LogLevel::Info);
+    setAsyncLogging(async);
+    for (auto _ : state) {
+        MLSDK_LOG_INFO("Dispatch compute");
+    }
+    // Delivering the backlog happens outside the timed loop as it is not part of the recording cost
+    setAsyncLogging(false);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    setDefaultHandler(discardMessage);
+}
+BENCHMARK(BM_RecordingLogEnabled)->ArgName("async")->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensor.hpp"
+
+#include "vgf-utils/memory_map.hpp"
+#include "vgf-utils/numpy.hpp"
+#include "vgf-utils/temp_folder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+/// Mirrors the input path of buffer and tensor resources: map the NumPy file, parse it and copy the payload out
+void BM_NumpyParseAndCopy(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto path = tempFolder.relative("input.npy").string();
+    const auto size = state.range(0);
+    std::vector<char> payload(static_cast<size_t>(size), 0x5A);
+    vgfutils::numpy::write(path, vgfutils::numpy::DataPtr(payload.data(), {size}, vgfutils::numpy::DType('i', 1)));
+
+    for (auto _ : state) {
+        MemoryMap mapped(path);
+        const auto parsedData = vgfutils::numpy::parse(mapped);
+        std::vector<char> data(parsedData.size());
+        std::memcpy(data.data(), parsedData.ptr, parsedData.size());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_NumpyParseAndCopy)->RangeMultiplier(16)->Range(64 << 10, 64 << 20)->Unit(benchmark::kMicrosecond);
+
+/// Rows of shape[3] elements padded to the next 64-byte boundary, as for an optimally tiled tensor
+void BM_PackStridedTensorPaddedRows(benchmark::State &state) {
+    const int64_t elementSize = 4;
+    const std::vector<int64_t> shape{1, state.range(0), state.range(0), 30};
+    const int64_t rowStride = (shape[3] * elementSize + 63) / 64 * 64;
+    const std::vector<int64_t> strides{shape[1] * shape[2] * rowStride, shape[2] * rowStride, rowStride, elementSize};
+    const std::vector<char> strided(static_cast<size_t>(strides[0]), 0x11);
+
+    for (auto _ : state) {
+        auto packed = packStridedTensorData(strided.data(), shape, strides, elementSize);
+        benchmark::DoNotOptimize(packed.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * shape[1] * shape[2] * shape[3] * elementSize);
+}
+BENCHMARK(BM_PackStridedTensorPaddedRows)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+/// Every element padded to twice its size, which forces a per-element copy
+void BM_PackStridedTensorPaddedElements(benchmark::State &state) {
+    const int64_t elementSize = 2;
+    const std::vector<int64_t> shape{1, state.range(0), state.range(0), 16};
+    const std::vector<int64_t> strides{shape[1] * shape[2] * shape[3] * elementSize * 2,
+                                       shape[2] * shape[3] * elementSize * 2, shape[3] * elementSize * 2,
+                                       elementSize * 2};
+    const std::vector<char> strided(static_cast<size_t>(strides[0]), 0x22);
+
+    for (auto _ : state) {
+        auto packed = packStridedTensorData(strided.data(), shape, strides, elementSize);
+        benchmark::DoNotOptimize(packed.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * shape[1] * shape[2] * shape[3] * elementSize);
+}
+BENCHMARK(BM_PackStridedTensorPaddedElements)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vgf_view.hpp"
+
+#include "vgf/encoder.hpp"
+#include "vgf/vulkan_helpers.generated.hpp"
+
+#include "vgf-utils/temp_folder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+namespace vgflib = mlsdk::vgflib;
+
+namespace {
+
+/// \brief VGF with @p segmentCount compute segments, each writing its own intermediate buffer
+std::string writeVgfWithSegments(TempFolder &tempFolder, int64_t segmentCount) {
+    auto encoder = vgflib::CreateEncoder(123);
+    const std::vector<int64_t> shape{1024};
+
+    for (int64_t index = 0; index < segmentCount; ++index) {
+        const auto name = "segment_" + std::to_string(index);
+        const auto module = encoder->AddModule(vgflib::ModuleType::COMPUTE, name, "main");
+        const auto buffer =
+            encoder->AddIntermediateResource(vgflib::ToDescriptorType(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+                                             vgflib::ToFormatType(VK_FORMAT_R8_UINT), shape, {});
+        const auto binding = encoder->AddBindingSlot(0, buffer);
+        const auto descriptorSet = encoder->AddDescriptorSetInfo(std::vector<vgflib::BindingSlotRef>{binding});
+        encoder->AddSegmentInfo(module, name, std::vector<vgflib::DescriptorSetInfoRef>{descriptorSet}, {},
+                                std::vector<vgflib::BindingSlotRef>{binding},
+                                std::vector<vgflib::GraphConstantBindingRef>{}, {1, 1, 1});
+    }
+    encoder->AddModelSequenceInputsOutputs({}, {}, {}, {});
+    encoder->Finish();
+
+    const auto vgfPath = tempFolder.relative("segments_" + std::to_string(segmentCount) + ".vgf").string();
+    std::ofstream output(vgfPath, std::ios::binary);
+    encoder->WriteTo(output);
+    return vgfPath;
+}
+
+void BM_CreateVgfView(benchmark::State &state) {
+    TempFolder tempFolder("scenario_runner_benchmarks");
+    const auto vgfPath = writeVgfWithSegments(tempFolder, state.range(0));
+
+    for (auto _ : state) {
+        auto view = VgfView::createVgfView(vgfPath);
+        benchmark::DoNotOptimize(view.getNumSegments());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CreateVgfView)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+
+} // namespace
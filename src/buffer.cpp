@@ -35,6 +35,7 @@ void Buffer::setup(const Context &ctx, std::shared_ptr<ResourceMemoryManager> me
         throw std::runtime_error("Buffer memory offset for '" + _debugName + "' must be aligned to " +
                                  std::to_string(memReqs.alignment) + " bytes, got " + std::to_string(_memoryOffset));
     }
+    _memoryRequirement = memReqs.size;
     _memoryManager->updateMemSize(memReqs.size + _memoryOffset);
     _memoryManager->updateMemType(memReqs.memoryTypeBits);
 }
@@ -71,12 +71,16 @@ class Buffer {
 
     std::shared_ptr<ResourceMemoryManager> memoryManager() const { return _memoryManager; }
 
+    /// \brief Get the size of device memory the buffer requires
+    vk::DeviceSize memoryRequirement() const { return _memoryRequirement; }
+
   private:
     vk::raii::Buffer _buffer{nullptr};
     uint32_t _size{0};
     std::string _debugName;
     std::shared_ptr<ResourceMemoryManager> _memoryManager;
     uint64_t _memoryOffset{0};
+    vk::DeviceSize _memoryRequirement{0};
 };
 
 } // namespace mlsdk::scenariorunner
@@ -8,8 +8,11 @@
 #include "utils.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <limits>
+#include <numeric>
 
 namespace mlsdk::scenariorunner {
 
@@ -132,7 +135,7 @@ vk::raii::CommandBuffer &Compute::getCommandBuffer() {
 }
 
 void Compute::_waitForFence() {
-    mlsdk::logging::info("Wait for fence");
+    MLSDK_LOG_INFO("Wait for fence");
     const auto timeout = WAIT_FOR_FENCE_TIMEOUT;
     auto res = _ctx.device().waitForFences({*_fence}, true, timeout);
     if (res != vk::Result::eSuccess) {
@@ -182,11 +185,13 @@ void Compute::_updateDescriptorSets(const vk::DescriptorSet &descSet, const Type
         vk::WriteDescriptorSet dwrite(descSet, static_cast<uint32_t>(binding.id), 0, 1, binding.vkDescriptorType, {},
                                       &info);
         _ctx.device().updateDescriptorSets(vk::ArrayProxy<vk::WriteDescriptorSet>(dwrite), {});
+        ++_recordingStats.descriptorWrites;
     } else if (resourceViewer.hasTensor()) {
         const vk::WriteDescriptorSetTensorARM info(1, &resourceViewer.getTensor().tensorView());
         const vk::WriteDescriptorSet dwrite(descSet, static_cast<uint32_t>(binding.id), 0, 1, binding.vkDescriptorType,
                                             {}, {}, {}, &info);
         _ctx.device().updateDescriptorSets(vk::ArrayProxy<vk::WriteDescriptorSet>(dwrite), {});
+        ++_recordingStats.descriptorWrites;
     } else if (resourceViewer.hasImage()) {
         vk::ImageView imageView;
         const Image &image = resourceViewer.getImage();
@@ -200,36 +205,57 @@ void Compute::_updateDescriptorSets(const vk::DescriptorSet &descSet, const Type
         const vk::WriteDescriptorSet dwrite(descSet, static_cast<uint32_t>(binding.id), 0, 1, binding.vkDescriptorType,
                                             &info);
         _ctx.device().updateDescriptorSets(vk::ArrayProxy<vk::WriteDescriptorSet>(dwrite), {});
+        ++_recordingStats.descriptorWrites;
     }
 }
 
 void Compute::createPipeline(const PipelineCreateArguments &args, const ShaderInfo &shaderInfo, const uint32_t *spvCode,
                              size_t spvSize) {
-    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache};
+    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache, _workerPool};
     (void)_pipelines.emplace_back(commonArgs, shaderInfo, spvCode, spvSize);
+    _usePipeline(_pipelines.size() - 1, 0, args.debugName);
 }
 
 void Compute::createPipeline(const PipelineCreateArguments &args, uint32_t segmentIndex, const VgfView &vgfView,
                              const DataManager &dataManager, bool enableNeuralStatistics,
                              vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
-    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache};
+    auto key = Pipeline::segmentKey(vgfView, segmentIndex, args.bindings, dataManager, enableNeuralStatistics,
+                                    neuralStatisticsMode);
+    if (const auto it = _sharedPipelines.find(key); it != _sharedPipelines.end()) {
+        auto &shared = it->second;
+        auto &pipeline = _pipelines[shared.pipelineIdx];
+        if (!_lastImplicitBarrier.has_value() || *_lastImplicitBarrier < shared.lastDispatch) {
+            // The last dispatch may still be executing when this one starts, so they cannot share session memory
+            shared.sessionIdx = pipeline.addSession(_ctx);
+        }
+        MLSDK_LOG_DEBUG("Graph Pipeline: " + pipeline.debugName() + " shared with " + args.debugName + ", session " +
+                        std::to_string(shared.sessionIdx));
+        _usePipeline(shared.pipelineIdx, shared.sessionIdx, args.debugName, &shared);
+        return;
+    }
+
+    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache, _workerPool};
     (void)_pipelines.emplace_back(commonArgs, segmentIndex, vgfView, dataManager, enableNeuralStatistics,
                                   neuralStatisticsMode);
+    auto &shared = _sharedPipelines.emplace(std::move(key), SharedPipeline{_pipelines.size() - 1}).first->second;
+    _usePipeline(shared.pipelineIdx, 0, args.debugName, &shared);
 }
 
 void Compute::createPipeline(const PipelineCreateArguments &args, const ShaderInfo &shaderInfo,
-                             const DataManager &dataManager, const std::vector<GraphConstantInfo> &constants,
+                             const DataManager &dataManager, std::vector<GraphConstantInfo> constants,
                              bool enableNeuralStatistics, vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
-    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache};
-    (void)_pipelines.emplace_back(commonArgs, shaderInfo, dataManager, constants, enableNeuralStatistics,
+    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache, _workerPool};
+    (void)_pipelines.emplace_back(commonArgs, shaderInfo, dataManager, std::move(constants), enableNeuralStatistics,
                                   neuralStatisticsMode);
+    _usePipeline(_pipelines.size() - 1, 0, args.debugName);
 }
 
 void Compute::createPipeline(const PipelineCreateArguments &args, const ShaderInfo &vertexShaderInfo,
                              const ShaderInfo &fragmentShaderInfo,
                              const std::vector<vk::Format> &colorAttachmentFormats) {
-    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache};
+    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, args.bindings, args.pipelineCache, _workerPool};
     (void)_pipelines.emplace_back(commonArgs, vertexShaderInfo, fragmentShaderInfo, colorAttachmentFormats);
+    _usePipeline(_pipelines.size() - 1, 0, args.debugName);
 }
 
 void Compute::createPipeline(const PipelineCreateArguments &args, const DataManager &dataManager,
@@ -240,15 +266,78 @@ void Compute::createPipeline(const PipelineCreateArguments &args, const DataMana
                              vk::DataGraphOpticalFlowGridSizeFlagsARM gridSize, uint32_t inputWidth,
                              uint32_t inputHeight) {
     const std::vector<TypedBinding> emptyBindings{};
-    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, emptyBindings, args.pipelineCache};
+    const Pipeline::CommonArguments commonArgs{_ctx, args.debugName, emptyBindings, args.pipelineCache, _workerPool};
     (void)_pipelines.emplace_back(commonArgs, dataManager, inputSearch, inputTemplate, outputFlow, inputHintMV,
                                   outputCost, performanceLevel, gridSize, inputWidth, inputHeight);
+    _usePipeline(_pipelines.size() - 1, 0, args.debugName);
+}
+
+void Compute::_usePipeline(size_t pipelineIdx, size_t sessionIdx, const std::string &dispatchName,
+                           SharedPipeline *sharedPipeline) {
+    _currentPipelineIdx = pipelineIdx;
+    _currentSessionIdx = sessionIdx;
+    _currentDispatchName = dispatchName;
+    _currentSharedPipeline = sharedPipeline;
+}
+
+void Compute::waitForPipelines() {
+    for (auto &pipeline : _pipelines) {
+        pipeline.waitForCreation(_ctx);
+    }
+    if (_ctx.sessionMemoryAliasingEnabled()) {
+        _bindAliasedSessionMemory();
+    }
+}
+
+void Compute::releaseShaderModules() {
+    for (auto &pipeline : _pipelines) {
+        pipeline.releaseShaderModules();
+    }
+}
+
+void Compute::_bindAliasedSessionMemory() {
+    std::vector<std::pair<size_t, size_t>> unboundSessions;
+    vk::DeviceSize size = 0;
+    uint32_t memoryTypeBits = ~0U;
+    for (size_t pipelineIdx = 0; pipelineIdx < _pipelines.size(); ++pipelineIdx) {
+        const auto &pipeline = _pipelines[pipelineIdx];
+        for (size_t sessionIdx = 0; sessionIdx < pipeline.sessionCount(); ++sessionIdx) {
+            if (!pipeline.hasUnboundAliasedSessionMemory(sessionIdx)) {
+                continue;
+            }
+            const auto &requirements = pipeline.aliasedSessionMemoryRequirements(sessionIdx);
+            size = std::max(size, requirements.size);
+            memoryTypeBits &= requirements.memoryTypeBits;
+            unboundSessions.emplace_back(pipelineIdx, sessionIdx);
+        }
+    }
+    if (unboundSessions.empty()) {
+        return;
+    }
+
+    // Sessions only bind from offset 0, which satisfies any alignment
+    if (_sessionMemoryPools.empty() || _sessionMemoryPools.back().size < size ||
+        (memoryTypeBits & (1U << _sessionMemoryPools.back().memoryTypeIdx)) == 0) {
+        const auto memoryTypeIdx = findMemoryIdx(_ctx, memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+        if (memoryTypeIdx == std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Cannot find a memory type shared by the aliased session memory");
+        }
+        auto &pool = _sessionMemoryPools.emplace_back();
+        pool.memory = vk::raii::DeviceMemory(_ctx.device(), vk::MemoryAllocateInfo(size, memoryTypeIdx));
+        pool.size = size;
+        pool.memoryTypeIdx = memoryTypeIdx;
+    }
+    for (const auto &[pipelineIdx, sessionIdx] : unboundSessions) {
+        _pipelines[pipelineIdx].bindAliasedSessionMemory(_ctx, sessionIdx, _sessionMemoryPools.back().memory);
+    }
+    mlsdk::logging::info("Aliased transient memory of " + std::to_string(unboundSessions.size()) +
+                         " data graph sessions: " + std::to_string(_sessionMemoryPools.back().size) + " bytes");
 }
 
 void Compute::_registerPipelineFencedCommon(const DataManager &dataManager, const std::vector<TypedBinding> &bindings,
                                             const char *pushConstantData, size_t pushConstantSize) {
-    const auto &pipeline = _pipelines.back();
-    DebugMarker dbgMrk0(this, "dispatch (" + pipeline.debugName() + ")");
+    const auto &pipeline = _pipelines[_currentPipelineIdx];
+    DebugMarker dbgMrk0(this, "dispatch (" + _currentDispatchName + ")");
 
     // Count exact number of typed resources used by this pipeline
     const auto poolSizes = getPoolSizes(bindings);
@@ -301,7 +390,7 @@ void Compute::_addBinds(const Pipeline &pipeline, const uint32_t maxSet, const u
         bindPoint = BindPoint::Graphics;
     }
 
-    _commands.emplace_back(BindPipeline{pipeline.pipeline(), bindPoint});
+    _commands.emplace_back(BindPipeline{_currentPipelineIdx, bindPoint});
 
     for (uint32_t setId = 0; setId <= maxSet; setId++) {
         _commands.emplace_back(
@@ -311,27 +400,43 @@ void Compute::_addBinds(const Pipeline &pipeline, const uint32_t maxSet, const u
 
 void Compute::_addPushConstants(const char *pushConstantData, const Pipeline &pipeline, const size_t pushConstantSize) {
     if (pushConstantData != nullptr && pushConstantSize > 0 && pipeline.pushConstantStages()) {
-        _commands.emplace_back(PushConstants{pipeline.pipelineLayout(), pushConstantData,
-                                             static_cast<uint32_t>(pushConstantSize), pipeline.pushConstantStages()});
+        _commands.emplace_back(PushConstants{pipeline.pipelineLayout(),
+                                             {pushConstantData, pushConstantData + pushConstantSize},
+                                             pipeline.pushConstantStages()});
     }
 }
 
 void Compute::_addDispatch(const ComputeDispatch &computeDispatch,
                            const std::optional<OpticalFlowDispatchInfo> &dispatchInfo) {
-    const auto &pipeline = _pipelines.back();
+    const auto &pipeline = _pipelines[_currentPipelineIdx];
     if (pipeline.isDataGraphPipeline()) {
-        DataGraphDispatch dispatch{pipeline.session(), std::nullopt, pipeline.debugName()};
+        if (_ctx.sessionMemoryAliasingEnabled() && _lastGraphDispatch.has_value() &&
+            (!_lastImplicitBarrier.has_value() || *_lastImplicitBarrier < *_lastGraphDispatch)) {
+            throw std::runtime_error("Dispatch " + _currentDispatchName +
+                                     " may overlap the previous data graph dispatch, so they cannot alias session "
+                                     "memory. Enable the implicit barrier of the previous dispatch.");
+        }
+        _lastGraphDispatch = _commands.size();
+        DataGraphDispatch dispatch{_currentPipelineIdx, _currentSessionIdx, std::nullopt, _currentDispatchName};
         if (dispatchInfo.has_value()) {
             dispatch.dispatchInfo = dispatchInfo;
         }
+        if (_currentSharedPipeline != nullptr) {
+            _currentSharedPipeline->lastDispatch = _commands.size();
+            ++_currentSharedPipeline->dispatches;
+        }
         _commands.emplace_back(dispatch);
     } else {
+        _commands.emplace_back(BeginPipelineStatistics{_nStatisticsQueries});
         _commands.emplace_back(computeDispatch);
+        _commands.emplace_back(EndPipelineStatistics{_nStatisticsQueries++});
     }
 }
 
 void Compute::_addGraphicsDispatch(const GraphicsDispatchInfo &graphicsDispatch) {
-    _commands.emplace_back(GraphicsDispatch{graphicsDispatch, _pipelines.back().debugName()});
+    _commands.emplace_back(BeginPipelineStatistics{_nStatisticsQueries});
+    _commands.emplace_back(GraphicsDispatch{graphicsDispatch, _currentDispatchName});
+    _commands.emplace_back(EndPipelineStatistics{_nStatisticsQueries++});
 }
 
 void Compute::_addImplicitBarriers() {
@@ -349,6 +454,7 @@ void Compute::_addImplicitBarriers() {
     _bufferBarriers.emplace_back(std::vector<vk::BufferMemoryBarrier2>{});
 
     DebugMarker dbgMrk1(this, "barriers (pipeline implicit)");
+    _lastImplicitBarrier = _commands.size();
     _commands.emplace_back(MemoryBarrier{memoryBarrierIdx, imageBarrierIdx, tensorBarrierIdx, bufferBarrierIdx});
 }
 
@@ -452,12 +558,6 @@ void Compute::registerMarkBoundary(const MarkBoundaryData &markBoundaryData, con
     _addMarkBoundary();
 }
 
-void Compute::submitAndWaitOnFence() {
-    // Unused arguments
-    std::vector<PerformanceCounter> perfCounters{};
-    submitAndWaitOnFence(perfCounters, 0);
-}
-
 vk::PipelineBindPoint Compute::_getBindPoint(BindPoint bindPoint) {
     vk::PipelineBindPoint vkBindPoint;
     switch (bindPoint) {
@@ -475,11 +575,16 @@ vk::PipelineBindPoint Compute::_getBindPoint(BindPoint bindPoint) {
     return vkBindPoint;
 }
 
-void Compute::_createCmdBuffer() {
+void Compute::_createCmdBuffer(bool recordOnly) {
+    waitForPipelines();
     _resetFence();
     _setNextCommandBuffer();
     _beginCommandBuffer();
 
+    const auto descriptorWrites = _recordingStats.descriptorWrites;
+    _recordingStats = CommandRecordingStats{};
+    _recordingStats.descriptorWrites = descriptorWrites;
+
     // If a frame boundary command is present, also add one after initial setup
     bool hasFrameBoundary = false;
     for (auto &cmd : _commands) {
@@ -487,7 +592,7 @@ void Compute::_createCmdBuffer() {
             hasFrameBoundary = true;
         }
     }
-    if (hasFrameBoundary && _repeatNumber == 0) {
+    if (hasFrameBoundary && _repeatNumber == 0 && !recordOnly) {
         _cmdBufferArray.back().end();
 
         auto frameBoundary = _createFrameBoundary();
@@ -503,23 +608,30 @@ void Compute::_createCmdBuffer() {
 
     for (auto &cmd : _commands) {
         if (std::holds_alternative<BindDescriptorSet>(cmd)) {
+            ++_recordingStats.descriptorSetBinds;
             auto &typedCmd = std::get<BindDescriptorSet>(cmd);
             const vk::DescriptorSet &descSet = *_descriptorSets[typedCmd.descriptorSetIdxGlobal];
 
             auto bindPoint = _getBindPoint(typedCmd.bindPoint);
+            ++_recordingStats.commands;
             _cmdBufferArray.back().bindDescriptorSets(bindPoint, typedCmd.pipelineLayout, typedCmd.descriptorSetId,
                                                       vk::ArrayProxy<vk::DescriptorSet>(descSet),
                                                       vk::ArrayProxy<uint32_t>());
         } else if (std::holds_alternative<BindPipeline>(cmd)) {
             auto &typedCmd = std::get<BindPipeline>(cmd);
             auto bindPoint = _getBindPoint(typedCmd.bindPoint);
-            _cmdBufferArray.back().bindPipeline(bindPoint, typedCmd.pipeline);
+            ++_recordingStats.commands;
+            _cmdBufferArray.back().bindPipeline(bindPoint, _pipelines[typedCmd.pipelineIdx].pipeline());
         } else if (std::holds_alternative<ComputeDispatch>(cmd)) {
-            mlsdk::logging::info("Dispatch compute");
+            ++_recordingStats.dispatches;
+            ++_recordingStats.commands;
+            MLSDK_LOG_INFO("Dispatch compute");
             auto &typedCmd = std::get<ComputeDispatch>(cmd);
             _cmdBufferArray.back().dispatch(typedCmd.gwcx, typedCmd.gwcy, typedCmd.gwcz);
         } else if (std::holds_alternative<DataGraphDispatch>(cmd)) {
-            mlsdk::logging::info("Dispatch graph");
+            ++_recordingStats.dispatches;
+            ++_recordingStats.commands;
+            MLSDK_LOG_INFO("Dispatch graph");
             auto &typedCmd = std::get<DataGraphDispatch>(cmd);
             if (typedCmd.dispatchInfo.has_value()) {
                 vk::DataGraphPipelineOpticalFlowDispatchInfoARM opticalFlowInfo{};
@@ -530,12 +642,16 @@ void Compute::_createCmdBuffer() {
                 dispatchInfo.setFlags(vk::DataGraphPipelineDispatchFlagsARM{});
                 dispatchInfo.setPNext(&opticalFlowInfo);
 
-                _cmdBufferArray.back().dispatchDataGraphARM(typedCmd.session, &dispatchInfo);
+                _cmdBufferArray.back().dispatchDataGraphARM(
+                    _pipelines[typedCmd.pipelineIdx].session(typedCmd.sessionIdx), &dispatchInfo);
             } else {
-                _cmdBufferArray.back().dispatchDataGraphARM(typedCmd.session);
+                _cmdBufferArray.back().dispatchDataGraphARM(
+                    _pipelines[typedCmd.pipelineIdx].session(typedCmd.sessionIdx));
             }
         } else if (std::holds_alternative<GraphicsDispatch>(cmd)) {
-            mlsdk::logging::info("Dispatch graphics");
+            ++_recordingStats.dispatches;
+            ++_recordingStats.commands;
+            MLSDK_LOG_INFO("Dispatch graphics");
             auto &typedCmd = std::get<GraphicsDispatch>(cmd);
 
             std::vector<vk::RenderingAttachmentInfo> colorAttachmentInfos;
@@ -580,69 +696,125 @@ void Compute::_createCmdBuffer() {
             if (!tensorBarriers.empty()) {
                 dependencyInfoExt = &tensorDependencyInfo;
             }
+            ++_recordingStats.pipelineBarriers;
+            ++_recordingStats.commands;
+            _recordingStats.barriers +=
+                memoryBarriers.size() + imageBarriers.size() + tensorBarriers.size() + bufferBarriers.size();
 
             _cmdBufferArray.back().pipelineBarrier2(vk::DependencyInfo(
                 (vk::DependencyFlags)0, memoryBarriers, bufferBarriers, imageBarriers, dependencyInfoExt));
         } else if (std::holds_alternative<PushConstants>(cmd)) {
             auto &typedCmd = std::get<PushConstants>(cmd);
+            ++_recordingStats.commands;
             _cmdBufferArray.back().pushConstants<char>(typedCmd.pipelineLayout, typedCmd.stages, 0,
-                                                       vk::ArrayProxy(typedCmd.size, typedCmd.pushConstantData));
+                                                       typedCmd.pushConstantData);
         } else if (std::holds_alternative<WriteTimestamp>(cmd)) {
             if (*_queryPool) {
                 const auto &typedCmd = std::get<WriteTimestamp>(cmd);
+                ++_recordingStats.commands;
                 _cmdBufferArray.back().writeTimestamp2(typedCmd.flag, *_queryPool, typedCmd.query);
             }
+        } else if (std::holds_alternative<BeginPipelineStatistics>(cmd)) {
+            if (*_statisticsQueryPool) {
+                const auto &typedCmd = std::get<BeginPipelineStatistics>(cmd);
+                ++_recordingStats.commands;
+                _cmdBufferArray.back().beginQuery(*_statisticsQueryPool, typedCmd.query, {});
+            }
+        } else if (std::holds_alternative<EndPipelineStatistics>(cmd)) {
+            if (*_statisticsQueryPool) {
+                const auto &typedCmd = std::get<EndPipelineStatistics>(cmd);
+                ++_recordingStats.commands;
+                _cmdBufferArray.back().endQuery(*_statisticsQueryPool, typedCmd.query);
+            }
         } else if (std::holds_alternative<MarkBoundary>(cmd)) {
             auto &typeCmd = std::get<MarkBoundary>(cmd);
             _cmdBufferArray.back().end();
-            vk::SubmitInfo submitInfo({}, {}, *_cmdBufferArray.back(), {}, &typeCmd.markBoundary);
+            if (!recordOnly) {
+                vk::SubmitInfo submitInfo({}, {}, *_cmdBufferArray.back(), {}, &typeCmd.markBoundary);
 
-            typeCmd.markBoundary.frameID = _repeatNumber++;
+                typeCmd.markBoundary.frameID = _repeatNumber++;
 
-            _queue.submit(submitInfo, *_fence);
-            _waitForFence();
-            _resetFence();
+                _queue.submit(submitInfo, *_fence);
+                _waitForFence();
+                _resetFence();
+            }
             _setNextCommandBuffer();
             _beginCommandBuffer();
         } else if (std::holds_alternative<PushDebugMarker>(cmd)) {
+            ++_recordingStats.commands;
             _cmdBufferArray.back().beginDebugUtilsLabelEXT(
                 vk::DebugUtilsLabelEXT{_debugMarkerNames[std::get<PushDebugMarker>(cmd).nameIdx].c_str()});
         } else if (std::holds_alternative<PopDebugMarker>(cmd)) {
+            ++_recordingStats.commands;
             _cmdBufferArray.back().endDebugUtilsLabelEXT();
         } else {
             throw std::runtime_error("Unsupported compute command");
         }
     }
     _cmdBufferArray.back().end();
+    _recordingStats.commandBuffers = _cmdBufferArray.size();
+}
+
+void Compute::setupPerfCounters(PerfCounterRegistry &perfCounters) {
+    _perfCounters = &perfCounters;
+    _runCounterIds.resetQueryPool = perfCounters.registerCounter("Reset Query Pool", PerfCategory::RunScenario, false);
+    _runCounterIds.createCmdBuffer =
+        perfCounters.registerCounter("Creating Command Buffer", PerfCategory::RunScenario, false);
+    _runCounterIds.submit = perfCounters.registerCounter("Submit Commands", PerfCategory::RunScenario, false);
+    _runCounterIds.waitForFence = perfCounters.registerCounter("Wait for Fence", PerfCategory::RunScenario, false);
+    _runCounterIds.record = perfCounters.registerCounter("Record Command Buffer", PerfCategory::RunScenario, false);
 }
 
-void Compute::submitAndWaitOnFence(std::vector<PerformanceCounter> &perfCounters, int iteration) {
-    auto iterationStr = std::to_string(iteration + 1);
+void Compute::_timeRunStep(std::optional<PerfCounterGuard> &guard, PerfCounterId id) {
+    if (_perfCounters != nullptr) {
+        guard.emplace(*_perfCounters, id);
+    }
+}
+
+void Compute::recordWithoutSubmit() {
+    const auto start = std::chrono::steady_clock::now();
+    _createCmdBuffer(true);
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (_perfCounters != nullptr) {
+        _perfCounters->record(_runCounterIds.record, elapsed);
+    }
+    _recordingStats.recordingTimeUs = elapsed;
+    _cmdBufferArray.clear();
+}
+
+void Compute::submitAndWaitOnFence() {
     // Reset query pool
     {
-        PerfCounterGuard guard(perfCounters, "Reset Query Pool. Iteration: " + iterationStr, "Run Scenario", false);
+        std::optional<PerfCounterGuard> guard;
+        _timeRunStep(guard, _runCounterIds.resetQueryPool);
         if (*_queryPool) {
             _queryPool.reset(0, _nQueries);
         }
+        if (*_statisticsQueryPool) {
+            _statisticsQueryPool.reset(0, _nStatisticsQueries);
+        }
     }
 
     // Create command buffer vector
     {
-        PerfCounterGuard guard(perfCounters, "Creating Command Buffer. Iteration: " + iterationStr, "Run Scenario",
-                               false);
+        std::optional<PerfCounterGuard> guard;
+        _timeRunStep(guard, _runCounterIds.createCmdBuffer);
         _createCmdBuffer();
     }
 
     // Run commands
     {
         vk::SubmitInfo submitInfo({}, {}, *_cmdBufferArray.back());
-        PerfCounterGuard guard(perfCounters, "Submit Commands. Iteration: " + iterationStr, "Run Scenario", false);
+        std::optional<PerfCounterGuard> guard;
+        _timeRunStep(guard, _runCounterIds.submit);
         _queue.submit(submitInfo, *_fence);
     }
 
     // Wait to finish
     {
-        PerfCounterGuard guard(perfCounters, "Wait for Fence. Iteration: " + iterationStr, "Run Scenario", false);
+        std::optional<PerfCounterGuard> guard;
+        _timeRunStep(guard, _runCounterIds.waitForFence);
         _waitForFence();
         _cmdBufferArray.clear();
     }
@@ -653,6 +825,22 @@ void Compute::setupQueryPool(uint32_t nQueries) {
     const vk::QueryPoolCreateInfo queryPoolCreateInfo({}, vk::QueryType::eTimestamp, _nQueries);
     _queryPool = vk::raii::QueryPool(_ctx.device(), queryPoolCreateInfo);
     _queryPool.reset(0, _nQueries);
+
+    if (!_ctx._optionals.pipeline_statistics_query || _nStatisticsQueries == 0) {
+        return;
+    }
+    // Graphics statistics are only valid when the queue supports graphics, which is the case once a graphics
+    // pipeline has been created
+    _fragmentStatistics = std::any_of(_pipelines.begin(), _pipelines.end(),
+                                      [](const auto &pipeline) { return pipeline.isGraphicsPipeline(); });
+    vk::QueryPipelineStatisticFlags statisticFlags = vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations;
+    if (_fragmentStatistics) {
+        statisticFlags |= vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+    }
+    const vk::QueryPoolCreateInfo statisticsQueryPoolCreateInfo({}, vk::QueryType::ePipelineStatistics,
+                                                                _nStatisticsQueries, statisticFlags);
+    _statisticsQueryPool = vk::raii::QueryPool(_ctx.device(), statisticsQueryPoolCreateInfo);
+    _statisticsQueryPool.reset(0, _nStatisticsQueries);
 }
 
 std::vector<uint64_t> Compute::_queryTimestamps() const {
@@ -665,10 +853,32 @@ std::vector<uint64_t> Compute::_queryTimestamps() const {
     throw std::runtime_error("Failed to retrieve timestamps, since the query pool is empty");
 }
 
+std::vector<ProfiledPipelineStatistics> Compute::_queryPipelineStatistics() const {
+    if (!*_statisticsQueryPool) {
+        return {};
+    }
+    // Results are ordered by flag bit, so fragment shader invocations come before compute shader invocations
+    const uint32_t valuesPerQuery = _fragmentStatistics ? 2 : 1;
+    const auto stride = valuesPerQuery * sizeof(uint64_t);
+    auto [_, values] = _statisticsQueryPool.getResults<uint64_t>(
+        0, _nStatisticsQueries, _nStatisticsQueries * stride, static_cast<vk::DeviceSize>(stride),
+        vk::QueryResultFlagBits::e64);
+    std::vector<ProfiledPipelineStatistics> statistics(_nStatisticsQueries);
+    for (uint32_t query = 0; query < _nStatisticsQueries; ++query) {
+        const auto *queryValues = &values[static_cast<size_t>(query) * valuesPerQuery];
+        if (_fragmentStatistics) {
+            statistics[query].fragmentShaderInvocations = queryValues[0];
+        }
+        statistics[query].computeShaderInvocations = queryValues[valuesPerQuery - 1];
+    }
+    return statistics;
+}
+
 RuntimeProfilingData Compute::getRuntimeProfilingData() const {
     RuntimeProfilingData profilingData;
     profilingData.timestamps = _queryTimestamps();
     profilingData.timestampPeriod = _ctx.physicalDevice().getProperties().limits.timestampPeriod;
+    const auto pipelineStatistics = _queryPipelineStatistics();
     for (const auto &command : _commands) {
         if (std::holds_alternative<ComputeDispatch>(command)) {
             const auto &dispatch = std::get<ComputeDispatch>(command);
@@ -679,6 +889,10 @@ RuntimeProfilingData Compute::getRuntimeProfilingData() const {
         } else if (std::holds_alternative<GraphicsDispatch>(command)) {
             const auto &dispatch = std::get<GraphicsDispatch>(command);
             profilingData.commands.push_back({"GraphicsDispatch", dispatch.profileName});
+        } else if (std::holds_alternative<EndPipelineStatistics>(command) && !pipelineStatistics.empty()) {
+            // Every compute and graphics dispatch is directly followed by the end of its statistics query
+            profilingData.commands.back().pipelineStatistics =
+                pipelineStatistics[std::get<EndPipelineStatistics>(command).query];
         }
     }
     return profilingData;
@@ -694,6 +908,45 @@ MemoryProfilingData Compute::getMemoryProfilingData() const {
     return profilingData;
 }
 
+void Compute::addSessionMemory(MemoryReport &memoryReport) const {
+    uint64_t aliasedBytes = 0;
+    for (const auto &pipeline : _pipelines) {
+        for (size_t sessionIdx = 0; sessionIdx < pipeline.sessionCount(); ++sessionIdx) {
+            for (const auto size : pipeline.sessionMemoryDataSizes(sessionIdx)) {
+                ++memoryReport.allocationCount;
+                memoryReport.sessionMemoryBytes += size;
+            }
+            aliasedBytes += pipeline.aliasedSessionMemoryRequirements(sessionIdx).size;
+        }
+    }
+    // Without aliasing, every session would have allocated its transient memory on its own
+    for (const auto &pool : _sessionMemoryPools) {
+        ++memoryReport.allocationCount;
+        memoryReport.sessionMemoryBytes += pool.size;
+        aliasedBytes -= std::min(aliasedBytes, pool.size);
+    }
+    memoryReport.sessionAliasingSavedBytes = aliasedBytes;
+    // Every dispatch sharing a session would otherwise have had a session of its own
+    for (const auto &[key, shared] : _sharedPipelines) {
+        const auto &pipeline = _pipelines[shared.pipelineIdx];
+        if (pipeline.sessionCount() == 0 || shared.dispatches <= pipeline.sessionCount()) {
+            continue;
+        }
+        const auto &sizes = pipeline.sessionMemoryDataSizes();
+        const auto sessionBytes = std::accumulate(sizes.begin(), sizes.end(), uint64_t{0});
+        memoryReport.sessionSharingSavedBytes += (shared.dispatches - pipeline.sessionCount()) * sessionBytes;
+    }
+}
+
+std::vector<PipelineReport> Compute::getPipelineReports() const {
+    std::vector<PipelineReport> pipelineReports;
+    pipelineReports.reserve(_pipelines.size());
+    for (const auto &pipeline : _pipelines) {
+        pipelineReports.push_back(pipeline.getReport(_ctx));
+    }
+    return pipelineReports;
+}
+
 void Compute::dumpNeuralDebugDatabase(const std::filesystem::path &neuralDebugDatabaseDumpDir) const {
     uint32_t graphPipelineIdx = 0;
     for (const auto &pipeline : _pipelines) {
@@ -756,7 +1009,7 @@ void Compute::dumpNeuralStatistics(const std::filesystem::path &neuralStatistics
         std::ofstream dumpFile(dumpPath, std::ios::out | std::ios::binary);
         dumpFile.write(statisticsData.data(), std::streamsize(statisticsData.size()));
         dumpFile.close();
-        mlsdk::logging::info("Neural statistics saved to \"" + statisticsFileName + "\"");
+        MLSDK_LOG_INFO("Neural statistics saved to \"" + statisticsFileName + "\"");
     }
 }
 
@@ -800,39 +1053,41 @@ void Compute::dumpGraphProfilingData(const std::filesystem::path &graphProfiling
         std::ofstream dumpFile(graphProfilingDumpDir / fileName);
         dumpFile.write(graphProfilingData.data(), std::streamsize(graphProfilingData.size()));
         dumpFile.close();
-        logging::info("Graph profiling data saved to \"" + fileName + "\"");
+        MLSDK_LOG_INFO("Graph profiling data saved to \"" + fileName + "\"");
     }
 }
 
 void Compute::sessionRAMsDump(const std::filesystem::path &sessionRAMsDumpDir) const {
     uint32_t graphPipelineIdx = 0;
     for (const auto &pipeline : _pipelines) {
-        const auto &sessionMemory = pipeline.sessionMemory();
-        const auto &sessionMemoryDataSizes = pipeline.sessionMemoryDataSizes();
+        for (size_t sessionIdx = 0; sessionIdx < pipeline.sessionCount(); ++sessionIdx) {
+            const auto &sessionMemory = pipeline.sessionMemory(sessionIdx);
+            const auto &sessionMemoryDataSizes = pipeline.sessionMemoryDataSizes(sessionIdx);
 
-        for (size_t i = 0; i < sessionMemory.size(); i++) {
-            const std::string sessionRAMFileName =
-                "Graph_Pipeline_" + std::to_string(graphPipelineIdx++) + "_Session_RAM_" + std::to_string(i) + ".txt";
-            std::ofstream fs;
-            fs.open(sessionRAMsDumpDir / sessionRAMFileName);
+            for (size_t i = 0; i < sessionMemory.size(); i++) {
+                const std::string sessionRAMFileName = "Graph_Pipeline_" + std::to_string(graphPipelineIdx++) +
+                                                       "_Session_RAM_" + std::to_string(i) + ".txt";
+                std::ofstream fs;
+                fs.open(sessionRAMsDumpDir / sessionRAMFileName);
 
-            const vk::raii::DeviceMemory &deviceMemory = sessionMemory.at(i);
-            uint64_t dataSize = sessionMemoryDataSizes.at(i);
+                const vk::raii::DeviceMemory &deviceMemory = sessionMemory.at(i);
+                uint64_t dataSize = sessionMemoryDataSizes.at(i);
 
-            auto *dst = reinterpret_cast<unsigned char *>(deviceMemory.mapMemory(0, vk::WholeSize));
+                auto *dst = reinterpret_cast<unsigned char *>(deviceMemory.mapMemory(0, vk::WholeSize));
 
-            fs << std::hex << std::uppercase;
-            fs.fill('0');
+                fs << std::hex << std::uppercase;
+                fs.fill('0');
 
-            for (size_t j = 0; j < dataSize; j++) {
-                if ((j % 16) == 0) {
-                    fs << std::endl << std::setw(8) << j << ":   ";
+                for (size_t j = 0; j < dataSize; j++) {
+                    if ((j % 16) == 0) {
+                        fs << std::endl << std::setw(8) << j << ":   ";
+                    }
+                    fs << std::setw(2) << static_cast<unsigned>(dst[j]) << " ";
                 }
-                fs << std::setw(2) << static_cast<unsigned>(dst[j]) << " ";
-            }
 
-            deviceMemory.unmapMemory();
-            fs.close();
+                deviceMemory.unmapMemory();
+                fs.close();
+            }
         }
         mlsdk::logging::info("Session RAM dump stored");
     }
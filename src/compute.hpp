@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -76,6 +77,12 @@ class Compute {
     /// \param spvSize (Optional) Size of SPIR-V code in number of uint32_t
     void createPipeline(const PipelineCreateArguments &args, const ShaderInfo &shaderInfo,
                         const uint32_t *spvCode = nullptr, size_t spvSize = 0);
+
+    /// \brief Create the data graph pipeline of a VGF segment
+    ///
+    /// Dispatches of the same segment with bindings of the same set, binding, type and description share one
+    /// pipeline, and only get descriptor sets of their own. They also share a session, unless the previous dispatch
+    /// of the pipeline is not followed by an implicit barrier and may still execute, in which case they get a new one.
     void createPipeline(const PipelineCreateArguments &args, uint32_t segmentIndex, const VgfView &vgfView,
                         const DataManager &dataManager, bool enableNeuralStatistics,
                         vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode);
@@ -86,7 +93,7 @@ class Compute {
 
     /// \brief Create a DataGraph pipeline through SPIR-V dispatch
     void createPipeline(const PipelineCreateArguments &args, const ShaderInfo &shaderInfo,
-                        const DataManager &dataManager, const std::vector<GraphConstantInfo> &constants,
+                        const DataManager &dataManager, std::vector<GraphConstantInfo> constants,
                         bool enableNeuralStatistics, vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode);
 
     /// \brief Create an optical flow data graph pipeline.
@@ -102,6 +109,15 @@ class Compute {
                         vk::DataGraphOpticalFlowPerformanceLevelARM performanceLevel,
                         vk::DataGraphOpticalFlowGridSizeFlagsARM gridSize, uint32_t inputWidth, uint32_t inputHeight);
 
+    /// \brief Wait for the data graph pipelines that are still being compiled
+    ///
+    /// Must be called before the pipelines are queried. Recording calls it, so the first recording blocks instead
+    /// of pipeline creation. Binds the aliased session memory of the new sessions when aliasing is enabled.
+    void waitForPipelines();
+
+    /// \brief Destroy the shader modules of every pipeline, which must all be complete
+    void releaseShaderModules();
+
     /// \brief Optional dispatch info for data graph pipelines.
     struct OpticalFlowDispatchInfo {
         vk::DataGraphOpticalFlowExecuteFlagsARM opticalFlowFlags;
@@ -136,12 +152,25 @@ class Compute {
     /// \param dataManager Data manager object to retrieve resource
     void registerPipelineBarrier(const DispatchBarrierData &dispatchBarrierData, const DataManager &dataManager);
 
+    /// \brief Register the counters of submission and recording in @p perfCounters, which must outlive the compute
+    ///
+    /// Every later submission or recording only records samples for the registered IDs. Without this call, they are
+    /// not timed.
+    void setupPerfCounters(PerfCounterRegistry &perfCounters);
+
     /// \brief Submit the command buffer for execution and wait for completion
     void submitAndWaitOnFence();
-    void submitAndWaitOnFence(std::vector<PerformanceCounter> &perfCounters, int iteration);
 
-    /// \brief Setup a query pool
-    /// \param nQueries Number of queries to register
+    /// \brief Record the command buffers of one iteration without submitting them
+    ///
+    /// Frame boundaries split the recording into several command buffers but are not submitted either.
+    void recordWithoutSubmit();
+
+    /// \brief Cost of the last command buffer recording
+    const CommandRecordingStats &getRecordingStats() const { return _recordingStats; }
+
+    /// \brief Setup the timestamp query pool, and the pipeline statistics query pool when supported
+    /// \param nQueries Number of timestamp queries to register
     void setupQueryPool(uint32_t nQueries);
 
     /// \brief Create the VkFrameBoundaryEXT struct with the correct resource
@@ -158,6 +187,12 @@ class Compute {
     /// \brief Collect data graph pipeline memory usage
     MemoryProfilingData getMemoryProfilingData() const;
 
+    /// \brief Add the data graph session memory allocations to @p memoryReport
+    void addSessionMemory(MemoryReport &memoryReport) const;
+
+    /// \brief Collect creation feedback and executable statistics of every pipeline
+    std::vector<PipelineReport> getPipelineReports() const;
+
     void dumpNeuralDebugDatabase(const std::filesystem::path &neuralDebugDatabaseDumpDir) const;
     void dumpNeuralStatistics(const std::filesystem::path &neuralStatisticsDumpDir,
                               vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) const;
@@ -178,13 +213,15 @@ class Compute {
         BindPoint bindPoint;
     };
 
+    /// Pipelines are referred to by index, as data graph pipelines may still be compiling when commands are added
     struct BindPipeline {
-        vk::Pipeline pipeline{nullptr};
+        size_t pipelineIdx;
         BindPoint bindPoint;
     };
 
     struct DataGraphDispatch {
-        vk::DataGraphPipelineSessionARM session{nullptr};
+        size_t pipelineIdx;
+        size_t sessionIdx;
         std::optional<OpticalFlowDispatchInfo> dispatchInfo;
         std::string profileName;
     };
@@ -198,8 +235,8 @@ class Compute {
 
     struct PushConstants {
         vk::PipelineLayout pipelineLayout{nullptr};
-        const char *pushConstantData;
-        uint32_t size;
+        /// Copy of the data, so that the raw data it was read from can be released
+        std::vector<char> pushConstantData;
         vk::ShaderStageFlags stages;
     };
 
@@ -208,6 +245,14 @@ class Compute {
         vk::PipelineStageFlagBits2 flag;
     };
 
+    struct BeginPipelineStatistics {
+        uint32_t query;
+    };
+
+    struct EndPipelineStatistics {
+        uint32_t query;
+    };
+
     struct MarkBoundary {
         vk::FrameBoundaryEXT markBoundary;
     };
@@ -223,9 +268,9 @@ class Compute {
         std::string profileName;
     };
 
-    using Command =
-        std::variant<BindDescriptorSet, BindPipeline, ComputeDispatch, DataGraphDispatch, GraphicsDispatch,
-                     MemoryBarrier, PushConstants, WriteTimestamp, MarkBoundary, PushDebugMarker, PopDebugMarker>;
+    using Command = std::variant<BindDescriptorSet, BindPipeline, ComputeDispatch, DataGraphDispatch, GraphicsDispatch,
+                                 MemoryBarrier, PushConstants, WriteTimestamp, BeginPipelineStatistics,
+                                 EndPipelineStatistics, MarkBoundary, PushDebugMarker, PopDebugMarker>;
 
     struct DebugMarker;
 
@@ -237,6 +282,9 @@ class Compute {
     /// \brief Fetch the QueryPoolResults, which contain runtime cycle-timestamps used for profiling
     std::vector<uint64_t> _queryTimestamps() const;
 
+    /// \brief Fetch the pipeline statistics of every compute and graphics dispatch
+    std::vector<ProfiledPipelineStatistics> _queryPipelineStatistics() const;
+
     friend struct DebugMarker;
 
     Context &_ctx;
@@ -244,7 +292,40 @@ class Compute {
     vk::raii::Queue _queue{nullptr};
     vk::raii::Fence _fence{nullptr};
 
+    /// \brief Device memory the transient bind points of serialized data graph sessions alias
+    struct SessionMemoryPool {
+        vk::raii::DeviceMemory memory{nullptr};
+        vk::DeviceSize size{0};
+        uint32_t memoryTypeIdx{0};
+    };
+    /// Declared before the pipelines so that the sessions bound to the pools are destroyed first
+    std::vector<SessionMemoryPool> _sessionMemoryPools;
+
+    /// Shared by the deferred creations of every pipeline, declared before them so that it outlives their joins
+    WorkerPool _workerPool;
+
     std::vector<Pipeline> _pipelines;
+
+    /// \brief Data graph pipeline of a VGF segment and the dispatches sharing it
+    struct SharedPipeline {
+        size_t pipelineIdx;
+        /// Session of the last dispatch
+        size_t sessionIdx{0};
+        /// Position in _commands of the last dispatch
+        size_t lastDispatch{0};
+        size_t dispatches{0};
+    };
+    std::unordered_map<VgfSegmentKey, SharedPipeline> _sharedPipelines;
+
+    /// Pipeline, session and name of the dispatch being registered
+    size_t _currentPipelineIdx{0};
+    size_t _currentSessionIdx{0};
+    std::string _currentDispatchName;
+    SharedPipeline *_currentSharedPipeline{nullptr};
+    /// Position in _commands of the last implicit barrier, which waits for every command before it
+    std::optional<size_t> _lastImplicitBarrier;
+    /// Position in _commands of the last data graph dispatch
+    std::optional<size_t> _lastGraphDispatch;
     std::vector<vk::raii::DescriptorPool> _descriptorPools;
     std::vector<vk::raii::DescriptorSet> _descriptorSets;
     std::vector<std::vector<vk::MemoryBarrier2>> _memoryBarriers;
@@ -260,8 +341,23 @@ class Compute {
     std::vector<std::string> _debugMarkerNames;
     uint64_t _repeatNumber{};
 
+    /// \brief IDs of the counters timing every submission and recording
+    struct RunCounterIds {
+        PerfCounterId resetQueryPool{0};
+        PerfCounterId createCmdBuffer{0};
+        PerfCounterId submit{0};
+        PerfCounterId waitForFence{0};
+        PerfCounterId record{0};
+    };
+    PerfCounterRegistry *_perfCounters{nullptr};
+    RunCounterIds _runCounterIds;
+
     vk::raii::QueryPool _queryPool{nullptr};
     uint32_t _nQueries{0};
+    CommandRecordingStats _recordingStats;
+    vk::raii::QueryPool _statisticsQueryPool{nullptr};
+    uint32_t _nStatisticsQueries{0};
+    bool _fragmentStatistics{false};
 #ifdef ML_SDK_ENABLE_RDOC
     bool _isRecording{false};
 #endif
@@ -272,6 +368,10 @@ class Compute {
     void _updateDescriptorSets(const vk::DescriptorSet &descSet, const TypedBinding &binding,
                                const IResourceViewer &resourceViewer);
 
+    /// \brief Register the next dispatch with the pipeline at @p pipelineIdx
+    void _usePipeline(size_t pipelineIdx, size_t sessionIdx, const std::string &dispatchName,
+                      SharedPipeline *sharedPipeline = nullptr);
+
     void _registerPipelineFencedCommon(const DataManager &dataManager, const std::vector<TypedBinding> &bindings,
                                        const char *pushConstantData, size_t pushConstantSize);
 
@@ -286,12 +386,20 @@ class Compute {
 
     void _addImplicitBarriers();
 
+    /// \brief Bind the sessions created since the last call to the shared session memory
+    ///
+    /// The last pool is reused when it is large enough, otherwise a pool sized to the largest new session is added.
+    void _bindAliasedSessionMemory();
+
     vk::FrameBoundaryEXT _createFrameBoundary();
 
     void _addMarkBoundary();
 
     vk::PipelineBindPoint _getBindPoint(BindPoint bindPoint);
 
-    void _createCmdBuffer();
+    void _createCmdBuffer(bool recordOnly = false);
+
+    /// \brief Start timing a step of submission or recording in @p guard when the counters have been set up
+    void _timeRunStep(std::optional<PerfCounterGuard> &guard, PerfCounterId id);
 };
 } // namespace mlsdk::scenariorunner
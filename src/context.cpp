@@ -60,6 +60,8 @@ std::string_view formatFeature(VkBool32 supported) { return supported == VK_TRUE
 Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue)
     : _gpuDebugMarkersEnabled(scenarioOptions.enableGPUDebugMarkers),
       _sessionMemoryDumpEnabled(!scenarioOptions.sessionRAMsDumpDir.empty()),
+      // Dumped session memory must hold what its own session left behind
+      _sessionMemoryAliasingEnabled(scenarioOptions.aliasSessionMemory && !_sessionMemoryDumpEnabled),
       _robustnessFeaturesEnabled(scenarioOptions.enableRobustnessFeatures) {
     // Create instance
     const vk::ApplicationInfo appInfo("Scenario-Runner", 1, nullptr, 0, VK_API_VERSION_1_3);
@@ -108,7 +110,7 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
     std::ostringstream vendorID;
     vendorID << std::hex << std::setw(4) << std::setfill('0') << properties.vendorID << std::dec;
 
-    mlsdk::logging::info("Device: " + deviceName + ", Type: " + deviceType + ", Vendor: 0x" + vendorID.str());
+    MLSDK_LOG_INFO("Device: " + deviceName + ", Type: " + deviceType + ", Vendor: 0x" + vendorID.str());
 
     const std::vector<vk::QueueFamilyProperties> queueProps = _physicalDev.getQueueFamilyProperties();
     _familyQueueIdx = findQueue(queueProps, familyQueue);
@@ -147,6 +149,17 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
         hasExtension(extensions, VK_EXT_PIPELINE_ROBUSTNESS_EXTENSION_NAME, scenarioOptions.disabledExtensions);
     _optionals.portability_subset =
         hasExtension(extensions, VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME, scenarioOptions.disabledExtensions);
+    // Capturing executable statistics can slow down pipeline compilation, so only enable it for the pipeline report
+    _optionals.pipeline_executable_properties =
+        !scenarioOptions.pipelineReportPath.empty() &&
+        hasExtension(extensions, VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME,
+                     scenarioOptions.disabledExtensions);
+    // Pipeline binaries are only created from and stored into the pipeline cache
+    _optionals.pipeline_binary =
+        scenarioOptions.enablePipelineCaching && _optionals.maintenance5 &&
+        hasExtension(extensions, VK_KHR_PIPELINE_BINARY_EXTENSION_NAME, scenarioOptions.disabledExtensions);
+    _optionals.memory_budget =
+        hasExtension(extensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, scenarioOptions.disabledExtensions);
 
     // Create device
     const float queuePriority = 1.0f;
@@ -174,7 +187,9 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
         vk::PhysicalDeviceVulkan13Features, vk::PhysicalDeviceShaderBfloat16FeaturesKHR,
         vk::PhysicalDeviceShaderFloat8FeaturesEXT, vk::PhysicalDeviceDataGraphOpticalFlowFeaturesARM,
         vk::PhysicalDeviceDataGraphNeuralAcceleratorStatisticsFeaturesARM, vk::PhysicalDeviceRobustness2FeaturesKHR,
-        vk::PhysicalDeviceDescriptorIndexingFeatures, vk::PhysicalDevicePipelineRobustnessFeatures>();
+        vk::PhysicalDeviceDescriptorIndexingFeatures, vk::PhysicalDevicePipelineRobustnessFeatures,
+        vk::PhysicalDevicePipelineExecutablePropertiesFeaturesKHR, vk::PhysicalDeviceMaintenance5FeaturesKHR,
+        vk::PhysicalDevicePipelineBinaryFeaturesKHR>();
 
     const auto &availableCoreFeatures = availableFeatures.template get<vk::PhysicalDeviceFeatures2>().features;
     const auto &[available11Features, available12Features, available13Features, availableBfloat16, availableFloat8] =
@@ -224,6 +239,25 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
                                 "Disabling pipeline robustness support.");
         _optionals.pipeline_robustness = false;
     }
+    _optionals.pipeline_statistics_query =
+        !scenarioOptions.profilingPath.empty() && availableCoreFeatures.pipelineStatisticsQuery;
+    const auto &availablePipelineExecutableProperties =
+        availableFeatures.template get<vk::PhysicalDevicePipelineExecutablePropertiesFeaturesKHR>();
+    if (_optionals.pipeline_executable_properties && !availablePipelineExecutableProperties.pipelineExecutableInfo) {
+        mlsdk::logging::warning("VK_KHR_pipeline_executable_properties extension is present, but "
+                                "pipelineExecutableInfo feature is not supported. "
+                                "Pipeline report will not contain executable statistics.");
+        _optionals.pipeline_executable_properties = false;
+    }
+    const auto &availableMaintenance5 = availableFeatures.template get<vk::PhysicalDeviceMaintenance5FeaturesKHR>();
+    const auto &availablePipelineBinary = availableFeatures.template get<vk::PhysicalDevicePipelineBinaryFeaturesKHR>();
+    if (_optionals.pipeline_binary &&
+        (!availableMaintenance5.maintenance5 || !availablePipelineBinary.pipelineBinaries)) {
+        mlsdk::logging::warning("VK_KHR_pipeline_binary extension is present, but "
+                                "pipelineBinaries or maintenance5 feature is not supported. "
+                                "Pipeline cache will use pipeline cache objects.");
+        _optionals.pipeline_binary = false;
+    }
 
     const bool requiresDynamicRendering = familyQueue == FamilyQueue::Graphics;
     if (requiresDynamicRendering && !available13Features.dynamicRendering) {
@@ -316,10 +350,28 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
         featureChain = &pipelineRobustnessFeat;
     }
 
+    vk::PhysicalDevicePipelineExecutablePropertiesFeaturesKHR pipelineExecutablePropertiesFeat{};
+    if (_optionals.pipeline_executable_properties) {
+        pipelineExecutablePropertiesFeat.pipelineExecutableInfo = true;
+        pipelineExecutablePropertiesFeat.pNext = featureChain;
+        featureChain = &pipelineExecutablePropertiesFeat;
+    }
+
+    vk::PhysicalDeviceMaintenance5FeaturesKHR maintenance5Feat{};
+    vk::PhysicalDevicePipelineBinaryFeaturesKHR pipelineBinaryFeat{};
+    if (_optionals.pipeline_binary) {
+        maintenance5Feat.maintenance5 = true;
+        maintenance5Feat.pNext = featureChain;
+        pipelineBinaryFeat.pipelineBinaries = true;
+        pipelineBinaryFeat.pNext = &maintenance5Feat;
+        featureChain = &pipelineBinaryFeat;
+    }
+
     vk::PhysicalDeviceFeatures deviceFeat;
     deviceFeat.shaderInt16 = true;
     deviceFeat.shaderInt64 = true;
     deviceFeat.fragmentStoresAndAtomics = availableCoreFeatures.fragmentStoresAndAtomics;
+    deviceFeat.pipelineStatisticsQuery = _optionals.pipeline_statistics_query;
 
     std::vector<const char *> vulkanDeviceExtensions = {VK_ARM_DATA_GRAPH_EXTENSION_NAME,
                                                         VK_ARM_TENSORS_EXTENSION_NAME};
@@ -366,6 +418,15 @@ Context::Context(const ScenarioOptions &scenarioOptions, FamilyQueue familyQueue
     if (_optionals.portability_subset) {
         vulkanDeviceExtensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
     }
+    if (_optionals.pipeline_executable_properties) {
+        vulkanDeviceExtensions.push_back(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME);
+    }
+    if (_optionals.memory_budget) {
+        vulkanDeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+    if (_optionals.pipeline_binary) {
+        vulkanDeviceExtensions.push_back(VK_KHR_PIPELINE_BINARY_EXTENSION_NAME);
+    }
 
     const vk::DeviceCreateInfo deviceCreateInfo = {
         vk::DeviceCreateFlags(),
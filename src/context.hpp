@@ -27,6 +27,10 @@ struct OptionalExtensions {
     bool descriptor_indexing = false;
     bool pipeline_robustness = false;
     bool portability_subset = false;
+    bool pipeline_executable_properties = false;
+    bool pipeline_binary = false;
+    bool pipeline_statistics_query = false;
+    bool memory_budget = false;
 };
 
 /// \brief Type of family queue to use
@@ -70,6 +74,10 @@ class Context {
     /// @return Whether graph session memory needs to be dumped
     bool sessionMemoryDumpEnabled() const { return _sessionMemoryDumpEnabled; }
 
+    /// @brief Do serialized data graph sessions share their transient memory?
+    /// @return Whether transient session memory is left for Compute to bind to a shared allocation
+    bool sessionMemoryAliasingEnabled() const { return _sessionMemoryAliasingEnabled; }
+
     /// @brief Are robustness features requested?
     /// @return Whether robustness features should be enabled where supported
     bool robustnessFeaturesEnabled() const { return _robustnessFeaturesEnabled; }
@@ -77,6 +85,7 @@ class Context {
   private:
     bool _gpuDebugMarkersEnabled;
     bool _sessionMemoryDumpEnabled;
+    bool _sessionMemoryAliasingEnabled;
     bool _robustnessFeaturesEnabled;
     vk::raii::Context _ctx;
     vk::raii::Instance _instance{nullptr};
@@ -102,6 +102,11 @@ bool DataManager::hasBufferBarrier(BufferBarrierId id) const {
     return _bufferBarriers.find(id) != _bufferBarriers.end();
 }
 
+void DataManager::releaseMappedData() {
+    _rawData.clear();
+    _vgfViews.clear();
+}
+
 uint32_t DataManager::numBuffers() const { return static_cast<uint32_t>(_buffers.size()); }
 
 uint32_t DataManager::numTensors() const { return static_cast<uint32_t>(_tensors.size()); }
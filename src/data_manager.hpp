@@ -54,6 +54,9 @@ class DataManager {
     const VulkanBufferBarrier &getBufferBarrier(BufferBarrierId id) const;
     const VulkanTensorBarrier &getTensorBarrier(TensorBarrierId id) const;
 
+    /// \brief Unmap the raw data and VGF files, which are only read while the pipelines are created
+    void releaseMappedData();
+
     uint32_t numBuffers() const;
     uint32_t numTensors() const;
     uint32_t numImages() const;
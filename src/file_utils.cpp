@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "file_utils.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/file.h>
+#    include <unistd.h>
+#endif
+
+namespace mlsdk::scenariorunner {
+
+std::string formatKey(uint64_t key) {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << key;
+    return stream.str();
+}
+
+void writeFileAtomically(const std::filesystem::path &path, const void *data, size_t size) {
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream stream(tempPath, std::ofstream::binary | std::ofstream::trunc);
+        if (!stream.is_open()) {
+            throw std::runtime_error("Error writing file: " + tempPath.string());
+        }
+        stream.exceptions(std::ios::badbit | std::ios::failbit);
+        stream.write(reinterpret_cast<const char *>(data), std::streamsize(size));
+    }
+    std::filesystem::rename(tempPath, path);
+}
+
+struct FileLock::Impl {
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    int fd;
+#endif
+};
+
+FileLock::FileLock(const std::filesystem::path &path) : _impl(std::make_unique<Impl>()) {
+#ifdef _WIN32
+    _impl->handle =
+        CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                    nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    OVERLAPPED overlapped{};
+    if (_impl->handle == INVALID_HANDLE_VALUE ||
+        !LockFileEx(_impl->handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+        if (_impl->handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(_impl->handle);
+        }
+        throw std::runtime_error("Error locking file: " + path.string());
+    }
+#else
+    _impl->fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    int result = -1;
+    if (_impl->fd >= 0) {
+        do {
+            result = flock(_impl->fd, LOCK_EX);
+        } while (result != 0 && errno == EINTR);
+    }
+    if (result != 0) {
+        if (_impl->fd >= 0) {
+            close(_impl->fd);
+        }
+        throw std::runtime_error("Error locking file: " + path.string());
+    }
+#endif
+}
+
+FileLock::~FileLock() {
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    UnlockFileEx(_impl->handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+    CloseHandle(_impl->handle);
+#else
+    flock(_impl->fd, LOCK_UN);
+    close(_impl->fd);
+#endif
+}
+
+} // namespace mlsdk::scenariorunner
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief Key as the 16 hexadecimal digits used to name cache entries and database results
+std::string formatKey(uint64_t key);
+
+/// \brief Write @p data to a temporary file next to @p path and rename it over @p path
+///
+/// Readers of @p path never see a partially written file.
+void writeFileAtomically(const std::filesystem::path &path, const void *data, size_t size);
+
+/// \brief Exclusive lock on the file at @p path serializing the processes that share it, released on destruction
+///
+/// The lock file is created when it does not exist and is left behind on release.
+class FileLock {
+  public:
+    explicit FileLock(const std::filesystem::path &path);
+    ~FileLock();
+
+    FileLock(const FileLock &) = delete;
+    FileLock &operator=(const FileLock &) = delete;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+} // namespace mlsdk::scenariorunner
@@ -34,8 +34,8 @@ void GroupManager::addResourceToGroup(MemoryGroupId group, MemoryResourceId reso
     if (!inserted) {
         return;
     }
-    logging::debug("addResourceToGroup count of resources: " + std::to_string(_resourceToGroup.size()) +
-                   " added type: " + std::to_string(resource.index()));
+    MLSDK_LOG_DEBUG("addResourceToGroup count of resources: " + std::to_string(_resourceToGroup.size()) +
+                    " added type: " + std::to_string(resource.index()));
     groupIt->second.push_back(resource);
 }
 
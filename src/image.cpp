@@ -268,6 +268,7 @@ void Image::setup(const Context &ctx, std::shared_ptr<ResourceMemoryManager> mem
     _sampler = vk::raii::Sampler(ctx.device(), samplerCreateInfo);
 
     vk::MemoryRequirements memoryRequirements = _image.getMemoryRequirements();
+    _memoryRequirement = memoryRequirements.size;
     _memoryManager->updateMemSize(memoryRequirements.size + _imageInfo.memoryOffset);
     _memoryManager->updateMemType(memoryRequirements.memoryTypeBits);
 
@@ -75,6 +75,11 @@ class Image {
     const std::string &debugName() const;
     const ImageInfo &getInfo() const { return _imageInfo; }
 
+    std::shared_ptr<ResourceMemoryManager> memoryManager() const { return _memoryManager; }
+
+    /// \brief Get the size of device memory the image requires
+    vk::DeviceSize memoryRequirement() const { return _memoryRequirement; }
+
   private:
     uint64_t baseDataSize() const;
     uint64_t mipChainDataSize(uint32_t mipLevels) const;
@@ -91,6 +96,7 @@ class Image {
     std::vector<vk::raii::ImageView> _imageViewMips;
     vk::ImageLayout _targetLayout{};
     vk::ImageTiling _tiling{};
+    vk::DeviceSize _memoryRequirement{0};
 };
 
 } // namespace mlsdk::scenariorunner
@@ -602,6 +602,10 @@ void from_json(const json &j, ShaderDesc &shader) {
     parseOptionalField(j, "specialization_constants", shader.specializationConstants);
     parseOptionalField(j, "build_options", shader.buildOpts);
     parseOptionalField(j, "include_dirs", shader.includeDirs);
+    parseOptionalField(j, "tuning_candidates", shader.tuningCandidates);
+    if (!shader.tuningCandidates.empty() && shader.stage != ShaderStage::Compute) {
+        throw std::runtime_error("Tuning candidates are only supported for compute shaders");
+    }
 }
 
 /**
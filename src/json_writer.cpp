@@ -4,8 +4,10 @@
  */
 
 #include "json_writer.hpp"
+#include "timeline.hpp"
 
 #include <fstream>
+#include <map>
 
 #include "nlohmann/json.hpp"
 
@@ -13,8 +15,6 @@ namespace mlsdk::scenariorunner {
 using json = nlohmann::json;
 
 namespace {
-json _profilingDataJsonOutput = json::object();
-
 double calculateElapsedTimeInMilliseconds(uint64_t startTimestamp, uint64_t endTimestamp, float timestampPeriod) {
     return static_cast<double>(endTimestamp - startTimestamp) * static_cast<double>(timestampPeriod) / 1000000.0;
 }
@@ -42,57 +42,106 @@ void to_json(json &j, const CommandTimestamps &commandTimestamps) {
               calculateElapsedTimeInMilliseconds(commandTimestamps.timestamps[0], commandTimestamps.timestamps[1],
                                                  commandTimestamps.period)},
              {"Iteration", commandTimestamps.iteration + 1}};
+    if (const auto &statistics = commandTimestamps.command.pipelineStatistics) {
+        j["Compute shader invocations"] = statistics->computeShaderInvocations;
+        j["Fragment shader invocations"] = statistics->fragmentShaderInvocations;
+        const auto invocations = statistics->computeShaderInvocations + statistics->fragmentShaderInvocations;
+        if (invocations != 0) {
+            j["Time per invocation [ns]"] = j["Time for command [ms]"].get<double>() * 1000000.0 /
+                                            static_cast<double>(invocations);
+        }
+    }
 }
 
-} // namespace
+json toJson(const PipelineExecutableStatistic &statistic) {
+    json j{{"name", statistic.name}, {"description", statistic.description}};
+    std::visit([&j](const auto &value) { j["value"] = value; }, statistic.value);
+    return j;
+}
+
+json toJson(const PipelineExecutableReport &executable) {
+    json statistics = json::array();
+    for (const auto &statistic : executable.statistics) {
+        statistics.push_back(toJson(statistic));
+    }
+    return json{{"name", executable.name},
+                {"description", executable.description},
+                {"stages", executable.stages},
+                {"subgroup size", executable.subgroupSize},
+                {"statistics", std::move(statistics)}};
+}
 
-void to_json(json &j, const PerformanceCounter &perfCounter) {
-    j = json{{"name", perfCounter.getName()}, {"value", perfCounter.getElapsedTime()}, {"unit", "microseconds"}};
+json toJson(const PipelineReport &pipelineReport) {
+    json executables = json::array();
+    for (const auto &executable : pipelineReport.executables) {
+        executables.push_back(toJson(executable));
+    }
+    return json{{"Pipeline name", pipelineReport.name},
+                {"Pipeline type", pipelineReport.type},
+                {"Creation feedback valid", pipelineReport.feedbackValid},
+                {"Pipeline cache hit", pipelineReport.cacheHit},
+                {"Creation time [ns]", pipelineReport.creationDurationNs},
+                {"Stage creation times [ns]", pipelineReport.stageCreationDurationsNs},
+                {"Executables", std::move(executables)}};
 }
 
-void to_json(json &j, const AggregateStat &stat) {
-    j = json{{"total time", stat.aggregateTime}, {"unit", "microseconds"}, {"counters", stat.counters}};
+} // namespace
+
+void writePipelineReport(const std::vector<PipelineReport> &pipelineReports, const std::filesystem::path &path) {
+    json pipelines = json::array();
+    for (const auto &pipelineReport : pipelineReports) {
+        pipelines.push_back(toJson(pipelineReport));
+    }
+    std::ofstream ostream(path);
+    ostream << json{{"Pipelines", std::move(pipelines)}}.dump(4);
+    ostream.close();
 }
 
-void writePerfCounters(std::vector<PerformanceCounter> &perfCounters, std::filesystem::path &path) {
-    std::map<std::string, AggregateStat> map;
+void writePerfCounters(const PerfCounterRegistry &perfCounters, const std::filesystem::path &path) {
+    std::map<std::string, json> categories;
     int64_t timeToInference = 0;
-    int64_t scenarioaggregate = 0;
-    json outJson;
+    int64_t scenarioAggregate = 0;
 
-    for (auto &pc : perfCounters) {
-        const auto &category = pc.getCategory();
-        if (!map.count(category)) {
-            map[category] = AggregateStat(category);
+    const auto &counters = perfCounters.getCounters();
+    for (PerfCounterId id = 0; id < static_cast<PerfCounterId>(counters.size()); ++id) {
+        const auto &counter = counters[id];
+        const auto &histogram = counter.histogram;
+        if (counter.isPartOfTimeToInference) {
+            timeToInference += histogram.sum();
         }
+        scenarioAggregate += histogram.sum();
 
-        if (pc.isPartOfTimeToInference()) {
-            timeToInference += pc.getElapsedTime();
+        json counterJson{{"name", counter.name},
+                         {"value", histogram.sum()},
+                         {"unit", "microseconds"},
+                         {"count", histogram.count()},
+                         {"sum", histogram.sum()},
+                         {"min", histogram.min()},
+                         {"max", histogram.max()},
+                         {"p50", histogram.percentile(50.0)},
+                         {"p90", histogram.percentile(90.0)},
+                         {"p99", histogram.percentile(99.0)}};
+        if (!counter.rawSamples.empty()) {
+            counterJson["samples"] = perfCounters.getRawSamples(id);
         }
 
-        scenarioaggregate += pc.getElapsedTime();
-        map[category].aggregateTime += pc.getElapsedTime();
-        map[category].counters.push_back(pc);
+        auto &category = categories[perfCategoryName(counter.category)];
+        if (category.is_null()) {
+            category = json{{"total time", 0}, {"unit", "microseconds"}, {"counters", json::array()}};
+        }
+        category["total time"] = category["total time"].get<int64_t>() + histogram.sum();
+        category["counters"].push_back(std::move(counterJson));
     }
 
     // Write aggregated time for the whole scenario
+    json outJson;
     outJson["Time to Inference"] = timeToInference;
-    outJson["Total Scenario Time"] = scenarioaggregate;
+    outJson["Total Scenario Time"] = scenarioAggregate;
     outJson["unit"] = "microseconds";
 
     // Write aggregated stats for categories
-    for (const auto &stat : map) {
-        if (!stat.first.empty()) {
-            outJson[stat.first] = stat.second;
-        }
-    }
-
-    // Unaggregated stats not part of a category
-    for (const auto &stat : map) {
-        if (stat.first.empty()) {
-            outJson["Uncategorized"] = stat.second.counters;
-            break;
-        }
+    for (auto &[name, category] : categories) {
+        outJson[name] = std::move(category);
     }
 
     std::ofstream ostream(path);
@@ -100,38 +149,154 @@ void writePerfCounters(std::vector<PerformanceCounter> &perfCounters, std::files
     ostream.close();
 }
 
-void writeProfilingData(const std::optional<RuntimeProfilingData> &runtimeProfilingData,
-                        const MemoryProfilingData &memoryProfilingData, const std::filesystem::path &path,
-                        const int iteration, const int repeatCount) {
+ProfilingWriter::ProfilingWriter(const std::filesystem::path &path) : _stream(path, std::ios::out | std::ios::trunc) {
+    if (!_stream) {
+        throw std::runtime_error("Unable to open profiling data file for writing " + path.string());
+    }
+}
+
+void ProfilingWriter::writeRecord(const char *recordType, json record) {
+    record["Record"] = recordType;
+    _stream << record.dump() << '\n';
+}
+
+void ProfilingWriter::write(const std::optional<RuntimeProfilingData> &runtimeProfilingData,
+                            const MemoryProfilingData &memoryProfilingData, const int iteration) {
     if (runtimeProfilingData.has_value()) {
         const auto &[timestamps, timestampPeriod, commands] = runtimeProfilingData.value();
         if (commands.size() * 2 != timestamps.size()) {
             throw std::runtime_error("Cannot map all timestamps to their respective commands");
         }
+        for (size_t idx = 0, commandIdx = 0; idx < timestamps.size(); idx += 2, ++commandIdx) {
+            writeRecord("Timestamp", CommandTimestamps(commands[commandIdx], {timestamps[idx], timestamps[idx + 1]},
+                                                       timestampPeriod, iteration));
+        }
         if (!timestamps.empty()) {
-            const auto totalExecutionTime =
+            const auto executionTime =
                 calculateElapsedTimeInMilliseconds(timestamps.front(), timestamps.back(), timestampPeriod);
-            _profilingDataJsonOutput["Total execution time [ms]"] =
-                _profilingDataJsonOutput.value("Total execution time [ms]", 0.0) + totalExecutionTime;
-        }
-        for (size_t idx = 0, commandIdx = 0; idx < timestamps.size(); idx += 2, ++commandIdx) {
-            _profilingDataJsonOutput["Timestamps"] += CommandTimestamps(
-                commands[commandIdx], {timestamps[idx], timestamps[idx + 1]}, timestampPeriod, iteration);
+            _totalExecutionTimeMs += executionTime;
+            writeRecord("Execution Time", {{"Iteration", iteration + 1},
+                                           {"Execution time [ms]", executionTime},
+                                           {"Total execution time [ms]", _totalExecutionTimeMs}});
+            writeTimeline(runtimeProfilingData.value(), iteration);
         }
     }
     for (const auto &memoryUsage : memoryProfilingData.usages) {
-        _profilingDataJsonOutput["Memory Usage"] += {{"Command type", "DataGraphDispatch"},
-                                                     {"Command name", memoryUsage.commandName},
-                                                     {"Session memory [bytes]", memoryUsage.sessionMemoryBytes},
-                                                     {"Iteration", iteration}};
-    }
-    // Check if this is the last iteration
-    if (iteration + 1 == repeatCount) {
-        std::ofstream dumpFile(path.string());
-        dumpFile << _profilingDataJsonOutput.dump(4);
-        dumpFile.close();
-        _profilingDataJsonOutput = json::object();
+        writeRecord("Memory Usage", {{"Command type", "DataGraphDispatch"},
+                                     {"Command name", memoryUsage.commandName},
+                                     {"Session memory [bytes]", memoryUsage.sessionMemoryBytes},
+                                     {"Iteration", iteration}});
+    }
+    // Flush every iteration so a crash keeps the records collected so far
+    _stream.flush();
+}
+
+void ProfilingWriter::writeTimeline(const RuntimeProfilingData &runtimeProfilingData, const int iteration) {
+    constexpr size_t topCommandCount = 5;
+    const auto &commands = runtimeProfilingData.commands;
+    const auto analysis =
+        analyzeTimeline(runtimeProfilingData.timestamps, runtimeProfilingData.timestampPeriod, topCommandCount);
+    const auto frameFraction = [&analysis](double timeMs) {
+        return analysis.frameTimeMs > 0.0 ? timeMs / analysis.frameTimeMs : 0.0;
+    };
+    const auto commandTimeMs = [&runtimeProfilingData](size_t command) {
+        const auto &timestamps = runtimeProfilingData.timestamps;
+        return calculateElapsedTimeInMilliseconds(timestamps[2 * command], timestamps[2 * command + 1],
+                                                  runtimeProfilingData.timestampPeriod);
+    };
+
+    json gaps = json::array();
+    for (const auto &gap : analysis.gaps) {
+        gaps.push_back({{"After command", commands[gap.afterCommand].name},
+                        {"Before command", commands[gap.beforeCommand].name},
+                        {"Gap [ms]", gap.durationMs}});
+    }
+    json topCommands = json::array();
+    for (const auto command : analysis.topCommands) {
+        topCommands.push_back({{"Command type", commands[command].type},
+                               {"Command name", commands[command].name},
+                               {"Time for command [ms]", commandTimeMs(command)},
+                               {"Frame fraction", frameFraction(commandTimeMs(command))}});
+    }
+    json criticalPath = json::array();
+    for (const auto command : analysis.criticalPath) {
+        criticalPath.push_back(commands[command].name);
+    }
+    writeRecord("Timeline", {{"Iteration", iteration + 1},
+                             {"Frame time [ms]", analysis.frameTimeMs},
+                             {"Dispatch time [ms]", analysis.busyTimeMs},
+                             {"Gap time [ms]", analysis.gapTimeMs},
+                             {"Dispatch fraction", frameFraction(analysis.busyTimeMs)},
+                             {"Gap fraction", frameFraction(analysis.gapTimeMs)},
+                             {"Gaps", std::move(gaps)},
+                             {"Top commands", std::move(topCommands)},
+                             {"Critical path", std::move(criticalPath)},
+                             {"Critical path time [ms]", analysis.criticalPathTimeMs}});
+}
+
+void ProfilingWriter::writeRecording(const CommandRecordingStats &recordingStats, const int iteration) {
+    writeRecord("Recording", {{"Iteration", iteration + 1},
+                              {"Recording time [us]", recordingStats.recordingTimeUs},
+                              {"Command buffers", recordingStats.commandBuffers},
+                              {"Commands recorded", recordingStats.commands},
+                              {"Dispatches", recordingStats.dispatches},
+                              {"Descriptor set binds", recordingStats.descriptorSetBinds},
+                              {"Pipeline barriers", recordingStats.pipelineBarriers},
+                              {"Barriers", recordingStats.barriers},
+                              {"Setup descriptor writes", recordingStats.descriptorWrites}});
+    _stream.flush();
+}
+
+void ProfilingWriter::writeMemoryReport(const MemoryReport &memoryReport) {
+    for (const auto &resource : memoryReport.resources) {
+        json record{{"Resource type", resource.type},
+                    {"Resource name", resource.name},
+                    {"Requested size [bytes]", resource.requestedBytes},
+                    {"Allocated size [bytes]", resource.allocatedBytes},
+                    {"Memory type index", resource.memoryTypeIndex},
+                    {"Memory properties", resource.memoryProperties},
+                    {"Staging size [bytes]", resource.stagingBytes}};
+        if (resource.aliasGroup.has_value()) {
+            record["Alias group"] = *resource.aliasGroup;
+            record["Alias count"] = resource.aliasCount;
+        }
+        writeRecord("Resource Memory", std::move(record));
+    }
+
+    json summary{{"Device allocations", memoryReport.allocationCount},
+                 {"Resource memory [bytes]", memoryReport.resourceBytes},
+                 {"Staging memory [bytes]", memoryReport.stagingBytes},
+                 {"Session memory [bytes]", memoryReport.sessionMemoryBytes},
+                 {"Total allocated device memory [bytes]",
+                  memoryReport.resourceBytes + memoryReport.stagingBytes + memoryReport.sessionMemoryBytes},
+                 {"Peak allocated device memory [bytes]", memoryReport.peakAllocatedBytes},
+                 {"Aliasing savings [bytes]", memoryReport.aliasingSavedBytes},
+                 {"Session sharing savings [bytes]", memoryReport.sessionSharingSavedBytes},
+                 {"Session aliasing savings [bytes]", memoryReport.sessionAliasingSavedBytes}};
+    if (!memoryReport.heaps.empty()) {
+        json heaps = json::array();
+        for (const auto &heap : memoryReport.heaps) {
+            heaps.push_back({{"Heap index", heap.heapIndex},
+                             {"Size [bytes]", heap.sizeBytes},
+                             {"Budget [bytes]", heap.budgetBytes},
+                             {"Usage [bytes]", heap.usageBytes},
+                             {"Peak usage [bytes]", heap.peakUsageBytes}});
+        }
+        summary["Heaps"] = std::move(heaps);
+    }
+    if (memoryReport.hostResidentBytes.has_value()) {
+        summary["Host resident memory [bytes]"] = *memoryReport.hostResidentBytes;
+    }
+    if (memoryReport.hostPeakResidentBytes.has_value()) {
+        summary["Peak host resident memory [bytes]"] = *memoryReport.hostPeakResidentBytes;
+    }
+    if (memoryReport.hostResidentBeforeReleaseBytes.has_value() &&
+        memoryReport.hostResidentAfterReleaseBytes.has_value()) {
+        summary["Host resident memory before release [bytes]"] = *memoryReport.hostResidentBeforeReleaseBytes;
+        summary["Host resident memory after release [bytes]"] = *memoryReport.hostResidentAfterReleaseBytes;
     }
+    writeRecord("Memory Summary", std::move(summary));
+    _stream.flush();
 }
 
 } // namespace mlsdk::scenariorunner
@@ -6,17 +6,28 @@
 
 #include "perf_counter.hpp"
 
+#include "nlohmann/json.hpp"
+
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <optional>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace mlsdk::scenariorunner {
 
+struct ProfiledPipelineStatistics {
+    uint64_t computeShaderInvocations{};
+    uint64_t fragmentShaderInvocations{};
+};
+
 struct ProfiledCommand {
     std::string type;
     std::string name;
+    /// Only set for compute and graphics dispatches when pipeline statistics queries are supported
+    std::optional<ProfiledPipelineStatistics> pipelineStatistics{};
 };
 
 struct ProfiledMemoryUsage {
@@ -34,9 +45,130 @@ struct MemoryProfilingData {
     std::vector<ProfiledMemoryUsage> usages;
 };
 
-void writePerfCounters(std::vector<PerformanceCounter> &perfCounters, std::filesystem::path &path);
+/// \brief Device memory backing one buffer, tensor or image
+struct ResourceMemoryUsage {
+    std::string type;
+    std::string name;
+    /// Bytes the resource itself requires
+    uint64_t requestedBytes{};
+    /// Size of the device memory the resource is bound to, shared by every resource of its alias group
+    uint64_t allocatedBytes{};
+    uint32_t memoryTypeIndex{};
+    std::string memoryProperties;
+    std::optional<uint64_t> aliasGroup;
+    size_t aliasCount{};
+    /// Host-visible staging memory allocated next to the device memory
+    uint64_t stagingBytes{};
+};
+
+/// \brief Budget and usage of one memory heap as reported by VK_EXT_memory_budget
+struct MemoryHeapUsage {
+    uint32_t heapIndex{};
+    uint64_t sizeBytes{};
+    uint64_t budgetBytes{};
+    uint64_t usageBytes{};
+    /// Highest usage sampled after setup and after every iteration
+    uint64_t peakUsageBytes{};
+};
+
+/// \brief Memory allocated by the scenario, written once all iterations have run
+struct MemoryReport {
+    std::vector<ResourceMemoryUsage> resources;
+    /// Number of vkAllocateMemory calls made for resources, staging and data graph session memory
+    uint64_t allocationCount{};
+    uint64_t resourceBytes{};
+    uint64_t stagingBytes{};
+    uint64_t sessionMemoryBytes{};
+    /// Highest resource, staging and session memory allocated, sampled after setup and after every iteration
+    uint64_t peakAllocatedBytes{};
+    /// Bytes saved by binding the resources of an alias group to one allocation
+    uint64_t aliasingSavedBytes{};
+    /// Session memory saved by dispatches of a shared data graph pipeline sharing a session
+    uint64_t sessionSharingSavedBytes{};
+    /// Transient session memory saved by serialized data graph sessions aliasing one allocation
+    uint64_t sessionAliasingSavedBytes{};
+    /// Only filled in when VK_EXT_memory_budget is supported
+    std::vector<MemoryHeapUsage> heaps;
+    std::optional<uint64_t> hostResidentBytes;
+    std::optional<uint64_t> hostPeakResidentBytes;
+    /// Host resident memory before and after low memory mode released the setup state
+    std::optional<uint64_t> hostResidentBeforeReleaseBytes;
+    std::optional<uint64_t> hostResidentAfterReleaseBytes;
+};
+
+/// \brief Host-side cost of recording the command buffers of one iteration
+struct CommandRecordingStats {
+    int64_t recordingTimeUs{};
+    uint64_t commandBuffers{};
+    /// Commands recorded into the command buffers, without the queries skipped when their query pool is missing
+    uint64_t commands{};
+    uint64_t dispatches{};
+    uint64_t descriptorSetBinds{};
+    uint64_t pipelineBarriers{};
+    /// Memory, buffer, image and tensor barriers emitted by all pipeline barriers
+    uint64_t barriers{};
+    /// Descriptor writes performed once during setup
+    uint64_t descriptorWrites{};
+};
+
+struct PipelineExecutableStatistic {
+    std::string name;
+    std::string description;
+    std::variant<bool, int64_t, uint64_t, double> value;
+};
 
-void writeProfilingData(const std::optional<RuntimeProfilingData> &runtimeProfilingData,
-                        const MemoryProfilingData &memoryProfilingData, const std::filesystem::path &path,
-                        int iteration, int repeatCount);
+struct PipelineExecutableReport {
+    std::string name;
+    std::string description;
+    std::string stages;
+    uint32_t subgroupSize{};
+    std::vector<PipelineExecutableStatistic> statistics;
+};
+
+struct PipelineReport {
+    std::string name;
+    std::string type;
+    /// False when the implementation did not provide creation feedback for the pipeline
+    bool feedbackValid{};
+    bool cacheHit{};
+    uint64_t creationDurationNs{};
+    std::vector<uint64_t> stageCreationDurationsNs;
+    /// Only filled in when VK_KHR_pipeline_executable_properties is enabled
+    std::vector<PipelineExecutableReport> executables;
+};
+
+/// \brief Write count, sum, min, max and percentiles of every counter, grouped by category
+void writePerfCounters(const PerfCounterRegistry &perfCounters, const std::filesystem::path &path);
+
+/// \brief Write the creation feedback and executable statistics of every pipeline
+void writePipelineReport(const std::vector<PipelineReport> &pipelineReports, const std::filesystem::path &path);
+
+/// \brief Streams runtime profiling data to a JSON Lines file
+///
+/// Every line is one JSON object whose "Record" field is "Timestamp", "Memory Usage", "Execution Time",
+/// "Timeline", "Recording", "Resource Memory" or "Memory Summary". The "Timeline" record of every iteration reports
+/// the GPU time spent between commands, the most expensive commands and the critical path. Records are written and
+/// flushed once per iteration, so memory use does not depend on the number of iterations and the file stays readable
+/// if the run is interrupted.
+class ProfilingWriter {
+  public:
+    explicit ProfilingWriter(const std::filesystem::path &path);
+
+    /// \brief Write the timestamps and memory usages collected for @p iteration
+    void write(const std::optional<RuntimeProfilingData> &runtimeProfilingData,
+               const MemoryProfilingData &memoryProfilingData, int iteration);
+
+    /// \brief Write the command recording cost of @p iteration in record-only mode
+    void writeRecording(const CommandRecordingStats &recordingStats, int iteration);
+
+    /// \brief Write one "Resource Memory" record per resource followed by the "Memory Summary" record
+    void writeMemoryReport(const MemoryReport &memoryReport);
+
+  private:
+    void writeRecord(const char *recordType, nlohmann::json record);
+    void writeTimeline(const RuntimeProfilingData &runtimeProfilingData, int iteration);
+
+    std::ofstream _stream;
+    double _totalExecutionTimeMs{0.0};
+};
 } // namespace mlsdk::scenariorunner
@@ -1,10 +1,17 @@
 /*
- * SPDX-FileCopyrightText: Copyright 2024-2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-FileCopyrightText: Copyright 2024-2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "logging.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 namespace mlsdk::logging {
 
 std::ostream &operator<<(std::ostream &os, const LogLevel &logLevel) {
@@ -31,25 +38,121 @@ namespace {
 void noLogging([[maybe_unused]] const std::string &logger, [[maybe_unused]] LogLevel logLevel,
                [[maybe_unused]] const std::string &message) {}
 
+/// \brief Delivers queued messages to a logging handler on a worker thread
+class AsyncSink {
+  public:
+    explicit AsyncSink(LogHandler handler) : _handler(std::move(handler)), _worker([this] { run(); }) {}
+
+    ~AsyncSink() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wakeWorker.notify_one();
+        _worker.join();
+    }
+
+    AsyncSink(const AsyncSink &) = delete;
+    AsyncSink &operator=(const AsyncSink &) = delete;
+
+    void push(const std::string &logger, LogLevel logLevel, const std::string &message) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back({logger, logLevel, message});
+        }
+        _wakeWorker.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _drained.wait(lock, [this] { return _queue.empty() && !_delivering; });
+    }
+
+  private:
+    struct Entry {
+        std::string logger;
+        LogLevel logLevel;
+        std::string message;
+    };
+
+    void run() {
+        std::deque<Entry> batch;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wakeWorker.wait(lock, [this] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                // Only reached when stopping with nothing left to deliver
+                return;
+            }
+            // Take the whole queue so producers only contend for the lock while a message is appended
+            batch.swap(_queue);
+            _delivering = true;
+            lock.unlock();
+            for (const auto &entry : batch) {
+                _handler(entry.logger, entry.logLevel, entry.message);
+            }
+            batch.clear();
+            lock.lock();
+            _delivering = false;
+            _drained.notify_all();
+        }
+    }
+
+    LogHandler _handler;
+    std::mutex _mutex;
+    std::condition_variable _wakeWorker;
+    std::condition_variable _drained;
+    std::deque<Entry> _queue;
+    bool _delivering{false};
+    bool _stopping{false};
+    // Started last so that every other member is initialized before the worker runs
+    std::thread _worker;
+};
+
 struct LoggingConfig {
     std::string loggerName;
     LogHandler handler{noLogging};
-    LogLevel logLevel{LogLevel::Info};
+    // Destroyed first so queued messages are delivered while the handler is still alive
+    std::unique_ptr<AsyncSink> asyncSink;
 };
 
 LoggingConfig defaultConfig;
 
 } // namespace
 
-void setDefaultHandler(const LogHandler &logHandler) { defaultConfig.handler = logHandler; }
-void setDefaultLogLevel(LogLevel logLevel) { defaultConfig.logLevel = logLevel; }
+void setDefaultHandler(const LogHandler &logHandler) {
+    if (defaultConfig.asyncSink) {
+        // Deliver the messages queued for the previous handler before switching over
+        defaultConfig.asyncSink = std::make_unique<AsyncSink>(logHandler);
+    }
+    defaultConfig.handler = logHandler;
+}
+void setDefaultLogLevel(LogLevel logLevel) { detail::defaultLogLevel = logLevel; }
 void setDefaultLoggerName(const std::string &name) { defaultConfig.loggerName = name; }
 
+void setAsyncLogging(bool enable) {
+    if (!enable) {
+        defaultConfig.asyncSink.reset();
+    } else if (!defaultConfig.asyncSink) {
+        defaultConfig.asyncSink = std::make_unique<AsyncSink>(defaultConfig.handler);
+    }
+}
+
+void flush() {
+    if (defaultConfig.asyncSink) {
+        defaultConfig.asyncSink->flush();
+    }
+}
+
 void log(const std::string &logger, LogLevel logLevel, const std::string &message) {
-    if (logLevel < defaultConfig.logLevel) {
+    if (!isEnabled(logLevel)) {
         return;
     }
 
+    if (defaultConfig.asyncSink) {
+        defaultConfig.asyncSink->push(logger, logLevel, message);
+        return;
+    }
     defaultConfig.handler(logger, logLevel, message);
 }
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-FileCopyrightText: Copyright 2024, 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -20,6 +20,16 @@ std::ostream &operator<<(std::ostream &os, const LogLevel &logLevel);
 /// \brief Callable to handle the log messages
 using LogHandler = std::function<void(const std::string &logger, LogLevel logLevel, const std::string &message)>;
 
+namespace detail {
+/// Logging level of the default logger, read inline so filtered messages cost a single comparison
+inline LogLevel defaultLogLevel{LogLevel::Info};
+} // namespace detail
+
+/// \brief Check whether messages with the provided logging level are emitted by the default logger
+///
+/// \param logLevel Logging level
+inline bool isEnabled(LogLevel logLevel) { return logLevel >= detail::defaultLogLevel; }
+
 /// \brief Log the message with the provided logging level using default logger
 ///
 /// \param logLevel Logging level
@@ -68,4 +78,28 @@ void setDefaultLogLevel(LogLevel logLevel);
 /// \param name Logger name
 void setDefaultLoggerName(const std::string &name);
 
+/// \brief Hand emitted messages to the logging handler on a background thread
+///
+/// While enabled, logging only queues the message so the calling thread never waits on the handler. Disabling
+/// delivers the queued messages and stops the thread.
+///
+/// \param enable Whether to use the asynchronous sink
+void setAsyncLogging(bool enable);
+
+/// \brief Block until every queued message has been handed to the logging handler
+void flush();
+
 } // namespace mlsdk::logging
+
+/// \brief Log with the default logger, evaluating @p message only when @p logLevel is enabled
+#define MLSDK_LOG(logLevel, message)                                                                                   \
+    do {                                                                                                               \
+        if (::mlsdk::logging::isEnabled(logLevel)) {                                                                   \
+            ::mlsdk::logging::log(logLevel, message);                                                                  \
+        }                                                                                                              \
+    } while (false)
+
+#define MLSDK_LOG_DEBUG(message) MLSDK_LOG(::mlsdk::logging::LogLevel::Debug, message)
+#define MLSDK_LOG_INFO(message) MLSDK_LOG(::mlsdk::logging::LogLevel::Info, message)
+#define MLSDK_LOG_WARNING(message) MLSDK_LOG(::mlsdk::logging::LogLevel::Warning, message)
+#define MLSDK_LOG_ERROR(message) MLSDK_LOG(::mlsdk::logging::LogLevel::Error, message)
@@ -27,10 +27,10 @@
 using namespace mlsdk::scenariorunner;
 using namespace mlsdk::logging;
 namespace {
-constexpr std::array<std::string_view, 5> extensionList = {
+constexpr std::array<std::string_view, 6> extensionList = {
     VK_EXT_CUSTOM_BORDER_COLOR_EXTENSION_NAME, VK_EXT_FRAME_BOUNDARY_EXTENSION_NAME,
     VK_ARM_DATA_GRAPH_NEURAL_ACCELERATOR_STATISTICS_EXTENSION_NAME, VK_KHR_MAINTENANCE_5_EXTENSION_NAME,
-    VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME};
+    VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME, VK_KHR_PIPELINE_BINARY_EXTENSION_NAME};
 
 std::string printExtensionList() {
     size_t numExtensions = extensionList.size() - 1;
@@ -124,7 +124,10 @@ int runScenarioRunner(int argc, const char **argv) {
             .required()
             .nargs(1);
         parser.add_argument("--output").help("output folder").nargs(1);
-        parser.add_argument("--profiling-dump-path").help("path to save runtime profiling").nargs(1);
+        parser.add_argument("--profiling-dump-path").help("path to save runtime profiling as JSON Lines").nargs(1);
+        parser.add_argument("--pipeline-report-path")
+            .help("path to save pipeline creation feedback and executable statistics as JSON")
+            .nargs(1);
         parser.add_argument("--pipeline-caching")
             .help("enable the pipeline caching")
             .default_value(false)
@@ -137,6 +140,10 @@ int runScenarioRunner(int argc, const char **argv) {
             .help("set pipeline cache location")
             .default_value<std::string>(std::filesystem::temp_directory_path().string())
             .nargs(1);
+        parser.add_argument("--pipeline-cache-max-size")
+            .help("maximum size of the pipeline cache in MiB, least recently used entries are evicted [default: 256]")
+            .nargs(1)
+            .scan<'i', int>();
         parser.add_argument("--neural-debug-database-dump-dir")
             .help("path to dump Neural Accelerator Debug Database")
             .default_value<std::string>("");
@@ -159,10 +166,18 @@ int runScenarioRunner(int argc, const char **argv) {
             .help("path to save performance counter stats")
             .default_value<std::string>("")
             .nargs(1);
+        parser.add_argument("--perf-counters-raw-samples")
+            .help("number of most recent raw samples to keep per performance counter")
+            .nargs(1)
+            .scan<'i', int>();
         parser.add_argument("--log-level")
             .help("set logging level [default: info]")
             .choices("debug", "info", "warning", "error")
             .nargs(1);
+        parser.add_argument("--async-logging")
+            .help("hand log messages to a background thread so that logging does not stall the calling thread")
+            .default_value(false)
+            .implicit_value(true);
         parser.add_argument("--wait-for-key-stroke-before-run")
             .help("wait for a key stroke before run")
             .default_value(false)
@@ -171,6 +186,10 @@ int runScenarioRunner(int argc, const char **argv) {
             .help("setup pipelines but skip the actual execution")
             .default_value(false)
             .implicit_value(true);
+        parser.add_argument("--record-only")
+            .help("setup pipelines and record command buffers for every iteration without submitting them")
+            .default_value(false)
+            .implicit_value(true);
         parser.add_argument("--disable-extension")
             .append()
             .store_into(scenarioOptions.disabledExtensions)
@@ -186,6 +205,26 @@ int runScenarioRunner(int argc, const char **argv) {
         parser.add_argument("--session-memory-dump-dir")
             .help("path to dump the contents of the sessions ram after inference completes")
             .nargs(1);
+        parser.add_argument("--alias-session-memory")
+            .help("bind the transient memory of every data graph session to one allocation shared by serialized "
+                  "dispatches")
+            .default_value(false)
+            .implicit_value(true);
+        parser.add_argument("--low-memory")
+            .help("release mapped input files, shader modules and unused staging memory once the scenario is set up")
+            .default_value(false)
+            .implicit_value(true);
+        parser.add_argument("--tune")
+            .help("time the tuning candidates of shaders that have no tuning result for the device and use the fastest")
+            .default_value(false)
+            .implicit_value(true);
+        parser.add_argument("--tuning-database")
+            .help("path to the tuning database whose results are applied and to which new results are added")
+            .nargs(1);
+        parser.add_argument("--tuning-repeats")
+            .help("number of timed dispatches of every tuning candidate [default: 5]")
+            .nargs(1)
+            .scan<'i', int>();
         parser.add_argument("--repeat").help("optional repeat count for scenario execution").nargs(1).scan<'i', int>();
         parser.add_argument("--capture-frame")
             .help("enable RenderDoc integration for frame capturing")
@@ -206,6 +245,7 @@ int runScenarioRunner(int argc, const char **argv) {
             LogLevel logLevel = parseLogLevel(parser.get("--log-level"));
             setDefaultLogLevel(logLevel);
         }
+        setAsyncLogging(parser.get<bool>("--async-logging"));
 
         const auto scenarioArg = parser.get("--scenario");
         const auto scenarioFile = std::filesystem::path(scenarioArg);
@@ -228,6 +268,14 @@ int runScenarioRunner(int argc, const char **argv) {
                 throw std::runtime_error("Invalid cache directory: " + cacheDir.string());
             }
             scenarioOptions.pipelineCachePath = cacheDir / scenarioFile.filename().replace_extension("cache");
+            if (parser.is_used("--pipeline-cache-max-size")) {
+                const auto maxSize = parser.get<int>("--pipeline-cache-max-size");
+                if (maxSize <= 0) {
+                    throw std::runtime_error("Pipeline cache maximum size must be positive; received " +
+                                             std::to_string(maxSize) + ".");
+                }
+                scenarioOptions.pipelineCacheMaxSize = static_cast<uint64_t>(maxSize) * 1024 * 1024;
+            }
         }
 
         scenarioOptions.enableGPUDebugMarkers = parser.get<bool>("--enable-gpu-debug-markers");
@@ -275,6 +323,11 @@ int runScenarioRunner(int argc, const char **argv) {
             }
         }
 
+        scenarioOptions.aliasSessionMemory = parser.get<bool>("--alias-session-memory");
+        if (scenarioOptions.aliasSessionMemory && !scenarioOptions.sessionRAMsDumpDir.empty()) {
+            throw std::runtime_error("--alias-session-memory cannot be combined with --session-memory-dump-dir");
+        }
+
         if (parser.is_used("--perf-counters-dump-path")) {
             auto perfCountersPath = parser.get("--perf-counters-dump-path");
             scenarioOptions.perfCountersPath = std::filesystem::path(perfCountersPath);
@@ -283,6 +336,15 @@ int runScenarioRunner(int argc, const char **argv) {
             }
         }
 
+        if (parser.is_used("--perf-counters-raw-samples")) {
+            const auto rawSamples = parser.get<int>("--perf-counters-raw-samples");
+            if (rawSamples < 0) {
+                throw std::runtime_error("Performance counter raw sample count must not be negative; received " +
+                                         std::to_string(rawSamples) + ".");
+            }
+            scenarioOptions.perfCounterRawSamples = static_cast<size_t>(rawSamples);
+        }
+
         if (parser.is_used("--profiling-dump-path")) {
             auto profilingPath = parser.get("--profiling-dump-path");
             scenarioOptions.profilingPath = std::filesystem::path(profilingPath);
@@ -291,12 +353,35 @@ int runScenarioRunner(int argc, const char **argv) {
             }
         }
 
+        if (parser.is_used("--pipeline-report-path")) {
+            auto pipelineReportPath = parser.get("--pipeline-report-path");
+            scenarioOptions.pipelineReportPath = std::filesystem::path(pipelineReportPath);
+            if (!std::ofstream(scenarioOptions.pipelineReportPath)) {
+                throw std::runtime_error("Unable to open pipeline report file for writing " + pipelineReportPath);
+            }
+        }
+
         if (parser.get("--neural-statistics-mode") == "0") {
             scenarioOptions.neuralStatisticsMode = vk::NeuralAcceleratorStatisticsModeARM::eStatistics0;
         } else {
             scenarioOptions.neuralStatisticsMode = vk::NeuralAcceleratorStatisticsModeARM::eStatistics1;
         }
 
+        scenarioOptions.lowMemory = parser.get<bool>("--low-memory");
+
+        scenarioOptions.tune = parser.get<bool>("--tune");
+        if (parser.is_used("--tuning-database")) {
+            scenarioOptions.tuningDatabasePath = parser.get("--tuning-database");
+        }
+        if (parser.is_used("--tuning-repeats")) {
+            const auto tuningRepeats = parser.get<int>("--tuning-repeats");
+            if (tuningRepeats <= 0) {
+                throw std::runtime_error("Tuning repeat count must be greater than zero; received " +
+                                         std::to_string(tuningRepeats) + ".");
+            }
+            scenarioOptions.tuningRepeats = static_cast<uint32_t>(tuningRepeats);
+        }
+
         int repeatCount = 1;
         if (parser.is_used("--repeat")) {
             repeatCount = parser.get<int>("--repeat");
@@ -312,11 +397,23 @@ int runScenarioRunner(int argc, const char **argv) {
             repeatCount = 1;
         }
 
+        scenarioOptions.recordOnly = parser.get<bool>("--record-only");
+        if (dryRun && scenarioOptions.recordOnly) {
+            throw std::runtime_error("--record-only cannot be combined with --dry-run");
+        }
+        if (scenarioOptions.tune && (dryRun || scenarioOptions.recordOnly)) {
+            throw std::runtime_error("--tune cannot be combined with --dry-run or --record-only");
+        }
+
         scenarioOptions.captureFrame = parser.get<bool>("--capture-frame");
         if (dryRun && scenarioOptions.captureFrame) {
             mlsdk::logging::warning("Frame capture overruled by dry-run");
             scenarioOptions.captureFrame = false;
         }
+        if (scenarioOptions.recordOnly && scenarioOptions.captureFrame) {
+            mlsdk::logging::warning("Frame capture overruled by record-only");
+            scenarioOptions.captureFrame = false;
+        }
 
         pauseOnExit = parser.get<bool>("--pause-on-exit");
 
@@ -327,6 +424,7 @@ int runScenarioRunner(int argc, const char **argv) {
         Scenario scenario(scenarioOptions, scenarioSpec);
         if (parser.get<bool>("--wait-for-key-stroke-before-run")) {
             mlsdk::logging::info("Press enter to continue...");
+            mlsdk::logging::flush();
             std::ignore = getchar();
         }
         scenario.run(repeatCount, dryRun);
@@ -334,6 +432,8 @@ int runScenarioRunner(int argc, const char **argv) {
         mlsdk::logging::error(err.what());
         retval = -1;
     }
+    // Deliver any queued messages before returning to the caller
+    setAsyncLogging(false);
     if (pauseOnExit) { // cppcheck-suppress-begin knownConditionTrueFalse
         mlsdk::logging::info("Press enter to continue...");
         std::ignore = getchar();
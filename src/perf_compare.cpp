@@ -0,0 +1,238 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "perf_compare.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "nlohmann/json.hpp"
+
+namespace mlsdk::scenariorunner {
+using json = nlohmann::json;
+
+namespace {
+
+/// Two-sided 95% Student's t critical values for 1 to 30 degrees of freedom
+constexpr std::array<double, 30> tCritical95 = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                                2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                                2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+double tQuantile95(double degreesOfFreedom) {
+    // Rounding down keeps the interval conservative for fractional Welch-Satterthwaite degrees of freedom
+    const auto df = std::max(1.0, std::floor(degreesOfFreedom));
+    if (df > static_cast<double>(tCritical95.size())) {
+        return 1.96;
+    }
+    return tCritical95[static_cast<size_t>(df) - 1];
+}
+
+double mean(const std::vector<double> &samples) {
+    double sum = 0.0;
+    for (const auto sample : samples) {
+        sum += sample;
+    }
+    return sum / static_cast<double>(samples.size());
+}
+
+double variance(const std::vector<double> &samples, double sampleMean) {
+    double sum = 0.0;
+    for (const auto sample : samples) {
+        sum += (sample - sampleMean) * (sample - sampleMean);
+    }
+    return sum / static_cast<double>(samples.size() - 1);
+}
+
+std::string formatOptionalPercent(const std::optional<double> &value) {
+    if (!value.has_value()) {
+        return "-";
+    }
+    std::ostringstream stream;
+    stream << std::showpos << std::fixed << std::setprecision(2) << *value << "%";
+    return stream.str();
+}
+
+} // namespace
+
+void PerfRun::load(const std::filesystem::path &path) {
+    std::ifstream stream(path);
+    if (!stream) {
+        throw std::runtime_error("Unable to open performance data file " + path.string());
+    }
+    // A performance counter report is a single JSON document, while profiling data has one record per line
+    const auto document = json::parse(stream, nullptr, false);
+    if (!document.is_discarded() && document.is_object() && !document.contains("Record")) {
+        stream.clear();
+        stream.seekg(0);
+        loadPerfCounters(stream);
+        return;
+    }
+    stream.clear();
+    stream.seekg(0);
+    loadProfiling(stream);
+}
+
+void PerfRun::loadProfiling(std::istream &stream) {
+    // Commands are matched by name within an iteration; repeated names are numbered by their occurrence
+    std::map<int, std::map<std::string, double>> iterations;
+    std::map<int, std::map<std::string, int>> occurrences;
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        const auto record = json::parse(line);
+        const auto recordType = record.value("Record", std::string());
+        const auto iteration = record.value("Iteration", 0);
+        auto &metrics = iterations[iteration];
+        if (recordType == "Timestamp") {
+            const auto type = record.at("Command type").get<std::string>();
+            const auto name = record.at("Command name").get<std::string>();
+            const auto timeMs = record.at("Time for command [ms]").get<double>();
+            const auto occurrence = occurrences[iteration][type + " " + name]++;
+            auto metric = "Command " + type + " " + name;
+            if (occurrence > 0) {
+                metric += " #" + std::to_string(occurrence + 1);
+            }
+            metrics[metric + " [ms]"] = timeMs;
+            metrics["Command type " + type + " [ms]"] += timeMs;
+        } else if (recordType == "Execution Time") {
+            metrics["Execution time [ms]"] = record.at("Execution time [ms]").get<double>();
+        } else if (recordType == "Timeline") {
+            metrics["Dispatch time [ms]"] = record.at("Dispatch time [ms]").get<double>();
+            metrics["Gap time [ms]"] = record.at("Gap time [ms]").get<double>();
+        } else if (recordType == "Recording") {
+            metrics["Recording time [us]"] = record.at("Recording time [us]").get<double>();
+        }
+    }
+
+    for (const auto &[iteration, metrics] : iterations) {
+        for (const auto &[metric, value] : metrics) {
+            _samples[metric].push_back(value);
+        }
+    }
+}
+
+void PerfRun::loadPerfCounters(std::istream &stream) {
+    const auto report = json::parse(stream);
+    if (!report.is_object()) {
+        throw std::runtime_error("Performance counter report is not a JSON object");
+    }
+    for (const auto &[key, value] : report.items()) {
+        if (value.is_number()) {
+            if (key != "unit") {
+                _samples[key + " [us]"].push_back(value.get<double>());
+            }
+            continue;
+        }
+        if (!value.is_object() || !value.contains("counters")) {
+            continue;
+        }
+        _samples["Category " + key + " [us]"].push_back(value.at("total time").get<double>());
+        for (const auto &counter : value.at("counters")) {
+            const auto metric = "Counter " + key + "/" + counter.at("name").get<std::string>() + " [us]";
+            auto &samples = _samples[metric];
+            if (counter.contains("samples")) {
+                // Raw samples give one sample per measurement rather than one per run
+                for (const auto &sample : counter.at("samples")) {
+                    samples.push_back(sample.get<double>());
+                }
+            } else if (counter.contains("count")) {
+                const auto count = counter.at("count").get<uint64_t>();
+                if (count != 0) {
+                    samples.push_back(counter.at("sum").get<double>() / static_cast<double>(count));
+                }
+            } else {
+                samples.push_back(counter.at("value").get<double>());
+            }
+        }
+    }
+}
+
+std::vector<MetricComparison> comparePerfRuns(const PerfRun &baseline, const PerfRun &candidate,
+                                              double thresholdPercent) {
+    std::vector<MetricComparison> comparisons;
+    const auto &candidateSamples = candidate.getSamples();
+    for (const auto &[metric, baselineValues] : baseline.getSamples()) {
+        const auto it = candidateSamples.find(metric);
+        if (it == candidateSamples.end() || it->second.empty() || baselineValues.empty()) {
+            continue;
+        }
+        const auto &candidateValues = it->second;
+
+        MetricComparison comparison;
+        comparison.metric = metric;
+        comparison.baselineCount = baselineValues.size();
+        comparison.candidateCount = candidateValues.size();
+        comparison.baselineMean = mean(baselineValues);
+        comparison.candidateMean = mean(candidateValues);
+
+        if (comparison.baselineMean != 0.0) {
+            const auto delta = comparison.candidateMean - comparison.baselineMean;
+            comparison.deltaPercent = delta / comparison.baselineMean * 100.0;
+
+            if (comparison.baselineCount > 1 && comparison.candidateCount > 1) {
+                // Welch's interval for the difference of means, which does not assume equal variances
+                const auto baselineTerm =
+                    variance(baselineValues, comparison.baselineMean) / static_cast<double>(comparison.baselineCount);
+                const auto candidateTerm = variance(candidateValues, comparison.candidateMean) /
+                                           static_cast<double>(comparison.candidateCount);
+                const auto standardError = std::sqrt(baselineTerm + candidateTerm);
+                double halfWidth = 0.0;
+                if (standardError > 0.0) {
+                    const auto degreesOfFreedom =
+                        std::pow(baselineTerm + candidateTerm, 2.0) /
+                        (baselineTerm * baselineTerm / static_cast<double>(comparison.baselineCount - 1) +
+                         candidateTerm * candidateTerm / static_cast<double>(comparison.candidateCount - 1));
+                    halfWidth = tQuantile95(degreesOfFreedom) * standardError;
+                }
+                comparison.ciLowPercent = (delta - halfWidth) / comparison.baselineMean * 100.0;
+                comparison.ciHighPercent = (delta + halfWidth) / comparison.baselineMean * 100.0;
+            }
+
+            comparison.regression = *comparison.deltaPercent > thresholdPercent &&
+                                    (!comparison.ciLowPercent.has_value() || *comparison.ciLowPercent > 0.0);
+        }
+        comparisons.push_back(std::move(comparison));
+    }
+    return comparisons;
+}
+
+size_t printComparisonTable(const std::vector<MetricComparison> &comparisons, std::ostream &stream) {
+    size_t metricWidth = std::string("Metric").size();
+    for (const auto &comparison : comparisons) {
+        metricWidth = std::max(metricWidth, comparison.metric.size());
+    }
+    const auto metricColumn = static_cast<int>(metricWidth) + 2;
+
+    stream << std::left << std::setw(metricColumn) << "Metric" << std::right << std::setw(14) << "Baseline"
+           << std::setw(14) << "Candidate" << std::setw(10) << "Delta" << std::setw(24) << "95% CI" << "  Status\n";
+
+    size_t regressions = 0;
+    for (const auto &comparison : comparisons) {
+        std::string interval = "-";
+        if (comparison.ciLowPercent.has_value()) {
+            interval = "[" + formatOptionalPercent(comparison.ciLowPercent) + ", " +
+                       formatOptionalPercent(comparison.ciHighPercent) + "]";
+        }
+        stream << std::left << std::setw(metricColumn) << comparison.metric << std::right << std::fixed
+               << std::setprecision(3) << std::setw(14) << comparison.baselineMean << std::setw(14)
+               << comparison.candidateMean << std::setw(10) << formatOptionalPercent(comparison.deltaPercent)
+               << std::setw(24) << interval << "  " << (comparison.regression ? "REGRESSION" : "ok") << "\n";
+        if (comparison.regression) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+} // namespace mlsdk::scenariorunner
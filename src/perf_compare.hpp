@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief Samples of every metric found in the profiling and performance counter outputs of one run
+///
+/// Metrics are keyed by a readable name such as "Command ComputeDispatch add" or "Counter Pipeline Setup/...".
+/// Every iteration of a profiling file and every file added to the run contributes one sample, so files produced
+/// by several invocations of the same build can be pooled into one run.
+class PerfRun {
+  public:
+    /// \brief Add the samples of a --profiling-dump-path or --perf-counters-dump-path file
+    void load(const std::filesystem::path &path);
+
+    /// \brief Add the records of a --profiling-dump-path JSON Lines file
+    void loadProfiling(std::istream &stream);
+
+    /// \brief Add the content of a --perf-counters-dump-path JSON file
+    void loadPerfCounters(std::istream &stream);
+
+    const std::map<std::string, std::vector<double>> &getSamples() const { return _samples; }
+
+  private:
+    std::map<std::string, std::vector<double>> _samples;
+};
+
+/// \brief Comparison of one metric between a baseline and a candidate run
+struct MetricComparison {
+    std::string metric;
+    size_t baselineCount{0};
+    size_t candidateCount{0};
+    double baselineMean{0.0};
+    double candidateMean{0.0};
+    /// Relative change of the mean; empty when the baseline mean is zero
+    std::optional<double> deltaPercent;
+    /// 95% confidence interval of the relative change; empty with fewer than two samples on either side
+    std::optional<double> ciLowPercent;
+    std::optional<double> ciHighPercent;
+    bool regression{false};
+};
+
+/// \brief Compare every metric present in both runs
+///
+/// A metric regresses when its mean grows by more than @p thresholdPercent and, when both runs have enough samples
+/// for a confidence interval, the whole interval lies above zero. Metrics present in only one run are skipped.
+std::vector<MetricComparison> comparePerfRuns(const PerfRun &baseline, const PerfRun &candidate,
+                                              double thresholdPercent);
+
+/// \brief Print @p comparisons as a table and return the number of regressions
+size_t printComparisonTable(const std::vector<MetricComparison> &comparisons, std::ostream &stream);
+
+} // namespace mlsdk::scenariorunner
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "perf_counter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace mlsdk::scenariorunner {
+
+const char *perfCategoryName(PerfCategory category) {
+    switch (category) {
+    case PerfCategory::ScenarioSetup:
+        return "Scenario Setup";
+    case PerfCategory::PipelineSetup:
+        return "Pipeline Setup";
+    case PerfCategory::LoadPipelineCache:
+        return "Load Pipeline Cache";
+    case PerfCategory::SavePipelineCache:
+        return "Save Pipeline Cache";
+    case PerfCategory::RunScenario:
+        return "Run Scenario";
+    case PerfCategory::SaveResults:
+        return "Save Results";
+    }
+    throw std::runtime_error("Unknown performance counter category");
+}
+
+uint32_t LogLinearHistogram::bucketIndex(uint64_t value) {
+    if (value < subBucketCount) {
+        return static_cast<uint32_t>(value);
+    }
+    uint32_t exponent = subBucketBits;
+    while ((value >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    const auto subBucket = static_cast<uint32_t>(value >> (exponent - subBucketBits)) - subBucketCount;
+    return (exponent - subBucketBits + 1) * subBucketCount + subBucket;
+}
+
+uint64_t LogLinearHistogram::bucketUpperBound(uint32_t index) {
+    if (index < subBucketCount) {
+        return index;
+    }
+    const uint32_t shift = index / subBucketCount - 1;
+    const uint64_t mantissa = index % subBucketCount + subBucketCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LogLinearHistogram::record(int64_t value) {
+    value = std::max<int64_t>(value, 0);
+    ++_buckets[bucketIndex(static_cast<uint64_t>(value))];
+    if (_count == 0) {
+        _min = value;
+        _max = value;
+    } else {
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+    ++_count;
+    _sum += value;
+}
+
+int64_t LogLinearHistogram::percentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(_count))));
+    uint64_t cumulative = 0;
+    for (uint32_t index = 0; index < bucketCount; ++index) {
+        cumulative += _buckets[index];
+        if (cumulative >= rank) {
+            return std::clamp(static_cast<int64_t>(bucketUpperBound(index)), _min, _max);
+        }
+    }
+    return _max;
+}
+
+PerfCounterId PerfCounterRegistry::registerCounter(std::string_view name, PerfCategory category,
+                                                   bool isPartOfTimeToInference) {
+    if (const auto it = _ids.find(name); it != _ids.end()) {
+        const auto &counter = _counters[it->second];
+        if (counter.category != category || counter.isPartOfTimeToInference != isPartOfTimeToInference) {
+            throw std::runtime_error("Performance counter " + counter.name +
+                                     " is already registered with a different category or time to inference flag");
+        }
+        return it->second;
+    }
+    const auto id = static_cast<PerfCounterId>(_counters.size());
+    auto &counter = _counters.emplace_back();
+    counter.name = std::string(name);
+    counter.category = category;
+    counter.isPartOfTimeToInference = isPartOfTimeToInference;
+    counter.rawSamples.reserve(_rawSampleCapacity);
+    _ids.emplace(counter.name, id);
+    return id;
+}
+
+void PerfCounterRegistry::record(PerfCounterId id, int64_t elapsedMicroseconds) {
+    auto &counter = _counters.at(id);
+    counter.histogram.record(elapsedMicroseconds);
+    if (_rawSampleCapacity == 0) {
+        return;
+    }
+    if (counter.rawSamples.size() < _rawSampleCapacity) {
+        counter.rawSamples.push_back(elapsedMicroseconds);
+    } else {
+        counter.rawSamples[counter.nextRawSample] = elapsedMicroseconds;
+    }
+    counter.nextRawSample = (counter.nextRawSample + 1) % _rawSampleCapacity;
+}
+
+std::vector<int64_t> PerfCounterRegistry::getRawSamples(PerfCounterId id) const {
+    const auto &counter = _counters.at(id);
+    if (counter.rawSamples.size() < _rawSampleCapacity) {
+        return counter.rawSamples;
+    }
+    std::vector<int64_t> samples;
+    samples.reserve(counter.rawSamples.size());
+    const auto oldest = counter.rawSamples.begin() + static_cast<std::ptrdiff_t>(counter.nextRawSample);
+    samples.insert(samples.end(), oldest, counter.rawSamples.end());
+    samples.insert(samples.end(), counter.rawSamples.begin(), oldest);
+    return samples;
+}
+
+} // namespace mlsdk::scenariorunner
@@ -1,57 +1,120 @@
 /*
- * SPDX-FileCopyrightText: Copyright 2024-2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-FileCopyrightText: Copyright 2024-2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
  * SPDX-License-Identifier: Apache-2.0
  */
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mlsdk::scenariorunner {
 
-class PerformanceCounter {
+enum class PerfCategory {
+    ScenarioSetup,
+    PipelineSetup,
+    LoadPipelineCache,
+    SavePipelineCache,
+    RunScenario,
+    SaveResults,
+};
+
+/// \brief Name of the category as written to the performance counter report
+const char *perfCategoryName(PerfCategory category);
+
+using PerfCounterId = uint32_t;
+
+/// \brief Fixed-size histogram of non-negative durations
+///
+/// Values below 16 have exact buckets; larger values use 16 linear sub-buckets per power of two, so every
+/// reported percentile is within 6.25% of the recorded value.
+class LogLinearHistogram {
   public:
-    explicit PerformanceCounter(std::string name, std::string category, bool isPartOfTimeToInference)
-        : _startTimePoint(std::chrono::time_point<Clock>::min()), _elapsedTime(0), _name(std::move(name)),
-          _category(std::move(category)), _isPartOfTimeToInference(isPartOfTimeToInference) {}
+    static constexpr uint32_t subBucketBits = 4;
+    static constexpr uint32_t subBucketCount = 1U << subBucketBits;
+    static constexpr uint32_t bucketCount = (64 - subBucketBits) * subBucketCount;
 
-    void start() { _startTimePoint = Clock::now(); }
+    void record(int64_t value);
 
-    void stop() {
-        _elapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _startTimePoint);
-    }
+    uint64_t count() const { return _count; }
+    int64_t sum() const { return _sum; }
+    int64_t min() const { return _count == 0 ? 0 : _min; }
+    int64_t max() const { return _max; }
 
-    void reset() {
-        _elapsedTime = std::chrono::microseconds(0);
-        _startTimePoint = std::chrono::time_point<Clock>::min();
-    }
+    /// \brief Upper bound of the bucket holding the value at @p percentile, clamped to [min, max]
+    /// \param percentile Value in the range [0, 100]
+    int64_t percentile(double percentile) const;
 
-    int64_t getElapsedTime() const { return _elapsedTime.count(); }
-    const std::string &getName() const { return _name; }
-    const std::string &getCategory() const { return _category; }
-    bool isPartOfTimeToInference() const { return _isPartOfTimeToInference; }
+    static uint32_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(uint32_t index);
 
   private:
-    using Clock = std::chrono::high_resolution_clock;
+    std::array<uint64_t, bucketCount> _buckets{};
+    uint64_t _count{0};
+    int64_t _sum{0};
+    int64_t _min{0};
+    int64_t _max{0};
+};
 
-    std::chrono::time_point<Clock> _startTimePoint;
-    std::chrono::microseconds _elapsedTime;
-    std::string _name;
-    std::string _category;
-    bool _isPartOfTimeToInference;
+/// \brief Statistics of one interned performance counter
+struct PerfCounterStats {
+    std::string name;
+    PerfCategory category{};
+    bool isPartOfTimeToInference{true};
+    LogLinearHistogram histogram;
+    /// Ring of the most recent raw samples in microseconds; see PerfCounterRegistry::getRawSamples()
+    std::vector<int64_t> rawSamples;
+    size_t nextRawSample{0};
 };
 
-/// Automatically starts the counter on construction and stops it on destruction
+/// \brief Interned performance counters that aggregate every sample into a histogram
+///
+/// Counters are registered once by name and then recorded through their ID, so repeated measurements of the same
+/// step neither allocate nor grow the report. Optionally the last @p rawSampleCapacity samples of every counter are
+/// kept in a ring.
+class PerfCounterRegistry {
+  public:
+    explicit PerfCounterRegistry(size_t rawSampleCapacity = 0) : _rawSampleCapacity(rawSampleCapacity) {}
+
+    /// \brief Return the ID of the counter called @p name, registering it on first use
+    ///
+    /// Throws when @p name is already registered with another category or time to inference flag.
+    PerfCounterId registerCounter(std::string_view name, PerfCategory category, bool isPartOfTimeToInference = true);
+
+    /// \brief Record one sample of @p elapsedMicroseconds for counter @p id
+    void record(PerfCounterId id, int64_t elapsedMicroseconds);
+
+    const std::vector<PerfCounterStats> &getCounters() const { return _counters; }
+
+    /// \brief Return the retained raw samples of counter @p id in recording order
+    std::vector<int64_t> getRawSamples(PerfCounterId id) const;
+
+  private:
+    size_t _rawSampleCapacity;
+    std::vector<PerfCounterStats> _counters;
+    std::map<std::string, PerfCounterId, std::less<>> _ids;
+};
+
+/// Automatically starts timing on construction and records the elapsed time on destruction
 class PerfCounterGuard {
   public:
-    PerfCounterGuard(std::vector<PerformanceCounter> &counters, std::string name, std::string category,
+    PerfCounterGuard(PerfCounterRegistry &registry, PerfCounterId id)
+        : _registry(registry), _id(id), _startTimePoint(Clock::now()) {}
+
+    PerfCounterGuard(PerfCounterRegistry &registry, std::string_view name, PerfCategory category,
                      bool isPartOfTimeToInference = true)
-        : counter_(counters.emplace_back(std::move(name), std::move(category), isPartOfTimeToInference)) {
-        counter_.start();
-    }
+        : PerfCounterGuard(registry, registry.registerCounter(name, category, isPartOfTimeToInference)) {}
 
-    ~PerfCounterGuard() { counter_.stop(); }
+    ~PerfCounterGuard() {
+        _registry.record(_id,
+                         std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _startTimePoint).count());
+    }
 
     PerfCounterGuard(const PerfCounterGuard &) = delete;
     PerfCounterGuard &operator=(const PerfCounterGuard &) = delete;
@@ -59,16 +122,11 @@ class PerfCounterGuard {
     PerfCounterGuard &operator=(PerfCounterGuard &&) = delete;
 
   private:
-    PerformanceCounter &counter_;
-};
-
-struct AggregateStat {
-    AggregateStat() = default;
-    explicit AggregateStat(const std::string &name) : name(name) {}
+    using Clock = std::chrono::high_resolution_clock;
 
-    std::string name;
-    int64_t aggregateTime = 0;
-    std::vector<PerformanceCounter> counters;
+    PerfCounterRegistry &_registry;
+    PerfCounterId _id;
+    std::chrono::time_point<Clock> _startTimePoint;
 };
 
 } // namespace mlsdk::scenariorunner
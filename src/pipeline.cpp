@@ -12,6 +12,9 @@
 
 #include <algorithm>
 #include <array>
+#include <future>
+#include <tuple>
+#include <utility>
 
 namespace mlsdk::scenariorunner {
 
@@ -36,10 +39,11 @@ bool makePipelineRobustnessCreateInfo(const Context &ctx, vk::PipelineRobustness
     return true;
 }
 
-void throwOnPipelineCacheMiss(const vk::raii::Pipeline &pipeline, const std::shared_ptr<PipelineCache> &pipelineCache,
-                              const std::string &pipelineName) {
-    if (pipelineCache && pipelineCache->failOnCacheMiss() &&
-        (!pipelineCache->wasPipelineCacheHit() ||
+void throwOnPipelineCacheMiss(const vk::raii::Pipeline &pipeline, const PipelineCacheEntry *cacheEntry,
+                              const PipelineCreationFeedback &feedback, const std::string &pipelineName) {
+    // Pipelines created from binaries are never compiled, whatever the feedback reports
+    if (cacheEntry && cacheEntry->failOnCacheMiss() && !cacheEntry->createdFromBinaries() &&
+        (!feedback.wasPipelineCacheHit() ||
          pipeline.getConstructorSuccessCode() == vk::Result::ePipelineCompileRequired)) {
         throw std::runtime_error("Pipeline cache miss for pipeline: " + pipelineName);
     }
@@ -56,11 +60,79 @@ vk::raii::ShaderModule createShaderModuleFromCode(const Context &ctx, const uint
     return vk::raii::ShaderModule(ctx.device(), shaderCreateInfo);
 }
 
-vk::raii::ShaderModule createShaderModule(const Context &ctx, const ShaderInfo &shaderInfo) {
+void addShaderToKey(PipelineKey &key, const uint32_t *spvCode, size_t spvSize, const ShaderInfo &shaderInfo) {
+    key.add(static_cast<uint64_t>(spvSize)).add(spvCode, spvSize * sizeof(uint32_t)).add(shaderInfo.entry);
+    key.add(static_cast<uint64_t>(shaderInfo.specializationConstants.size()));
+    for (const auto &specConst : shaderInfo.specializationConstants) {
+        key.add(specConst.id).add(specConst.value.ui);
+    }
+}
+
+vk::raii::ShaderModule createShaderModule(const Context &ctx, const ShaderInfo &shaderInfo, PipelineKey &sourceKey) {
     const std::vector<uint32_t> code = readShaderCode(shaderInfo);
+    addShaderToKey(sourceKey, code.data(), code.size(), shaderInfo);
     return createShaderModuleFromCode(ctx, code.data(), code.size());
 }
 
+void addTensorDescriptionToKey(PipelineKey &key, const vk::TensorDescriptionARM &description) {
+    key.add(description.tiling).add(description.format).add(static_cast<uint64_t>(description.usage));
+    key.add(description.dimensionCount).add(description.pDimensions, description.dimensionCount * sizeof(int64_t));
+    key.add(description.pStrides != nullptr);
+    if (description.pStrides != nullptr) {
+        key.add(description.pStrides, description.dimensionCount * sizeof(int64_t));
+    }
+}
+
+/// Add the tensor descriptions, image layouts and sparsity information chained to a resource info or constant
+void addChainToKey(PipelineKey &key, const void *next) {
+    for (const auto *structure = static_cast<const vk::BaseInStructure *>(next); structure != nullptr;
+         structure = structure->pNext) {
+        key.add(structure->sType);
+        switch (structure->sType) {
+        case vk::StructureType::eTensorDescriptionARM:
+            addTensorDescriptionToKey(key, *reinterpret_cast<const vk::TensorDescriptionARM *>(structure));
+            break;
+        case vk::StructureType::eDataGraphPipelineResourceInfoImageLayoutARM:
+            key.add(reinterpret_cast<const vk::DataGraphPipelineResourceInfoImageLayoutARM *>(structure)->layout);
+            break;
+        case vk::StructureType::eDataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM: {
+            const auto &sparsity =
+                *reinterpret_cast<const vk::DataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM *>(structure);
+            key.add(sparsity.dimension).add(sparsity.zeroCount).add(sparsity.groupSize);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+void addResourceInfosToKey(PipelineKey &key, const std::vector<vk::DataGraphPipelineResourceInfoARM> &resourceInfos) {
+    key.add(static_cast<uint64_t>(resourceInfos.size()));
+    for (const auto &resourceInfo : resourceInfos) {
+        key.add(resourceInfo.descriptorSet).add(resourceInfo.binding).add(resourceInfo.arrayElement);
+        addChainToKey(key, resourceInfo.pNext);
+    }
+}
+
+void addConstantInfosToKey(PipelineKey &key, const std::vector<vk::DataGraphPipelineConstantARM> &constantInfos) {
+    key.add(static_cast<uint64_t>(constantInfos.size()));
+    for (const auto &constantInfo : constantInfos) {
+        key.add(constantInfo.id);
+        addChainToKey(key, constantInfo.pNext);
+        // The constant data is described by the tensor description chained to the constant
+        const auto *description = static_cast<const vk::TensorDescriptionARM *>(constantInfo.pNext);
+        if (description == nullptr || description->sType != vk::StructureType::eTensorDescriptionARM) {
+            continue;
+        }
+        uint64_t size = elementSizeFromVkFormat(description->format);
+        for (uint32_t dim = 0; dim < description->dimensionCount; ++dim) {
+            size *= static_cast<uint64_t>(description->pDimensions[dim]);
+        }
+        key.add(constantInfo.pConstantData, static_cast<size_t>(size));
+    }
+}
+
 std::vector<vk::DescriptorSetLayout>
 rawLayouts(const std::vector<vk::raii::DescriptorSetLayout> &descriptorSetLayouts) {
     std::vector<vk::DescriptorSetLayout> layouts;
@@ -111,8 +183,61 @@ std::vector<std::vector<TypedBinding>> splitOutSets(const std::vector<TypedBindi
     return setBindings;
 }
 
+/// Help with the deferred operation, returning false when it has no work for this thread yet
+bool joinDeferredOperation(const vk::raii::DeferredOperationKHR &operation) {
+    // Idle threads go back to the pool and retry later, as the operation may hand out more work before it completes
+    return operation.join() != vk::Result::eThreadIdleKHR;
+}
+
 } // namespace
 
+/// \brief Data graph pipeline creation, with the create info structures and the data they point to
+///
+/// The driver reads the create info until a deferred creation completes, so everything it points to lives here
+/// rather than on the stack of the constructor, at an address that stays put when the Pipeline is moved.
+struct Pipeline::DeferredCreation {
+    DeferredCreation(const vk::raii::Device &device, WorkerPool &workerPool) : device(device), workerPool(workerPool) {}
+
+    DeferredCreation(const DeferredCreation &) = delete;
+    DeferredCreation &operator=(const DeferredCreation &) = delete;
+
+    ~DeferredCreation() {
+        for (auto &worker : workers) {
+            if (worker.valid()) {
+                worker.wait();
+            }
+        }
+        // Creation completed but the pipeline was never handed over
+        if (pipeline != VK_NULL_HANDLE) {
+            const vk::raii::Pipeline unused(device, pipeline);
+        }
+    }
+
+    /// \brief Keep @p value alive until the creation completes
+    template <typename T> T &retain(T value = T()) {
+        auto retained = std::make_shared<T>(std::move(value));
+        storage.push_back(retained);
+        return *retained;
+    }
+
+    const vk::raii::Device &device;
+    WorkerPool &workerPool;
+    std::vector<std::shared_ptr<void>> storage;
+    std::shared_ptr<PipelineCache> pipelineCache;
+    std::unique_ptr<PipelineCacheEntry> cacheEntry;
+    PipelineCreationFeedback feedback;
+    /// Sessions to create once the pipeline is complete
+    size_t sessionCount{1};
+    vk::raii::DeferredOperationKHR operation{nullptr};
+    VkPipeline pipeline{VK_NULL_HANDLE};
+    vk::Result result{vk::Result::eSuccess};
+    std::vector<std::future<void>> workers;
+};
+
+Pipeline::Pipeline(Pipeline &&other) = default;
+Pipeline &Pipeline::operator=(Pipeline &&other) = default;
+Pipeline::~Pipeline() = default;
+
 namespace {
 
 vk::TensorTilingARM convertImageTiling(const vk::ImageTiling tiling) {
@@ -167,6 +292,10 @@ void makeResourceInfos(const std::vector<TypedBinding> &bindings, const DataMana
 } // namespace
 
 void Pipeline::createDescriptorSetLayouts(const Context &ctx, const std::vector<TypedBinding> &bindings) {
+    _sourceKey.add(static_cast<uint64_t>(bindings.size()));
+    for (const auto &binding : bindings) {
+        _sourceKey.add(binding.set).add(binding.id).add(binding.vkDescriptorType);
+    }
     for (const auto &setBindings : splitOutSets(bindings)) {
         _descriptorSetLayouts.push_back(createDescriptorSetLayout(ctx, setBindings));
     }
@@ -174,6 +303,16 @@ void Pipeline::createDescriptorSetLayouts(const Context &ctx, const std::vector<
 
 void Pipeline::computePipelineCommon(const Context &ctx, const ShaderInfo &shaderInfo,
                                      const std::shared_ptr<PipelineCache> &pipelineCache) {
+    vk::PipelineRobustnessCreateInfo pipelineRobustnessInfo{};
+    const bool robustness = makePipelineRobustnessCreateInfo(ctx, pipelineRobustnessInfo);
+
+    std::unique_ptr<PipelineCacheEntry> cacheEntry;
+    if (pipelineCache) {
+        auto key = pipelineCache->makeKey(_type);
+        key.add(_sourceKey.value()).add(shaderInfo.pushConstantsSize).add(robustness);
+        cacheEntry = pipelineCache->lookup(key, _debugName, true);
+    }
+
     _pipelineLayout = createPipelineLayout(ctx, _descriptorSetLayouts, shaderInfo.pushConstantsSize,
                                            vk::ShaderStageFlagBits::eCompute);
     _pushConstantStages = shaderInfo.pushConstantsSize > 0
@@ -197,24 +336,28 @@ void Pipeline::computePipelineCommon(const Context &ctx, const ShaderInfo &shade
         {}, vk::ShaderStageFlagBits::eCompute, *_shader, shaderInfo.entry.c_str(), specInfoPtr);
 
     vk::PipelineCreateFlags flags{};
-    const void *pNext{nullptr};
+    if (ctx._optionals.pipeline_executable_properties) {
+        flags |= vk::PipelineCreateFlagBits::eCaptureStatisticsKHR;
+    }
     const vk::raii::PipelineCache *vkPipelineCache{nullptr};
-    if (pipelineCache) {
-        if (pipelineCache->failOnCacheMiss()) {
+    if (cacheEntry) {
+        if (cacheEntry->failOnCacheMiss()) {
             flags |= vk::PipelineCreateFlagBits::eFailOnPipelineCompileRequired;
         }
-        pNext = pipelineCache->getCacheFeedbackCreateInfo(_type);
-        vkPipelineCache = pipelineCache->get();
+        vkPipelineCache = cacheEntry->get();
     }
 
     vk::ComputePipelineCreateInfo computePipelineCreateInfo(flags, pipelineShaderStageCreateInfo, *_pipelineLayout, {},
-                                                            {}, pNext);
-    vk::PipelineRobustnessCreateInfo pipelineRobustnessInfo{};
-    if (makePipelineRobustnessCreateInfo(ctx, pipelineRobustnessInfo)) {
+                                                            {}, _creationFeedback.getCreateInfo(_type));
+    if (robustness) {
         insertAfter(&computePipelineCreateInfo, &pipelineRobustnessInfo);
     }
+    if (cacheEntry) {
+        computePipelineCreateInfo.pNext = cacheEntry->chainBinaryCreateInfo(flags, computePipelineCreateInfo.pNext);
+    }
     _pipeline = vk::raii::Pipeline(ctx.device(), vkPipelineCache, computePipelineCreateInfo);
-    throwOnPipelineCacheMiss(_pipeline, pipelineCache, shaderInfo.debugName);
+    throwOnPipelineCacheMiss(_pipeline, cacheEntry.get(), _creationFeedback, shaderInfo.debugName);
+    storePipelineCacheEntry(cacheEntry.get());
 
     trySetVkRaiiObjectDebugName(ctx, _pipeline, _debugName);
 }
@@ -307,23 +450,37 @@ void Pipeline::graphicsPipelineCommon(const Context &ctx, const ShaderInfo &vert
     graphicsPipelineCreateInfo.setPNext(&renderingInfo);
 
     vk::PipelineRobustnessCreateInfo pipelineRobustnessInfo{};
-    if (makePipelineRobustnessCreateInfo(ctx, pipelineRobustnessInfo)) {
+    const bool robustness = makePipelineRobustnessCreateInfo(ctx, pipelineRobustnessInfo);
+    if (robustness) {
         insertAfter(&renderingInfo, &pipelineRobustnessInfo);
     }
 
+    insertAfter(&renderingInfo, _creationFeedback.getCreateInfo(_type));
+
+    std::unique_ptr<PipelineCacheEntry> cacheEntry;
+    if (pipelineCache) {
+        auto key = pipelineCache->makeKey(_type);
+        key.add(_sourceKey.value()).add(pushConstantsSize).add(colorAttachmentFormats).add(robustness);
+        cacheEntry = pipelineCache->lookup(key, _debugName, true);
+    }
+
     vk::PipelineCreateFlags flags{};
+    if (ctx._optionals.pipeline_executable_properties) {
+        flags |= vk::PipelineCreateFlagBits::eCaptureStatisticsKHR;
+    }
     const vk::raii::PipelineCache *vkPipelineCache{nullptr};
-    if (pipelineCache) {
-        if (pipelineCache->failOnCacheMiss()) {
+    if (cacheEntry) {
+        if (cacheEntry->failOnCacheMiss()) {
             flags |= vk::PipelineCreateFlagBits::eFailOnPipelineCompileRequired;
         }
-        insertAfter(&renderingInfo, pipelineCache->getCacheFeedbackCreateInfo(_type));
-        vkPipelineCache = pipelineCache->get();
+        vkPipelineCache = cacheEntry->get();
+        graphicsPipelineCreateInfo.pNext = cacheEntry->chainBinaryCreateInfo(flags, graphicsPipelineCreateInfo.pNext);
     }
     graphicsPipelineCreateInfo.flags = flags;
 
     _pipeline = vk::raii::Pipeline(ctx.device(), vkPipelineCache, graphicsPipelineCreateInfo);
-    throwOnPipelineCacheMiss(_pipeline, pipelineCache, _debugName);
+    throwOnPipelineCacheMiss(_pipeline, cacheEntry.get(), _creationFeedback, _debugName);
+    storePipelineCacheEntry(cacheEntry.get());
 
     trySetVkRaiiObjectDebugName(ctx, _pipeline, _debugName);
 }
@@ -333,10 +490,11 @@ Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &shaderInfo, co
     : _type{PipelineType::Compute}, _debugName(args.debugName) {
 
     if ((spvCode != nullptr) && (spvSize > 0)) {
+        addShaderToKey(_sourceKey, spvCode, spvSize, shaderInfo);
         _shader = createShaderModuleFromCode(args.ctx, spvCode, spvSize);
         trySetVkRaiiObjectDebugName(args.ctx, _shader, _debugName + " shader");
     } else {
-        _shader = createShaderModule(args.ctx, shaderInfo);
+        _shader = createShaderModule(args.ctx, shaderInfo, _sourceKey);
 
         trySetVkRaiiObjectDebugName(args.ctx, _shader, shaderInfo.debugName);
     }
@@ -347,31 +505,33 @@ Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &shaderInfo, co
 
 // Create DataGraph pipeline directly from SPIR-V module + constants (no VGF)
 Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &shaderInfo, const DataManager &dataManager,
-                   const std::vector<GraphConstantInfo> &constants, bool enableNeuralStatistics,
+                   std::vector<GraphConstantInfo> constants, bool enableNeuralStatistics,
                    vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode)
-    : _type(PipelineType::GraphCompute), _debugName(args.debugName) {
+    : _type(PipelineType::GraphCompute), _debugName(args.debugName),
+      _creation(std::make_unique<DeferredCreation>(args.ctx.device(), args.workerPool)) {
 
     // Descriptor sets and pipeline layout
     createDescriptorSetLayouts(args.ctx, args.bindings);
     _pipelineLayout = createPipelineLayout(args.ctx, _descriptorSetLayouts);
 
     // Setup tensor resource infos (bound resources)
-    std::vector<vk::TensorDescriptionARM> tensorDescriptions;
-    std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> imageLayouts;
-    std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
+    auto &tensorDescriptions = _creation->retain<std::vector<vk::TensorDescriptionARM>>();
+    auto &imageLayouts = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM>>();
+    auto &resourceInfos = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoARM>>();
     makeResourceInfos(args.bindings, dataManager, tensorDescriptions, resourceInfos, imageLayouts);
 
     // Setup graph constant infos
-    std::vector<vk::TensorDescriptionARM> constantTensorDescriptions;
-    constantTensorDescriptions.reserve(constants.size());
-    std::vector<vk::DataGraphPipelineConstantARM> constantInfos;
-    constantInfos.reserve(constants.size());
+    const auto &retainedConstants = _creation->retain(std::move(constants));
+    auto &constantTensorDescriptions = _creation->retain<std::vector<vk::TensorDescriptionARM>>();
+    constantTensorDescriptions.reserve(retainedConstants.size());
+    auto &constantInfos = _creation->retain<std::vector<vk::DataGraphPipelineConstantARM>>();
+    constantInfos.reserve(retainedConstants.size());
 
-    for (const auto &constant : constants) {
+    for (const auto &constant : retainedConstants) {
         constantTensorDescriptions.emplace_back(vk::TensorTilingARM::eLinear, constant.format,
                                                 static_cast<uint32_t>(constant.dims.size()), constant.dims.data(),
                                                 nullptr, vk::TensorUsageFlagBitsARM::eDataGraph);
-        constantInfos.emplace_back(static_cast<uint32_t>(constantInfos.size()), constant.data.data(),
+        constantInfos.emplace_back(static_cast<uint32_t>(constantInfos.size()), constant.data.get(),
                                    &constantTensorDescriptions.back());
     }
     graphComputePipelineCommon(args.ctx, shaderInfo, resourceInfos, constantInfos, args.pipelineCache,
@@ -380,11 +540,11 @@ Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &shaderInfo, co
 
 Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &vertexShaderInfo,
                    const ShaderInfo &fragmentShaderInfo, const std::vector<vk::Format> &colorAttachmentFormats)
-    : _type{PipelineType::Graphics}, _shader{createShaderModule(args.ctx, vertexShaderInfo)},
-      _debugName(args.debugName) {
+    : _type{PipelineType::Graphics}, _debugName(args.debugName) {
+    _shader = createShaderModule(args.ctx, vertexShaderInfo, _sourceKey);
     trySetVkRaiiObjectDebugName(args.ctx, _shader, vertexShaderInfo.debugName);
 
-    _fragmentShader = createShaderModule(args.ctx, fragmentShaderInfo);
+    _fragmentShader = createShaderModule(args.ctx, fragmentShaderInfo, _sourceKey);
     trySetVkRaiiObjectDebugName(args.ctx, _fragmentShader, fragmentShaderInfo.debugName);
 
     createDescriptorSetLayouts(args.ctx, args.bindings);
@@ -394,15 +554,16 @@ Pipeline::Pipeline(const CommonArguments &args, const ShaderInfo &vertexShaderIn
 Pipeline::Pipeline(const CommonArguments &args, const uint32_t segmentIndex, const VgfView &vgfView,
                    const DataManager &dataManager, bool enableNeuralStatistics,
                    vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode)
-    : _type{PipelineType::GraphCompute}, _debugName(args.debugName) {
+    : _type{PipelineType::GraphCompute}, _debugName(args.debugName),
+      _creation(std::make_unique<DeferredCreation>(args.ctx.device(), args.workerPool)) {
 
     createDescriptorSetLayouts(args.ctx, args.bindings);
     _pipelineLayout = createPipelineLayout(args.ctx, _descriptorSetLayouts);
 
     // Setup tensor resource info
-    std::vector<vk::TensorDescriptionARM> tensorDescriptions;
-    std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> imageLayouts;
-    std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
+    auto &tensorDescriptions = _creation->retain<std::vector<vk::TensorDescriptionARM>>();
+    auto &imageLayouts = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM>>();
+    auto &resourceInfos = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoARM>>();
     makeResourceInfos(args.bindings, dataManager, tensorDescriptions, resourceInfos, imageLayouts);
 
     graphComputePipelineCommon(args.ctx, segmentIndex, vgfView, args.pipelineCache, resourceInfos,
@@ -414,7 +575,8 @@ Pipeline::Pipeline(const CommonArguments &args, const DataManager &dataManager,
                    const std::optional<TypedBinding> &inputHintMV, const std::optional<TypedBinding> &outputCost,
                    vk::DataGraphOpticalFlowPerformanceLevelARM performanceLevel,
                    vk::DataGraphOpticalFlowGridSizeFlagsARM gridSize, uint32_t inputWidth, uint32_t inputHeight)
-    : _type{PipelineType::GraphCompute}, _debugName(args.debugName), _opticalFlowSession(true) {
+    : _type{PipelineType::GraphCompute}, _debugName(args.debugName), _opticalFlowSession(true),
+      _creation(std::make_unique<DeferredCreation>(args.ctx.device(), args.workerPool)) {
 
     // Create descriptor set layouts from bindings
     std::vector<TypedBinding> bindings;
@@ -437,13 +599,13 @@ Pipeline::Pipeline(const CommonArguments &args, const DataManager &dataManager,
 
     // We expect all bindings to be images (sampled or storage)
     vk::DataGraphOpticalFlowCreateFlagsARM flags{};
-    std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
+    auto &resourceInfos = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoARM>>();
     resourceInfos.reserve(bindings.size());
 
-    std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> resourceImageInfos;
+    auto &resourceImageInfos = _creation->retain<std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM>>();
     resourceImageInfos.reserve(bindings.size());
 
-    std::vector<vk::DataGraphPipelineSingleNodeConnectionARM> connections;
+    auto &connections = _creation->retain<std::vector<vk::DataGraphPipelineSingleNodeConnectionARM>>();
     connections.reserve(bindings.size());
 
     auto addConnection = [&](const TypedBinding &binding, vk::DataGraphPipelineNodeConnectionTypeARM connection) {
@@ -484,12 +646,12 @@ Pipeline::Pipeline(const CommonArguments &args, const DataManager &dataManager,
         costFormat = dataManager.getImage(std::get<ImageId>(outputCost.value().resource)).dataType();
     }
 
-    vk::DataGraphPipelineSingleNodeCreateInfoARM singleNodeInfo{};
+    auto &singleNodeInfo = _creation->retain<vk::DataGraphPipelineSingleNodeCreateInfoARM>();
     singleNodeInfo.setNodeType(vk::DataGraphPipelineNodeTypeARM::eOpticalFlow);
     singleNodeInfo.setConnectionCount(static_cast<uint32_t>(connections.size()));
     singleNodeInfo.setPConnections(connections.data());
 
-    vk::DataGraphPipelineOpticalFlowCreateInfoARM opticalFlowCreateInfo{};
+    auto &opticalFlowCreateInfo = _creation->retain<vk::DataGraphPipelineOpticalFlowCreateInfoARM>();
     opticalFlowCreateInfo.setWidth(inputWidth);
     opticalFlowCreateInfo.setHeight(inputHeight);
     opticalFlowCreateInfo.setImageFormat(inputFormat);
@@ -501,31 +663,35 @@ Pipeline::Pipeline(const CommonArguments &args, const DataManager &dataManager,
     opticalFlowCreateInfo.setFlags(flags);
     singleNodeInfo.setPNext(&opticalFlowCreateInfo);
 
-    const vk::raii::DeferredOperationKHR deferredOperation(nullptr);
+    insertAfter(&opticalFlowCreateInfo, _creation->feedback.getCreateInfo(_type));
 
-    vk::PipelineCreateFlags2KHR flags2{};
-    const vk::raii::PipelineCache *vkPipelineCache{nullptr};
+    auto &cacheEntry = _creation->cacheEntry;
     if (args.pipelineCache) {
-        if (args.pipelineCache->failOnCacheMiss()) {
-            flags2 |= vk::PipelineCreateFlagBits2KHR::eFailOnPipelineCompileRequired;
+        _creation->pipelineCache = args.pipelineCache;
+        auto key = args.pipelineCache->makeKey(_type);
+        key.add(_sourceKey.value()).add(static_cast<uint64_t>(connections.size()));
+        for (const auto &connection : connections) {
+            key.add(connection.set).add(connection.binding).add(connection.connection);
         }
-        insertAfter(&opticalFlowCreateInfo, args.pipelineCache->getCacheFeedbackCreateInfo(_type));
-        vkPipelineCache = args.pipelineCache->get();
+        addResourceInfosToKey(key, resourceInfos);
+        key.add(inputWidth).add(inputHeight).add(inputFormat).add(flowFormat).add(costFormat);
+        key.add(static_cast<uint32_t>(gridSize)).add(performanceLevel).add(static_cast<uint32_t>(flags));
+        cacheEntry = args.pipelineCache->lookup(key, _debugName, false);
     }
 
-    vk::DataGraphPipelineCreateInfoARM pipelineCreateInfo{};
+    vk::PipelineCreateFlags2KHR flags2{};
+    if (cacheEntry && cacheEntry->failOnCacheMiss()) {
+        flags2 |= vk::PipelineCreateFlagBits2KHR::eFailOnPipelineCompileRequired;
+    }
+
+    auto &pipelineCreateInfo = _creation->retain<vk::DataGraphPipelineCreateInfoARM>();
     pipelineCreateInfo.setFlags(flags2);
     pipelineCreateInfo.setLayout(*_pipelineLayout);
     pipelineCreateInfo.setResourceInfoCount(static_cast<uint32_t>(resourceInfos.size()));
     pipelineCreateInfo.setPResourceInfos(resourceInfos.data());
     pipelineCreateInfo.setPNext(&singleNodeInfo);
 
-    _pipeline = vk::raii::Pipeline(args.ctx.device(), deferredOperation, vkPipelineCache, pipelineCreateInfo);
-    throwOnPipelineCacheMiss(_pipeline, args.pipelineCache, _debugName);
-
-    trySetVkRaiiObjectDebugName(args.ctx, _pipeline, _debugName);
-
-    initSession(args.ctx);
+    createDataGraphPipeline(args.ctx, pipelineCreateInfo);
 }
 
 void Pipeline::graphComputePipelineCommon(const Context &ctx, const ShaderInfo &shaderInfo,
@@ -536,6 +702,7 @@ void Pipeline::graphComputePipelineCommon(const Context &ctx, const ShaderInfo &
                                           vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
     // Compile/load SPIR-V code
     const auto spv = readShaderCode(shaderInfo);
+    addShaderToKey(_sourceKey, spv.data(), spv.size(), shaderInfo);
     _shader = createShaderModuleFromCode(ctx, spv.data(), spv.size());
     trySetVkRaiiObjectDebugName(ctx, _shader, _debugName + " shader");
 
@@ -550,13 +717,14 @@ void Pipeline::graphComputePipelineCommon(const Context &ctx, uint32_t segmentIn
                                           vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
     // Setup constant resource info
     const auto &constantBindings = vgfView.getSegmentConstantBindings(segmentIndex);
-    std::vector<vk::TensorDescriptionARM> constantTensorDescriptions;
+    auto &constantTensorDescriptions = _creation->retain<std::vector<vk::TensorDescriptionARM>>();
     constantTensorDescriptions.reserve(constantBindings.size());
 
-    std::vector<vk::DataGraphPipelineConstantARM> constantInfos;
+    auto &constantInfos = _creation->retain<std::vector<vk::DataGraphPipelineConstantARM>>();
     constantInfos.reserve(constantBindings.size());
 
-    std::vector<vk::DataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM> sparsityInfos;
+    auto &sparsityInfos =
+        _creation->retain<std::vector<vk::DataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM>>();
     sparsityInfos.reserve(constantBindings.size());
 
     for (const auto &[graphConstantId, constantIndex] : constantBindings) {
@@ -591,13 +759,16 @@ void Pipeline::graphComputePipelineCommon(const Context &ctx, uint32_t segmentIn
     trySetVkRaiiObjectDebugName(ctx, _shader, _debugName + " shader");
 
     auto entryPoint = vgfView.getModuleEntryPoint(segmentIndex);
+    _sourceKey.add(static_cast<uint64_t>(spv.size())).add(spv.begin(), spv.size() * sizeof(uint32_t));
 
     buildDataGraphPipeline(ctx, entryPoint, resourceInfos, constantInfos, pipelineCache, enableNeuralStatistics,
                            neuralStatisticsMode);
 }
 
-void Pipeline::initSession(const Context &ctx, bool enableNeuralStatistics,
-                           vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
+void Pipeline::createSession(const Context &ctx) {
+    const bool firstSession = _sessions.empty();
+    auto &session = _sessions.emplace_back();
+
     // Create session for the pipeline
     vk::DataGraphPipelineSessionCreateFlagsARM sessionFlags{};
     if (_opticalFlowSession) {
@@ -605,15 +776,15 @@ void Pipeline::initSession(const Context &ctx, bool enableNeuralStatistics,
     }
     vk::DataGraphPipelineSessionCreateInfoARM sessionCreateInfo{sessionFlags, *_pipeline};
 
-    vk::DataGraphPipelineSessionNeuralStatisticsCreateInfoARM sessionNeuralStatsCreateInfo(neuralStatisticsMode);
-    if (enableNeuralStatistics) {
+    vk::DataGraphPipelineSessionNeuralStatisticsCreateInfoARM sessionNeuralStatsCreateInfo(_neuralStatisticsMode);
+    if (_enableNeuralStatistics) {
         insertAfter(&sessionCreateInfo, &sessionNeuralStatsCreateInfo);
     }
 
-    _session = vk::raii::DataGraphPipelineSessionARM{ctx.device(), sessionCreateInfo};
+    session.session = vk::raii::DataGraphPipelineSessionARM{ctx.device(), sessionCreateInfo};
 
     // Get memory requirements
-    vk::DataGraphPipelineSessionBindPointRequirementsInfoARM bindpointRequirementsInfo(*_session);
+    vk::DataGraphPipelineSessionBindPointRequirementsInfoARM bindpointRequirementsInfo(*session.session);
     auto bindPointReqs = ctx.device().getDataGraphPipelineSessionBindPointRequirementsARM(bindpointRequirementsInfo);
 
     std::vector<vk::BindDataGraphPipelineSessionMemoryInfoARM> bindInfos;
@@ -622,24 +793,36 @@ void Pipeline::initSession(const Context &ctx, bool enableNeuralStatistics,
             continue;
         }
 
-        vk::DataGraphPipelineSessionMemoryRequirementsInfoARM memoryRequirementsInfo(*_session, bindPointReq.bindPoint);
+        vk::DataGraphPipelineSessionMemoryRequirementsInfoARM memoryRequirementsInfo(*session.session,
+                                                                                     bindPointReq.bindPoint);
         VkMemoryRequirements2 memoryReqs =
             ctx.device().getDataGraphPipelineSessionMemoryRequirementsARM(memoryRequirementsInfo);
 
         _dataGraphPipelineMemoryRequirement = memoryReqs.memoryRequirements.size;
 
-        mlsdk::logging::info("Datagraph pipeline session memory requirement: " +
-                             std::to_string(_dataGraphPipelineMemoryRequirement));
-
-        //  Allocate memory for the session
-        if (memoryReqs.memoryRequirements.size > 0) {
+        MLSDK_LOG_INFO("Datagraph pipeline session memory requirement: " +
+                       std::to_string(_dataGraphPipelineMemoryRequirement));
+
+        // Transient memory does not outlive a dispatch, so serialized sessions can alias it
+        const bool aliasMemory = ctx.sessionMemoryAliasingEnabled() && !_opticalFlowSession &&
+                                 bindPointReq.bindPoint == vk::DataGraphPipelineSessionBindPointARM::eTransient;
+        if (aliasMemory && memoryReqs.memoryRequirements.size > 0) {
+            auto &requirements = session.aliasedRequirements;
+            const auto alignment = memoryReqs.memoryRequirements.alignment;
+            const auto offset = (requirements.size + alignment - 1) / alignment * alignment;
+            session.aliasedBindPoints.push_back({bindPointReq.bindPoint, offset});
+            requirements.size = offset + memoryReqs.memoryRequirements.size;
+            requirements.alignment = std::max(requirements.alignment, alignment);
+            requirements.memoryTypeBits &= memoryReqs.memoryRequirements.memoryTypeBits;
+        } else if (memoryReqs.memoryRequirements.size > 0) {
+            //  Allocate memory for the session
             const bool isNeuralStatisticsBindPoint =
                 bindPointReq.bindPoint == vk::DataGraphPipelineSessionBindPointARM::eNeuralAcceleratorStatistics;
             vk::MemoryPropertyFlags memoryFlags;
             if (ctx.sessionMemoryDumpEnabled()) {
                 mlsdk::logging::warning("Enabling session memory dumping is known to cause issues on certain GPUs.");
                 memoryFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-            } else if (enableNeuralStatistics && isNeuralStatisticsBindPoint) {
+            } else if (_enableNeuralStatistics && isNeuralStatisticsBindPoint) {
                 memoryFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
             } else {
                 memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
@@ -647,20 +830,21 @@ void Pipeline::initSession(const Context &ctx, bool enableNeuralStatistics,
             auto memoryTypeIdx = findMemoryIdx(ctx, memoryReqs.memoryRequirements.memoryTypeBits, memoryFlags);
 
             vk::MemoryAllocateInfo allocateInfo(memoryReqs.memoryRequirements.size, memoryTypeIdx);
-            _sessionMemory.emplace_back(vk::raii::DeviceMemory(ctx.device(), allocateInfo));
-            _sessionMemoryDataSizes.push_back(memoryReqs.memoryRequirements.size);
+            session.memory.emplace_back(vk::raii::DeviceMemory(ctx.device(), allocateInfo));
+            session.memoryDataSizes.push_back(memoryReqs.memoryRequirements.size);
 
-            if (isNeuralStatisticsBindPoint) {
+            // Every session has the same bind points, so the ones of the first session describe them all
+            if (isNeuralStatisticsBindPoint && firstSession) {
                 if (_neuralStatisticsMemoryInfo.has_value()) {
                     throw std::runtime_error("More than one bind point for Neural Statistics");
                 }
-                _neuralStatisticsMemoryInfo = {static_cast<uint32_t>(_sessionMemory.size() - 1),
+                _neuralStatisticsMemoryInfo = {static_cast<uint32_t>(session.memory.size() - 1),
                                                memoryReqs.memoryRequirements.size};
             }
 
             // Bind memory to session
             uint32_t resourceIndex = 0;
-            bindInfos.emplace_back(*_session, bindPointReq.bindPoint, resourceIndex, *_sessionMemory.back());
+            bindInfos.emplace_back(*session.session, bindPointReq.bindPoint, resourceIndex, *session.memory.back());
         }
     }
 
@@ -674,34 +858,135 @@ void Pipeline::buildDataGraphPipeline(const Context &ctx, const std::string &ent
                                       const std::vector<vk::DataGraphPipelineConstantARM> &constantInfos,
                                       const std::shared_ptr<PipelineCache> &pipelineCache, bool enableNeuralStatistics,
                                       vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
-    vk::DataGraphPipelineShaderModuleCreateInfoARM shaderModuleInfo(
-        *_shader, entry.c_str(), nullptr, static_cast<uint32_t>(constantInfos.size()), constantInfos.data(), nullptr);
-
-    vk::DataGraphPipelineNeuralStatisticsCreateInfoARM neuralStatsCreateInfo(enableNeuralStatistics);
+    auto &creation = *_creation;
+    const auto &entryName = creation.retain(entry);
+    auto &shaderModuleInfo = creation.retain(vk::DataGraphPipelineShaderModuleCreateInfoARM(
+        *_shader, entryName.c_str(), nullptr, static_cast<uint32_t>(constantInfos.size()), constantInfos.data(),
+        nullptr));
+
+    auto &neuralStatsCreateInfo =
+        creation.retain(vk::DataGraphPipelineNeuralStatisticsCreateInfoARM(enableNeuralStatistics));
     if (enableNeuralStatistics) {
         insertAfter(&shaderModuleInfo, &neuralStatsCreateInfo);
     }
+    _enableNeuralStatistics = enableNeuralStatistics;
+    _neuralStatisticsMode = neuralStatisticsMode;
 
-    const vk::raii::DeferredOperationKHR deferredOperation(nullptr);
+    insertAfter(&shaderModuleInfo, creation.feedback.getCreateInfo(_type));
 
-    vk::PipelineCreateFlags2KHR flags{};
-    const vk::raii::PipelineCache *vkPipelineCache{nullptr};
+    auto &cacheEntry = creation.cacheEntry;
     if (pipelineCache) {
-        if (pipelineCache->failOnCacheMiss()) {
-            flags |= vk::PipelineCreateFlagBits2KHR::eFailOnPipelineCompileRequired;
-        }
-        insertAfter(&shaderModuleInfo, pipelineCache->getCacheFeedbackCreateInfo(_type));
-        vkPipelineCache = pipelineCache->get();
+        creation.pipelineCache = pipelineCache;
+        auto key = pipelineCache->makeKey(_type);
+        key.add(_sourceKey.value()).add(entry).add(enableNeuralStatistics);
+        addResourceInfosToKey(key, resourceInfos);
+        addConstantInfosToKey(key, constantInfos);
+        cacheEntry = pipelineCache->lookup(key, _debugName, false);
     }
 
-    const vk::DataGraphPipelineCreateInfoARM pipelineCreateInfo(
-        flags, *_pipelineLayout, static_cast<uint32_t>(resourceInfos.size()), resourceInfos.data(), &shaderModuleInfo);
-    _pipeline = vk::raii::Pipeline(ctx.device(), deferredOperation, vkPipelineCache, pipelineCreateInfo);
-    throwOnPipelineCacheMiss(_pipeline, pipelineCache, _debugName);
+    vk::PipelineCreateFlags2KHR flags{};
+    if (cacheEntry && cacheEntry->failOnCacheMiss()) {
+        flags |= vk::PipelineCreateFlagBits2KHR::eFailOnPipelineCompileRequired;
+    }
+
+    const auto &pipelineCreateInfo = creation.retain(vk::DataGraphPipelineCreateInfoARM(
+        flags, *_pipelineLayout, static_cast<uint32_t>(resourceInfos.size()), resourceInfos.data(), &shaderModuleInfo));
+    createDataGraphPipeline(ctx, pipelineCreateInfo);
+}
+
+void Pipeline::createDataGraphPipeline(const Context &ctx, const vk::DataGraphPipelineCreateInfoARM &createInfo) {
+    auto &creation = *_creation;
+    const auto &device = ctx.device();
+    if (ctx._optionals.deferred_operation) {
+        creation.operation = vk::raii::DeferredOperationKHR(device);
+    }
+    const auto *vkPipelineCache = creation.cacheEntry ? creation.cacheEntry->get() : nullptr;
+
+    // Created through the dispatcher so that the driver writes the pipeline to memory that outlives this call
+    creation.result = static_cast<vk::Result>(device.getDispatcher()->vkCreateDataGraphPipelinesARM(
+        static_cast<VkDevice>(*device), static_cast<VkDeferredOperationKHR>(*creation.operation),
+        vkPipelineCache ? static_cast<VkPipelineCache>(**vkPipelineCache) : VK_NULL_HANDLE, 1,
+        reinterpret_cast<const VkDataGraphPipelineCreateInfoARM *>(&createInfo), nullptr, &creation.pipeline));
+    if (creation.result != vk::Result::eOperationDeferredKHR) {
+        finishDataGraphPipeline(ctx);
+        return;
+    }
+
+    const auto workerCount =
+        std::min<size_t>(creation.operation.getMaxConcurrency(), creation.workerPool.threadCount());
+    const auto &operation = creation.operation;
+    for (size_t workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+        creation.workers.push_back(
+            creation.workerPool.submit([&operation] { return joinDeferredOperation(operation); }));
+    }
+    MLSDK_LOG_DEBUG("Pipeline " + _debugName + " compiling on " + std::to_string(workerCount) + " threads");
+}
+
+void Pipeline::waitForCreation(const Context &ctx) {
+    if (!_creation) {
+        return;
+    }
+    for (auto &worker : _creation->workers) {
+        worker.get();
+    }
+    _creation->workers.clear();
+    _creation->result = _creation->operation.getResult();
+    finishDataGraphPipeline(ctx);
+}
+
+void Pipeline::finishDataGraphPipeline(const Context &ctx) {
+    // Released on return, whether or not the creation succeeded
+    const auto creation = std::move(_creation);
+    const auto result =
+        creation->result == vk::Result::eOperationNotDeferredKHR ? vk::Result::eSuccess : creation->result;
+
+    _creationFeedback = creation->feedback;
+    _pipeline = vk::raii::Pipeline(ctx.device(), std::exchange(creation->pipeline, VK_NULL_HANDLE), nullptr, result);
+    if (static_cast<int32_t>(result) < 0) {
+        throw std::runtime_error("Failed to create pipeline " + _debugName + ": " + vk::to_string(result));
+    }
+    throwOnPipelineCacheMiss(_pipeline, creation->cacheEntry.get(), _creationFeedback, _debugName);
+    storePipelineCacheEntry(creation->cacheEntry.get());
 
     trySetVkRaiiObjectDebugName(ctx, _pipeline, _debugName);
 
-    initSession(ctx, enableNeuralStatistics, neuralStatisticsMode);
+    for (size_t sessionIdx = 0; sessionIdx < creation->sessionCount; ++sessionIdx) {
+        createSession(ctx);
+    }
+}
+
+void Pipeline::releaseShaderModules() {
+    if (_creation) {
+        throw std::runtime_error("Cannot release the shader modules of pipeline " + _debugName +
+                                 " while it is being created");
+    }
+    _shader = nullptr;
+    _fragmentShader = nullptr;
+}
+
+bool Pipeline::hasUnboundAliasedSessionMemory(size_t sessionIdx) const {
+    return !_sessions[sessionIdx].aliasedBindPoints.empty();
+}
+
+void Pipeline::bindAliasedSessionMemory(const Context &ctx, size_t sessionIdx, const vk::raii::DeviceMemory &memory) {
+    auto &session = _sessions[sessionIdx];
+    std::vector<vk::BindDataGraphPipelineSessionMemoryInfoARM> bindInfos;
+    for (const auto &aliased : session.aliasedBindPoints) {
+        uint32_t resourceIndex = 0;
+        bindInfos.emplace_back(*session.session, aliased.bindPoint, resourceIndex, *memory, aliased.offset);
+    }
+    if (!bindInfos.empty()) {
+        ctx.device().bindDataGraphPipelineSessionMemoryARM(bindInfos);
+    }
+    session.aliasedBindPoints.clear();
+}
+
+size_t Pipeline::addSession(const Context &ctx) {
+    if (_creation) {
+        return _creation->sessionCount++;
+    }
+    createSession(ctx);
+    return _sessions.size() - 1;
 }
 
 bool Pipeline::hasGraphPipelineProperty(const vk::raii::Device &device,
@@ -717,4 +1002,138 @@ bool Pipeline::hasGraphPipelineProperty(const vk::raii::Device &device,
 
 const std::string &Pipeline::debugName() const { return _debugName; }
 
+bool VgfSegmentKey::Resource::operator==(const Resource &other) const {
+    return std::tie(set, binding, descriptorType, tiling, format, dimensions, strides, imageLayout) ==
+           std::tie(other.set, other.binding, other.descriptorType, other.tiling, other.format, other.dimensions,
+                    other.strides, other.imageLayout);
+}
+
+bool VgfSegmentKey::operator==(const VgfSegmentKey &other) const {
+    return std::tie(vgfView, segmentIndex, enableNeuralStatistics, neuralStatisticsMode, resources) ==
+           std::tie(other.vgfView, other.segmentIndex, other.enableNeuralStatistics, other.neuralStatisticsMode,
+                    other.resources);
+}
+
+uint64_t VgfSegmentKey::hash() const {
+    PipelineKey key;
+    key.add(reinterpret_cast<uintptr_t>(vgfView)).add(segmentIndex);
+    key.add(static_cast<uint32_t>(enableNeuralStatistics)).add(static_cast<uint32_t>(neuralStatisticsMode));
+    key.add(static_cast<uint64_t>(resources.size()));
+    for (const auto &resource : resources) {
+        key.add(resource.set).add(resource.binding).add(resource.descriptorType).add(resource.tiling);
+        key.add(resource.format).add(resource.dimensions).add(resource.strides);
+        key.add(resource.imageLayout.has_value()).add(resource.imageLayout.value_or(vk::ImageLayout::eUndefined));
+    }
+    return key.value();
+}
+
+VgfSegmentKey Pipeline::segmentKey(const VgfView &vgfView, uint32_t segmentIndex,
+                                   const std::vector<TypedBinding> &bindings, const DataManager &dataManager,
+                                   bool enableNeuralStatistics,
+                                   vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode) {
+    // Statistics are enabled when the pipeline is created, so pipelines collecting them cannot be shared otherwise
+    VgfSegmentKey key{&vgfView, segmentIndex, enableNeuralStatistics, neuralStatisticsMode, {}};
+    std::vector<vk::TensorDescriptionARM> tensorDescriptions;
+    std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> imageLayouts;
+    std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
+    makeResourceInfos(bindings, dataManager, tensorDescriptions, resourceInfos, imageLayouts);
+
+    // Every binding has a resource info, chaining either a tensor description or an image layout and its description
+    key.resources.reserve(bindings.size());
+    for (size_t idx = 0; idx < bindings.size(); ++idx) {
+        auto &resource = key.resources.emplace_back();
+        resource.set = static_cast<uint32_t>(bindings[idx].set);
+        resource.binding = static_cast<uint32_t>(bindings[idx].id);
+        resource.descriptorType = bindings[idx].vkDescriptorType;
+        const void *next = resourceInfos[idx].pNext;
+        if (static_cast<const vk::BaseInStructure *>(next)->sType ==
+            vk::StructureType::eDataGraphPipelineResourceInfoImageLayoutARM) {
+            const auto &imageLayout = *static_cast<const vk::DataGraphPipelineResourceInfoImageLayoutARM *>(next);
+            resource.imageLayout = imageLayout.layout;
+            next = imageLayout.pNext;
+        }
+        const auto &description = *static_cast<const vk::TensorDescriptionARM *>(next);
+        resource.tiling = description.tiling;
+        resource.format = description.format;
+        resource.dimensions.assign(description.pDimensions, description.pDimensions + description.dimensionCount);
+        if (description.pStrides != nullptr) {
+            resource.strides.assign(description.pStrides, description.pStrides + description.dimensionCount);
+        }
+    }
+    return key;
+}
+
+void Pipeline::storePipelineCacheEntry(PipelineCacheEntry *cacheEntry) {
+    if (cacheEntry == nullptr) {
+        return;
+    }
+    _createdFromBinaries = cacheEntry->createdFromBinaries();
+    cacheEntry->store(_pipeline);
+}
+
+PipelineReport Pipeline::getReport(const Context &ctx) const {
+    PipelineReport report;
+    report.name = _debugName;
+    switch (_type) {
+    case PipelineType::Compute:
+        report.type = "Compute";
+        break;
+    case PipelineType::Graphics:
+        report.type = "Graphics";
+        break;
+    case PipelineType::GraphCompute:
+        report.type = "DataGraph";
+        break;
+    case PipelineType::Unknown:
+        report.type = "Unknown";
+        break;
+    }
+
+    const auto &feedback = _creationFeedback.pipeline();
+    report.feedbackValid = static_cast<bool>(feedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid);
+    report.cacheHit = _createdFromBinaries || _creationFeedback.wasPipelineCacheHit();
+    report.creationDurationNs = feedback.duration;
+    for (const auto &stageFeedback : _creationFeedback.stages()) {
+        report.stageCreationDurationsNs.push_back(stageFeedback.duration);
+    }
+
+    // Data graph pipelines are not described by pipeline executables
+    if (!ctx._optionals.pipeline_executable_properties || isDataGraphPipeline()) {
+        return report;
+    }
+
+    const auto executables = ctx.device().getPipelineExecutablePropertiesKHR(vk::PipelineInfoKHR(*_pipeline));
+    for (uint32_t index = 0; index < static_cast<uint32_t>(executables.size()); ++index) {
+        const auto &properties = executables[index];
+        auto &executable = report.executables.emplace_back();
+        executable.name = properties.name.data();
+        executable.description = properties.description.data();
+        executable.stages = vk::to_string(properties.stages);
+        executable.subgroupSize = properties.subgroupSize;
+
+        const auto statistics =
+            ctx.device().getPipelineExecutableStatisticsKHR(vk::PipelineExecutableInfoKHR(*_pipeline, index));
+        for (const auto &statistic : statistics) {
+            auto &entry = executable.statistics.emplace_back();
+            entry.name = statistic.name.data();
+            entry.description = statistic.description.data();
+            switch (statistic.format) {
+            case vk::PipelineExecutableStatisticFormatKHR::eBool32:
+                entry.value = statistic.value.b32 == VK_TRUE;
+                break;
+            case vk::PipelineExecutableStatisticFormatKHR::eInt64:
+                entry.value = statistic.value.i64;
+                break;
+            case vk::PipelineExecutableStatisticFormatKHR::eUint64:
+                entry.value = statistic.value.u64;
+                break;
+            case vk::PipelineExecutableStatisticFormatKHR::eFloat64:
+                entry.value = statistic.value.f64;
+                break;
+            }
+        }
+    }
+    return report;
+}
+
 } // namespace mlsdk::scenariorunner
@@ -6,9 +6,13 @@
 
 #include "context.hpp"
 #include "data_manager.hpp"
+#include "json_writer.hpp"
 #include "pipeline_cache.hpp"
 #include "types.hpp"
+#include "worker_pool.hpp"
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -20,6 +24,38 @@ struct NeuralStatisticsMemoryInfo {
     vk::DeviceSize size;
 };
 
+/// \brief State the data graph pipeline of a VGF segment is created from
+///
+/// The pipelines of two dispatches with equal keys are interchangeable, so the dispatches can share one.
+struct VgfSegmentKey {
+    /// \brief Binding of a resource and the tensor description it is passed to the pipeline with
+    struct Resource {
+        uint32_t set{0};
+        uint32_t binding{0};
+        vk::DescriptorType descriptorType{};
+        vk::TensorTilingARM tiling{};
+        vk::Format format{};
+        std::vector<int64_t> dimensions;
+        std::vector<int64_t> strides;
+        /// Layout of images, which tensors do not have
+        std::optional<vk::ImageLayout> imageLayout;
+
+        bool operator==(const Resource &other) const;
+        bool operator!=(const Resource &other) const { return !(*this == other); }
+    };
+
+    const VgfView *vgfView{nullptr};
+    uint32_t segmentIndex{0};
+    bool enableNeuralStatistics{false};
+    vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode{};
+    std::vector<Resource> resources;
+
+    bool operator==(const VgfSegmentKey &other) const;
+    bool operator!=(const VgfSegmentKey &other) const { return !(*this == other); }
+
+    uint64_t hash() const;
+};
+
 class Pipeline {
   public:
     struct CommonArguments {
@@ -27,6 +63,8 @@ class Pipeline {
         const std::string &debugName;
         const std::vector<TypedBinding> &bindings;
         std::shared_ptr<PipelineCache> pipelineCache;
+        /// Threads that help with deferred data graph pipeline creations
+        WorkerPool &workerPool;
     };
 
     /// \brief Constructor
@@ -42,7 +80,7 @@ class Pipeline {
 
     // Create DataGraph pipeline directly from SPIR-V module + constants (no VGF)
     Pipeline(const CommonArguments &args, const ShaderInfo &shaderInfo, const DataManager &dataManager,
-             const std::vector<GraphConstantInfo> &constants, bool enableNeuralStatistics,
+             std::vector<GraphConstantInfo> constants, bool enableNeuralStatistics,
              vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode);
 
     Pipeline(const CommonArguments &args, const ShaderInfo &vertexShaderInfo, const ShaderInfo &fragmentShaderInfo,
@@ -63,6 +101,20 @@ class Pipeline {
              vk::DataGraphOpticalFlowPerformanceLevelARM performanceLevel,
              vk::DataGraphOpticalFlowGridSizeFlagsARM gridSize, uint32_t inputWidth, uint32_t inputHeight);
 
+    Pipeline(Pipeline &&other);
+    Pipeline &operator=(Pipeline &&other);
+    ~Pipeline();
+
+    /// \brief Wait for the creation of a data graph pipeline that is still being compiled, then create its session
+    ///
+    /// Data graph pipelines are compiled by worker threads when the device supports deferred host operations. The
+    /// pipeline, its session and its report are only available once this has returned. Does nothing for pipelines
+    /// that are complete.
+    void waitForCreation(const Context &ctx);
+
+    /// \brief Destroy the shader modules, which are only read while the pipeline is created
+    void releaseShaderModules();
+
     /// \brief Vulkan® pipeline accessor
     /// \return The underlying Vulkan® pipeline of the object
     const vk::Pipeline &pipeline() const { return *_pipeline; }
@@ -71,11 +123,43 @@ class Pipeline {
 
     const vk::DescriptorSetLayout &descriptorSetLayout(uint32_t setIdx) const { return *_descriptorSetLayouts[setIdx]; }
 
-    const vk::DataGraphPipelineSessionARM &session() const { return *_session; }
+    const vk::DataGraphPipelineSessionARM &session(size_t sessionIdx = 0) const {
+        return *_sessions[sessionIdx].session;
+    }
 
-    const std::vector<vk::raii::DeviceMemory> &sessionMemory() const { return _sessionMemory; }
+    const std::vector<vk::raii::DeviceMemory> &sessionMemory(size_t sessionIdx = 0) const {
+        return _sessions[sessionIdx].memory;
+    }
+
+    const std::vector<vk::DeviceSize> &sessionMemoryDataSizes(size_t sessionIdx = 0) const {
+        return _sessions[sessionIdx].memoryDataSizes;
+    }
+
+    /// \brief Number of sessions of a data graph pipeline, zero for other pipelines
+    size_t sessionCount() const { return _sessions.size(); }
+
+    /// \brief Requirements of the shared session memory bound to the transient bind points of a session
+    ///
+    /// Only sessions created while session memory aliasing is enabled have such bind points. They are laid out one
+    /// after the other from offset 0, so the size is zero when the session has none.
+    const vk::MemoryRequirements &aliasedSessionMemoryRequirements(size_t sessionIdx) const {
+        return _sessions[sessionIdx].aliasedRequirements;
+    }
 
-    const std::vector<vk::DeviceSize> &sessionMemoryDataSizes() const { return _sessionMemoryDataSizes; }
+    /// \brief Whether a session has transient bind points still waiting for bindAliasedSessionMemory
+    bool hasUnboundAliasedSessionMemory(size_t sessionIdx) const;
+
+    /// \brief Bind the transient bind points of a session to @p memory, which other sessions share
+    ///
+    /// \param ctx        Context the pipeline was created with
+    /// \param sessionIdx Index of the session
+    /// \param memory     Memory that satisfies aliasedSessionMemoryRequirements
+    void bindAliasedSessionMemory(const Context &ctx, size_t sessionIdx, const vk::raii::DeviceMemory &memory);
+
+    /// \brief Add a session with memory of its own, for dispatches that may execute concurrently with the others
+    ///
+    /// \return Index of the new session
+    size_t addSession(const Context &ctx);
 
     uint64_t getDataGraphPipelineMemoryRequirement() const { return _dataGraphPipelineMemoryRequirement; }
 
@@ -93,18 +177,41 @@ class Pipeline {
 
     const std::string &debugName() const;
 
+    /// \brief Neural statistics bind point of the first session
     const std::optional<NeuralStatisticsMemoryInfo> &neuralStatisticsMemoryInfo() const {
         return _neuralStatisticsMemoryInfo;
     }
 
+    /// \brief Creation feedback of the pipeline, plus its executable statistics when the device captured them
+    PipelineReport getReport(const Context &ctx) const;
+
+    /// \brief Key of the data graph pipeline of VGF segment @p segmentIndex bound to @p bindings
+    static VgfSegmentKey segmentKey(const VgfView &vgfView, uint32_t segmentIndex,
+                                    const std::vector<TypedBinding> &bindings, const DataManager &dataManager,
+                                    bool enableNeuralStatistics,
+                                    vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode);
+
   private:
+    struct AliasedBindPoint {
+        vk::DataGraphPipelineSessionBindPointARM bindPoint;
+        vk::DeviceSize offset;
+    };
+
+    struct Session {
+        vk::raii::DataGraphPipelineSessionARM session{nullptr};
+        std::vector<vk::raii::DeviceMemory> memory;
+        std::vector<vk::DeviceSize> memoryDataSizes;
+        /// Transient bind points left for the shared session memory, cleared once they are bound
+        std::vector<AliasedBindPoint> aliasedBindPoints;
+        vk::MemoryRequirements aliasedRequirements{0, 1, ~0U};
+    };
+
     PipelineType _type{PipelineType::Unknown};
     std::vector<vk::raii::DescriptorSetLayout> _descriptorSetLayouts;
     vk::raii::PipelineLayout _pipelineLayout{nullptr};
     vk::raii::Pipeline _pipeline{nullptr};
-    vk::raii::DataGraphPipelineSessionARM _session{nullptr};
-    std::vector<vk::raii::DeviceMemory> _sessionMemory;
-    std::vector<vk::DeviceSize> _sessionMemoryDataSizes;
+    PipelineCreationFeedback _creationFeedback;
+    std::vector<Session> _sessions;
     vk::raii::ShaderModule _shader{nullptr};
     vk::raii::ShaderModule _fragmentShader{nullptr};
     std::string _debugName;
@@ -112,9 +219,26 @@ class Pipeline {
     uint64_t _dataGraphPipelineMemoryRequirement{};
     vk::ShaderStageFlags _pushConstantStages;
     bool _opticalFlowSession{false};
+    bool _enableNeuralStatistics{false};
+    vk::NeuralAcceleratorStatisticsModeARM _neuralStatisticsMode{};
+    /// Hash of the shader code and descriptor set layouts, completed into the pipeline cache key of the pipeline
+    PipelineKey _sourceKey;
+    bool _createdFromBinaries{false};
+    /// Data graph pipeline creation that is still running, declared last so that it completes before the layouts
+    /// and shader modules it uses are destroyed
+    struct DeferredCreation;
+    std::unique_ptr<DeferredCreation> _creation;
+
+    void storePipelineCacheEntry(PipelineCacheEntry *cacheEntry);
+
+    /// \brief Start creating the data graph pipeline described by @p createInfo
+    ///
+    /// @p createInfo and everything it points to must be retained by _creation.
+    void createDataGraphPipeline(const Context &ctx, const vk::DataGraphPipelineCreateInfoARM &createInfo);
 
-    void initSession(const Context &ctx, bool enableNeuralStatistics = false,
-                     vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode = {});
+    void finishDataGraphPipeline(const Context &ctx);
+
+    void createSession(const Context &ctx);
 
     void createDescriptorSetLayouts(const Context &ctx, const std::vector<TypedBinding> &bindings);
 
@@ -139,7 +263,8 @@ class Pipeline {
                                     const std::shared_ptr<PipelineCache> &pipelineCache, bool enableNeuralStatistics,
                                     vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode);
 
-    // Helper to build a DataGraph pipeline once shader module, entry, resources and constants are prepared
+    // Helper to build a DataGraph pipeline once shader module, entry, resources and constants are prepared. The
+    // resource and constant infos must be retained by _creation.
     void buildDataGraphPipeline(const Context &ctx, const std::string &entry,
                                 const std::vector<vk::DataGraphPipelineResourceInfoARM> &resourceInfos,
                                 const std::vector<vk::DataGraphPipelineConstantARM> &constantInfos,
@@ -182,3 +307,12 @@ std::vector<T> Pipeline::getGraphPipelinePropertyData(const vk::raii::Device &de
 }
 
 } // namespace mlsdk::scenariorunner
+
+/// Skip Doxygen® for this to fix warning
+/// \cond
+template <> struct std::hash<mlsdk::scenariorunner::VgfSegmentKey> {
+    std::size_t operator()(const mlsdk::scenariorunner::VgfSegmentKey &key) const noexcept {
+        return static_cast<std::size_t>(key.hash());
+    }
+};
+/// \endcond
@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "pipeline_binary_store.hpp"
+#include "file_utils.hpp"
+#include "logging.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace mlsdk::scenariorunner {
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint64_t fnvPrime = 1099511628211ULL;
+constexpr int indexVersion = 1;
+
+} // namespace
+
+PipelineKey &PipelineKey::add(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t idx = 0; idx < size; ++idx) {
+        _hash = (_hash ^ bytes[idx]) * fnvPrime;
+    }
+    return *this;
+}
+
+PipelineKey &PipelineKey::add(const std::string &value) {
+    add(static_cast<uint64_t>(value.size()));
+    return add(value.data(), value.size());
+}
+
+PipelineBinaryStore::PipelineBinaryStore(const std::filesystem::path &directory, uint64_t maxSize)
+    : _directory(directory), _maxSize(maxSize) {
+    loadIndex();
+}
+
+std::filesystem::path PipelineBinaryStore::entryPath(uint64_t key) const {
+    return _directory / (formatKey(key) + ".bin");
+}
+
+std::filesystem::path PipelineBinaryStore::indexPath() const { return _directory / "index.json"; }
+
+std::filesystem::path PipelineBinaryStore::lockPath() const { return _directory / "index.lock"; }
+
+void PipelineBinaryStore::loadIndex() {
+    if (!std::filesystem::exists(indexPath())) {
+        return;
+    }
+    const FileLock fileLock(lockPath());
+    readIndex(_entries, _generation);
+}
+
+bool PipelineBinaryStore::readIndex(std::unordered_map<uint64_t, Entry> &entries, uint64_t &generation) const {
+    std::ifstream stream(indexPath());
+    if (!stream.is_open()) {
+        return false;
+    }
+    const auto index = json::parse(stream, nullptr, false);
+    const auto version = index.is_object() ? index.find("version") : index.end();
+    if (version == index.end() || !version->is_number_integer() || *version != indexVersion) {
+        mlsdk::logging::warning("Pipeline Cache index skipped: failed to parse " + indexPath().string());
+        return false;
+    }
+    try {
+        generation = index.value("generation", uint64_t{0});
+        for (const auto &[key, entry] : index.at("entries").items()) {
+            Entry loaded;
+            loaded.size = entry.at("size").get<uint64_t>();
+            loaded.lastUse = entry.at("last use").get<uint64_t>();
+            entries[std::stoull(key, nullptr, 16)] = std::move(loaded);
+        }
+    } catch (const std::exception &) {
+        mlsdk::logging::warning("Pipeline Cache index skipped: invalid entries in " + indexPath().string());
+        entries.clear();
+        generation = 0;
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<uint8_t>> PipelineBinaryStore::find(uint64_t key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return std::nullopt;
+    }
+    auto &entry = it->second;
+    if (entry.pending.has_value()) {
+        entry.used = true;
+        return entry.pending;
+    }
+
+    std::ifstream stream(entryPath(key), std::ifstream::binary);
+    std::vector<uint8_t> data(entry.size);
+    if (!stream.read(reinterpret_cast<char *>(data.data()), std::streamsize(data.size())) ||
+        stream.peek() != std::ifstream::traits_type::eof()) {
+        // Written by an incompatible build or modified outside of the runner; the next save rewrites the index
+        mlsdk::logging::warning("Pipeline Cache entry " + formatKey(key) + " skipped: size invalid");
+        _entries.erase(it);
+        _invalid.insert(key);
+        return std::nullopt;
+    }
+    if (!entry.used) {
+        entry.used = true;
+        entry.dirty = true;
+    }
+    return data;
+}
+
+void PipelineBinaryStore::insert(uint64_t key, std::vector<uint8_t> data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _invalid.erase(key);
+    auto &entry = _entries[key];
+    entry.size = data.size();
+    entry.used = true;
+    entry.pending = std::move(data);
+}
+
+PipelineBinaryStore::SaveStats PipelineBinaryStore::save() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    SaveStats stats;
+    stats.written = static_cast<size_t>(std::count_if(
+        _entries.begin(), _entries.end(), [](const auto &keyEntry) { return keyEntry.second.pending.has_value(); }));
+    const bool dirty = std::any_of(_entries.begin(), _entries.end(),
+                                   [](const auto &keyEntry) { return keyEntry.second.dirty; });
+    if (stats.written == 0 && !dirty && _invalid.empty()) {
+        stats.total = _entries.size();
+        return stats;
+    }
+
+    std::filesystem::create_directories(_directory);
+    const FileLock fileLock(lockPath());
+
+    // Other processes may have saved since the index was loaded, so their index is the base of the merge
+    std::unordered_map<uint64_t, Entry> merged;
+    uint64_t diskGeneration = 0;
+    readIndex(merged, diskGeneration);
+    _generation = std::max(_generation, diskGeneration) + 1;
+
+    for (const auto key : _invalid) {
+        if (merged.erase(key) > 0) {
+            std::error_code error;
+            std::filesystem::remove(entryPath(key), error);
+        }
+    }
+    _invalid.clear();
+
+    for (auto &[key, entry] : _entries) {
+        entry.dirty = false;
+        const auto diskEntry = merged.find(key);
+        if (entry.pending.has_value()) {
+            writeFileAtomically(entryPath(key), entry.pending->data(), entry.pending->size());
+            entry.pending.reset();
+        } else if (diskEntry == merged.end()) {
+            // Evicted or cleared by another process
+            continue;
+        } else {
+            entry.lastUse = std::max(entry.lastUse, diskEntry->second.lastUse);
+        }
+        if (entry.used) {
+            entry.lastUse = _generation;
+        }
+        merged[key] = entry;
+    }
+    for (const auto &[key, entry] : merged) {
+        if (_entries.find(key) == _entries.end()) {
+            ++stats.merged;
+        }
+    }
+    _entries = std::move(merged);
+    evict();
+
+    json index;
+    index["version"] = indexVersion;
+    index["generation"] = _generation;
+    index["entries"] = json::object();
+    for (const auto &[key, entry] : _entries) {
+        index["entries"][formatKey(key)] = {{"size", entry.size}, {"last use", entry.lastUse}};
+    }
+    const auto content = index.dump(2);
+    writeFileAtomically(indexPath(), content.data(), content.size());
+    stats.total = _entries.size();
+    return stats;
+}
+
+void PipelineBinaryStore::evict() {
+    uint64_t total = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> byLastUse;
+    byLastUse.reserve(_entries.size());
+    for (const auto &[key, entry] : _entries) {
+        total += entry.size;
+        byLastUse.emplace_back(entry.lastUse, key);
+    }
+    if (total <= _maxSize) {
+        return;
+    }
+
+    std::sort(byLastUse.begin(), byLastUse.end());
+    size_t evicted = 0;
+    for (const auto &[lastUse, key] : byLastUse) {
+        if (total <= _maxSize) {
+            break;
+        }
+        total -= _entries.at(key).size;
+        std::error_code error;
+        std::filesystem::remove(entryPath(key), error);
+        _entries.erase(key);
+        ++evicted;
+    }
+    mlsdk::logging::info("Pipeline Cache evicted " + std::to_string(evicted) + " least recently used entries");
+}
+
+void PipelineBinaryStore::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _invalid.clear();
+    _generation = 0;
+    if (!std::filesystem::is_directory(_directory)) {
+        return;
+    }
+
+    // The lock file stays so that processes waiting on it keep serializing with later ones
+    const FileLock fileLock(lockPath());
+    for (const auto &file : std::filesystem::directory_iterator(_directory)) {
+        if (file.path() != lockPath()) {
+            std::filesystem::remove_all(file.path());
+        }
+    }
+}
+
+size_t PipelineBinaryStore::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+size_t PipelineBinaryStore::newEntries() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<size_t>(std::count_if(_entries.begin(), _entries.end(),
+                                             [](const auto &keyEntry) { return keyEntry.second.pending.has_value(); }));
+}
+
+uint64_t PipelineBinaryStore::totalSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t total = 0;
+    for (const auto &[key, entry] : _entries) {
+        total += entry.size;
+    }
+    return total;
+}
+
+} // namespace mlsdk::scenariorunner
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief Hash of the state a pipeline is compiled from
+///
+/// Uses 64-bit FNV-1a, so keys are stable across runs, builds and platforms.
+class PipelineKey {
+  public:
+    PipelineKey &add(const void *data, size_t size);
+
+    /// \brief Add the size and characters of @p value, so consecutive strings cannot alias
+    PipelineKey &add(const std::string &value);
+
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, bool> = true>
+    PipelineKey &add(T value) {
+        return add(&value, sizeof(value));
+    }
+
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, bool> = true>
+    PipelineKey &add(const std::vector<T> &values) {
+        add(static_cast<uint64_t>(values.size()));
+        return add(values.data(), values.size() * sizeof(T));
+    }
+
+    uint64_t value() const { return _hash; }
+
+  private:
+    uint64_t _hash{14695981039346656037ULL};
+};
+
+/// \brief Keyed on-disk store with the cached data of individual pipelines
+///
+/// The store is a directory with one file per entry and an index holding the size and last use of every entry.
+/// Lookups do not touch the disk besides reading the requested entry. Saving only writes the entries added since
+/// the last save and the index, each to a temporary file that is then renamed over the destination, so an
+/// interrupted run never leaves a truncated entry behind. When the entries exceed the size cap, the least recently
+/// used ones are evicted. Recency is recorded by the saves, so a run that only hits the store rewrites the index
+/// once to record the entries it used.
+///
+/// Several processes can share a store. Saves hold a lock file in the directory and merge the index on disk with
+/// their own entries, so the store converges to the union of the entries of all processes.
+///
+/// All methods are thread-safe.
+class PipelineBinaryStore {
+  public:
+    /// \brief Open the store in @p directory, which is created by the first save that has entries to write
+    ///
+    /// \param directory Store directory
+    /// \param maxSize   Maximum total size of the entries in bytes
+    PipelineBinaryStore(const std::filesystem::path &directory, uint64_t maxSize);
+
+    /// \brief Data of the entry with @p key, or nothing when the store does not have a valid entry for it
+    std::optional<std::vector<uint8_t>> find(uint64_t key);
+
+    /// \brief Add an entry, replacing any entry with the same key on the next save
+    void insert(uint64_t key, std::vector<uint8_t> data);
+
+    /// \brief Outcome of a save
+    struct SaveStats {
+        /// Entries added by this store
+        size_t written{0};
+        /// Entries saved by other processes since this store was loaded or last saved
+        size_t merged{0};
+        /// Entries in the store after eviction
+        size_t total{0};
+    };
+
+    /// \brief Write the new entries, merge the index with the one on disk, then evict entries over the size cap
+    ///
+    /// Does nothing when there are no new entries, no entries used since the last save and no invalid entries.
+    SaveStats save();
+
+    /// \brief Remove every entry, both in memory and on disk
+    void clear();
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t newEntries() const;
+    /// \brief Total size of the entries in bytes
+    uint64_t totalSize() const;
+
+    const std::filesystem::path &directory() const { return _directory; }
+
+  private:
+    struct Entry {
+        uint64_t size{0};
+        /// Generation of the last save that wrote or found the entry
+        uint64_t lastUse{0};
+        bool used{false};
+        /// Used since the last save, which has to record the new last use
+        bool dirty{false};
+        /// Data waiting to be written by the next save
+        std::optional<std::vector<uint8_t>> pending;
+    };
+
+    std::filesystem::path entryPath(uint64_t key) const;
+    std::filesystem::path indexPath() const;
+    std::filesystem::path lockPath() const;
+    void loadIndex();
+    /// \brief Read the index on disk into @p entries, returning false when it is missing or invalid
+    bool readIndex(std::unordered_map<uint64_t, Entry> &entries, uint64_t &generation) const;
+    void evict();
+
+    std::filesystem::path _directory;
+    uint64_t _maxSize;
+    uint64_t _generation{0};
+    std::unordered_map<uint64_t, Entry> _entries;
+    /// Entries whose file did not match the index, dropped from the index on disk by the next save
+    std::unordered_set<uint64_t> _invalid;
+    mutable std::mutex _mutex;
+};
+
+} // namespace mlsdk::scenariorunner
@@ -7,13 +7,17 @@
 #include "logging.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 namespace mlsdk::scenariorunner {
 
-bool PipelineCache::isValidPipelineCache(const void *cacheDataPtr, size_t cacheDataSize, uint32_t expectedVendorID,
-                                         uint32_t expectedDeviceID) {
+namespace {
+
+bool isValidPipelineCache(const void *cacheDataPtr, size_t cacheDataSize, uint32_t expectedVendorID,
+                          uint32_t expectedDeviceID) {
     if (cacheDataSize < sizeof(VkPipelineCacheHeaderVersionOne)) {
         return false;
     }
@@ -39,40 +43,178 @@ bool PipelineCache::isValidPipelineCache(const void *cacheDataPtr, size_t cacheD
     return true;
 }
 
-PipelineCache::PipelineCache(const Context &ctx, const std::filesystem::path &pipelineCachePath, bool clearCache,
-                             bool failOnMiss)
-    : _pipelineCachePath(pipelineCachePath), _failOnMiss(failOnMiss) {
+// Binaries of a pipeline are stored as a count followed by the key, data size and data of every binary
+template <typename T> void appendValue(std::vector<uint8_t> &data, const T &value) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> T readValue(const std::vector<uint8_t> &data, size_t &offset) {
+    if (data.size() - offset < sizeof(T)) {
+        throw std::runtime_error("Truncated pipeline binary entry");
+    }
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+PipelineCacheEntry::PipelineCacheEntry(const Context &ctx, PipelineBinaryStore &store, uint64_t key,
+                                       std::optional<std::vector<uint8_t>> data, bool useBinaries, bool failOnMiss)
+    : _ctx(ctx), _store(store), _key(key), _hit(data.has_value()), _useBinaries(useBinaries),
+      _failOnMiss(failOnMiss) {
+    if (_hit) {
+        _data = std::move(*data);
+    }
+
+    if (_useBinaries) {
+        if (_hit) {
+            createBinaries();
+        }
+        return;
+    }
+
     vk::PipelineCacheCreateInfo cacheCreateInfo;
-    cacheCreateInfo.sType = vk::StructureType::ePipelineCacheCreateInfo;
     cacheCreateInfo.flags = vk::PipelineCacheCreateFlagBits::eExternallySynchronized;
+    if (_hit) {
+        const auto props = ctx.physicalDevice().getProperties();
+        if (isValidPipelineCache(_data.data(), _data.size(), props.vendorID, props.deviceID)) {
+            cacheCreateInfo.initialDataSize = _data.size();
+            cacheCreateInfo.pInitialData = _data.data();
+        } else {
+            mlsdk::logging::warning("Pipeline Cache entry skipped: failed to validate.");
+            _hit = false;
+        }
+    }
+    _pipelineCache = vk::raii::PipelineCache(ctx.device(), cacheCreateInfo);
+}
 
+void PipelineCacheEntry::createBinaries() {
+    std::vector<vk::PipelineBinaryKeyKHR> binaryKeys;
+    std::vector<vk::PipelineBinaryDataKHR> binaryData;
+    try {
+        size_t offset = 0;
+        const auto count = readValue<uint32_t>(_data, offset);
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            vk::PipelineBinaryKeyKHR binaryKey;
+            binaryKey.keySize = readValue<uint32_t>(_data, offset);
+            if (binaryKey.keySize > binaryKey.key.size() || _data.size() - offset < binaryKey.key.size()) {
+                throw std::runtime_error("Invalid pipeline binary key");
+            }
+            std::memcpy(binaryKey.key.data(), _data.data() + offset, binaryKey.key.size());
+            offset += binaryKey.key.size();
+            const auto dataSize = static_cast<size_t>(readValue<uint64_t>(_data, offset));
+            if (_data.size() - offset < dataSize) {
+                throw std::runtime_error("Truncated pipeline binary data");
+            }
+            binaryKeys.push_back(binaryKey);
+            binaryData.emplace_back(dataSize, _data.data() + offset);
+            offset += dataSize;
+        }
+
+        const vk::PipelineBinaryKeysAndDataKHR keysAndData(static_cast<uint32_t>(binaryKeys.size()),
+                                                           binaryKeys.data(), binaryData.data());
+        _binaries = _ctx.device().createPipelineBinariesKHR(vk::PipelineBinaryCreateInfoKHR(&keysAndData));
+    } catch (const std::exception &err) {
+        // Binaries from another driver build are rejected, in which case the pipeline is compiled again
+        mlsdk::logging::warning(std::string("Pipeline Cache entry skipped: ") + err.what());
+        _binaries.clear();
+        _hit = false;
+        return;
+    }
+    for (const auto &binary : _binaries) {
+        _binaryHandles.push_back(*binary);
+    }
+    _binaryInfo = vk::PipelineBinaryInfoKHR(static_cast<uint32_t>(_binaryHandles.size()), _binaryHandles.data());
+}
+
+const void *PipelineCacheEntry::chainBinaryCreateInfo(vk::PipelineCreateFlags flags, const void *next) {
+    if (!_useBinaries) {
+        return next;
+    }
+    if (_hit) {
+        _binaryInfo.pNext = next;
+        return &_binaryInfo;
+    }
+    // The bits of the legacy flags have the same values in the 64-bit flags that replace them
+    _flags2CreateInfo.flags =
+        vk::PipelineCreateFlags2KHR(static_cast<VkPipelineCreateFlags2KHR>(static_cast<VkPipelineCreateFlags>(flags))) |
+        vk::PipelineCreateFlagBits2KHR::eCaptureDataKHR;
+    _flags2CreateInfo.pNext = next;
+    return &_flags2CreateInfo;
+}
+
+void PipelineCacheEntry::store(const vk::raii::Pipeline &pipeline) {
+    if (_hit) {
+        return;
+    }
+    if (!_useBinaries) {
+        _store.insert(_key, _pipelineCache.getData());
+        return;
+    }
+
+    const auto binaries = _ctx.device().createPipelineBinariesKHR(vk::PipelineBinaryCreateInfoKHR(nullptr, *pipeline));
+    std::vector<uint8_t> data;
+    appendValue(data, static_cast<uint32_t>(binaries.size()));
+    for (const auto &binary : binaries) {
+        const auto [binaryKey, binaryData] =
+            _ctx.device().getPipelineBinaryDataKHR(vk::PipelineBinaryDataInfoKHR(*binary));
+        appendValue(data, binaryKey.keySize);
+        data.insert(data.end(), binaryKey.key.begin(), binaryKey.key.end());
+        appendValue(data, static_cast<uint64_t>(binaryData.size()));
+        data.insert(data.end(), binaryData.begin(), binaryData.end());
+    }
+    _ctx.device().releaseCapturedPipelineDataKHR(vk::ReleaseCapturedPipelineDataInfoKHR(*pipeline));
+    _store.insert(_key, std::move(data));
+}
+
+PipelineCache::PipelineCache(const Context &ctx, const std::filesystem::path &pipelineCachePath, bool clearCache,
+                             bool failOnMiss, uint64_t maxSize)
+    : _ctx(ctx), _store(pipelineCachePath, maxSize), _useBinaries(ctx._optionals.pipeline_binary),
+      _failOnMiss(failOnMiss) {
     if (clearCache) {
-        std::filesystem::remove(pipelineCachePath);
+        _store.clear();
         mlsdk::logging::info("Pipeline Cache cleared");
-    } else if (std::filesystem::exists(pipelineCachePath)) {
-        // Use cache file, if existing
-        auto cacheData = std::make_unique<MemoryMap>(pipelineCachePath.string());
+    } else if (std::filesystem::is_regular_file(pipelineCachePath)) {
+        // Single blob written by earlier versions, which cannot be split into the entries of its pipelines
+        std::filesystem::remove(pipelineCachePath);
+        mlsdk::logging::warning("Pipeline Cache skipped: replaced single-file cache with a per-pipeline store");
+    } else if (!_store.empty()) {
+        _loaded = true;
+        mlsdk::logging::info("Pipeline Cache loaded and validated. " + std::to_string(_store.size()) + " entries");
+    }
 
-        if (cacheData->size() == 0) {
-            mlsdk::logging::warning("Pipeline Cache skipped: size invalid");
-        } else {
-            auto props = ctx.physicalDevice().getProperties();
-            if (!isValidPipelineCache(cacheData->ptr(), cacheData->size(), props.vendorID, props.deviceID)) {
-                mlsdk::logging::warning("Pipeline Cache skipped: failed to validate.");
-            } else {
-                _cacheData = std::move(cacheData);
-                cacheCreateInfo.initialDataSize = _cacheData->size();
-                cacheCreateInfo.pInitialData = _cacheData->ptr();
-                mlsdk::logging::info("Pipeline Cache loaded and validated.");
-            }
-        }
+    // Entries of other devices and drivers can share the store, so the identity is part of every key
+    const auto props = ctx.physicalDevice().getProperties();
+    PipelineKey deviceKey;
+    deviceKey.add(props.vendorID).add(props.deviceID).add(props.driverVersion);
+    deviceKey.add(props.pipelineCacheUUID.data(), props.pipelineCacheUUID.size());
+    deviceKey.add(_useBinaries);
+    if (_useBinaries) {
+        // Changes whenever the driver can no longer use binaries it created before
+        const auto globalKey = ctx.device().getPipelineKeyKHR();
+        deviceKey.add(globalKey.key.data(), globalKey.keySize);
     }
-    _pipelineCache = vk::raii::PipelineCache(ctx.device(), cacheCreateInfo);
+    _deviceKey = deviceKey.value();
+}
+
+PipelineKey PipelineCache::makeKey(PipelineType pipelineType) const {
+    return PipelineKey().add(_deviceKey).add(pipelineType);
+}
 
-    getCacheFeedbackCreateInfo(PipelineType::Unknown);
+std::unique_ptr<PipelineCacheEntry> PipelineCache::lookup(const PipelineKey &key, const std::string &pipelineName,
+                                                          bool binaryCapable) {
+    auto data = _store.find(key.value());
+    if (!data.has_value() && failOnCacheMiss()) {
+        throw std::runtime_error("Pipeline cache miss for pipeline: " + pipelineName);
+    }
+    return std::make_unique<PipelineCacheEntry>(_ctx, _store, key.value(), std::move(data),
+                                                _useBinaries && binaryCapable, failOnCacheMiss());
 }
 
-vk::PipelineCreationFeedbackCreateInfo *PipelineCache::getCacheFeedbackCreateInfo(PipelineType pipelineType) {
+vk::PipelineCreationFeedbackCreateInfo *PipelineCreationFeedback::getCreateInfo(PipelineType pipelineType) {
     uint32_t stageCount = 0;
     switch (pipelineType) {
     case PipelineType::Compute:
@@ -85,14 +227,15 @@ vk::PipelineCreationFeedbackCreateInfo *PipelineCache::getCacheFeedbackCreateInf
     case PipelineType::Unknown:
         break;
     }
-    _feedback = vk::PipelineCreationFeedback(vk::PipelineCreationFeedbackFlagBits::eValid, 0);
-    _stagedFeedback.assign(stageCount, vk::PipelineCreationFeedback(vk::PipelineCreationFeedbackFlagBits::eValid, 0));
+    // The driver sets eValid when it fills in the feedback, so the flags must start cleared
+    _feedback = vk::PipelineCreationFeedback({}, 0);
+    _stagedFeedback.assign(stageCount, vk::PipelineCreationFeedback({}, 0));
     _feedbackCreateInfo = vk::PipelineCreationFeedbackCreateInfo(
         &_feedback, static_cast<uint32_t>(_stagedFeedback.size()), _stagedFeedback.data());
     return &_feedbackCreateInfo;
 }
 
-bool PipelineCache::wasPipelineCacheHit() const {
+bool PipelineCreationFeedback::wasPipelineCacheHit() const {
     const auto cacheHit = vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit;
     if (static_cast<bool>(_feedback.flags & cacheHit)) {
         return true;
@@ -108,19 +251,12 @@ void PipelineCache::save() {
         return;
     }
 
-    // Release read-only mapping before truncating the file.
-    _cacheData.reset();
-
-    // Save updated cache to disk
-    std::ofstream fstream(_pipelineCachePath.string(), std::ofstream::binary | std::ofstream::trunc);
-    if (!fstream.is_open()) {
-        throw std::runtime_error("Error storing pipeline cache into: " + _pipelineCachePath.string());
+    const auto stats = _store.save();
+    if (stats.written > 0) {
+        mlsdk::logging::info("Pipeline Cache stored. " + std::to_string(stats.written) + " new entries, " +
+                             std::to_string(stats.merged) + " merged from other processes, " +
+                             std::to_string(stats.total) + " entries total");
     }
-    fstream.exceptions(std::ios::badbit | std::ios::failbit);
-    const auto data = _pipelineCache.getData();
-    fstream.write(reinterpret_cast<const char *>(data.data()), std::streamsize(data.size()));
-    fstream.close();
-    mlsdk::logging::info("Pipeline Cache stored");
 }
 
 } // namespace mlsdk::scenariorunner
@@ -6,37 +6,119 @@
 #pragma once
 
 #include "context.hpp"
+#include "pipeline_binary_store.hpp"
 #include "types.hpp"
-#include "vgf-utils/memory_map.hpp"
 
 #include "vulkan/vulkan_raii.hpp"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace mlsdk::scenariorunner {
 
-class PipelineCache {
+/// \brief Pipeline and per-stage creation feedback filled in by the driver during pipeline creation
+class PipelineCreationFeedback {
   public:
-    explicit PipelineCache(const Context &ctx, const std::filesystem::path &pipelineCachePath, bool clearCache,
-                           bool failOnMiss);
-    void save();
+    /// \brief Reset the feedback and return the create info to chain into the pipeline create info
+    vk::PipelineCreationFeedbackCreateInfo *getCreateInfo(PipelineType pipelineType);
 
-    const vk::raii::PipelineCache *get() const { return &_pipelineCache; }
-    vk::PipelineCreationFeedbackCreateInfo *getCacheFeedbackCreateInfo(PipelineType pipelineType);
-    bool failOnCacheMiss() const { return _failOnMiss && _cacheData; }
+    const vk::PipelineCreationFeedback &pipeline() const { return _feedback; }
+    const std::vector<vk::PipelineCreationFeedback> &stages() const { return _stagedFeedback; }
     bool wasPipelineCacheHit() const;
 
   private:
-    bool isValidPipelineCache(const void *cacheDataPtr, size_t cacheDataSize, uint32_t expectedVendorID,
-                              uint32_t expectedDeviceID);
-    std::filesystem::path _pipelineCachePath;
-    std::unique_ptr<MemoryMap> _cacheData;
-    vk::raii::PipelineCache _pipelineCache{nullptr};
     vk::PipelineCreationFeedbackCreateInfo _feedbackCreateInfo;
     vk::PipelineCreationFeedback _feedback;
     std::vector<vk::PipelineCreationFeedback> _stagedFeedback;
+};
+
+/// \brief Cached data of one pipeline, looked up before and stored after the pipeline is created
+///
+/// Compute and graphics pipelines are created from VK_KHR_pipeline_binary binaries when the device supports them.
+/// Other pipelines, or all of them without the extension, get a pipeline cache of their own seeded with the entry.
+class PipelineCacheEntry {
+  public:
+    PipelineCacheEntry(const Context &ctx, PipelineBinaryStore &store, uint64_t key,
+                       std::optional<std::vector<uint8_t>> data, bool useBinaries, bool failOnMiss);
+
+    PipelineCacheEntry(const PipelineCacheEntry &) = delete;
+    PipelineCacheEntry &operator=(const PipelineCacheEntry &) = delete;
+
+    /// \brief Whether the store had data for the pipeline
+    bool hit() const { return _hit; }
+
+    /// \brief Whether the pipeline is created from binaries rather than compiled
+    bool createdFromBinaries() const { return _hit && _useBinaries; }
+
+    bool failOnCacheMiss() const { return _failOnMiss; }
+
+    /// \brief Pipeline cache to create the pipeline with, nullptr when binaries are used
+    const vk::raii::PipelineCache *get() const { return _useBinaries ? nullptr : &_pipelineCache; }
+
+    /// \brief Prepend the binary structures to the pNext chain @p next of a compute or graphics pipeline create info
+    ///
+    /// On a hit the pipeline is created from the stored binaries. On a miss @p flags are replaced with the same flags
+    /// plus the request to capture the data of the pipeline. Without binaries @p next is returned unchanged.
+    ///
+    /// \return New head of the pNext chain
+    const void *chainBinaryCreateInfo(vk::PipelineCreateFlags flags, const void *next);
+
+    /// \brief Add the data of @p pipeline to the store when it was not found
+    void store(const vk::raii::Pipeline &pipeline);
+
+  private:
+    void createBinaries();
+
+    const Context &_ctx;
+    PipelineBinaryStore &_store;
+    uint64_t _key;
+    std::vector<uint8_t> _data;
+    bool _hit;
+    bool _useBinaries;
+    bool _failOnMiss;
+    vk::raii::PipelineCache _pipelineCache{nullptr};
+    std::vector<vk::raii::PipelineBinaryKHR> _binaries;
+    std::vector<vk::PipelineBinaryKHR> _binaryHandles;
+    vk::PipelineBinaryInfoKHR _binaryInfo;
+    vk::PipelineCreateFlags2CreateInfoKHR _flags2CreateInfo;
+};
+
+/// \brief Per-pipeline cache kept in a PipelineBinaryStore, one entry per pipeline keyed by its create info
+class PipelineCache {
+  public:
+    /// Default cap on the total size of the stored entries
+    static constexpr uint64_t defaultMaxSize = 256ULL * 1024 * 1024;
+
+    explicit PipelineCache(const Context &ctx, const std::filesystem::path &pipelineCachePath, bool clearCache,
+                           bool failOnMiss, uint64_t maxSize = defaultMaxSize);
+
+    /// \brief Start a key for a pipeline of @p pipelineType on the current device and driver
+    PipelineKey makeKey(PipelineType pipelineType) const;
+
+    /// \brief Look up the pipeline identified by @p key
+    ///
+    /// \param key           Key made with makeKey() and completed with the create info of the pipeline
+    /// \param pipelineName  Name of the pipeline, reported on a cache miss
+    /// \param binaryCapable Whether the pipeline type can be created from VK_KHR_pipeline_binary binaries
+    std::unique_ptr<PipelineCacheEntry> lookup(const PipelineKey &key, const std::string &pipelineName,
+                                               bool binaryCapable);
+
+    /// \brief Write the entries added since the last save, if any
+    void save();
+
+    bool failOnCacheMiss() const { return _failOnMiss && _loaded; }
+
+  private:
+    const Context &_ctx;
+    PipelineBinaryStore _store;
+    /// Identity of the device and driver the entries are compiled for
+    uint64_t _deviceKey{0};
+    bool _useBinaries{false};
     bool _failOnMiss{false};
+    bool _loaded{false};
 };
 
 } // namespace mlsdk::scenariorunner
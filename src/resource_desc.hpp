@@ -94,6 +94,7 @@ struct ShaderDesc : ResourceDesc {
     std::vector<SpecializationConstant> specializationConstants;
     std::string buildOpts;
     std::vector<std::string> includeDirs;
+    std::vector<std::vector<SpecializationConstant>> tuningCandidates;
 };
 
 /**
@@ -98,6 +98,18 @@ const GraphConstantInfo &ResourceManager::get(GraphConstantResourceId id) const
     return getResource(_graphConstants, id);
 }
 
+void ResourceManager::setSpecializationConstants(ShaderId id,
+                                                 std::vector<SpecializationConstant> specializationConstants) {
+    _shaders.at(id.value()).specializationConstants = std::move(specializationConstants);
+}
+
+void ResourceManager::releaseGraphConstantData() {
+    for (auto &graphConstant : _graphConstants) {
+        graphConstant.data.reset();
+        graphConstant.size = 0;
+    }
+}
+
 const ImageBarrierInfo &ResourceManager::get(ImageBarrierId id) const { return getResource(_imageBarriers, id); }
 const BufferBarrierInfo &ResourceManager::get(BufferBarrierId id) const { return getResource(_bufferBarriers, id); }
 const TensorBarrierInfo &ResourceManager::get(TensorBarrierId id) const { return getResource(_tensorBarriers, id); }
@@ -81,6 +81,12 @@ class ResourceManager {
     const TensorBarrierInfo &get(TensorBarrierId id) const;
     const MemoryBarrierInfo &get(MemoryBarrierId id) const;
 
+    /// \brief Replace the specialization constants of a shader with those of its tuned candidate
+    void setSpecializationConstants(ShaderId id, std::vector<SpecializationConstant> specializationConstants);
+
+    /// \brief Drop the views of the graph constants, unmapping their files once no pipeline creation uses them
+    void releaseGraphConstantData();
+
     ResourceEntries<BufferId, BufferInfo> buffers() const { return ResourceEntries<BufferId, BufferInfo>{_buffers}; }
     ResourceEntries<ImageId, ImageInfo> images() const { return ResourceEntries<ImageId, ImageInfo>{_images}; }
     ResourceEntries<TensorId, TensorInfo> tensors() const { return ResourceEntries<TensorId, TensorInfo>{_tensors}; }
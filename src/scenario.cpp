@@ -15,6 +15,8 @@
 #include "json_writer.hpp"
 #include "logging.hpp"
 #include "optical_flow_utils.hpp"
+#include "pipeline_binary_store.hpp"
+#include "tuning_database.hpp"
 #include "utils.hpp"
 
 #include "vgf-utils/numpy.hpp"
@@ -91,6 +93,40 @@ void applyGraphResourceShaderMetadata(ShaderInfo &shaderInfo, const DataGraphInf
     }
 }
 
+/// Specialization constants of @p shaderInfo with those of a tuning candidate overriding them by ID
+std::vector<SpecializationConstant> tunedSpecializationConstants(const ShaderInfo &shaderInfo, size_t candidate) {
+    auto constants = shaderInfo.specializationConstants;
+    for (const auto &tuned : shaderInfo.tuningCandidates.at(candidate)) {
+        const auto it = std::find_if(constants.begin(), constants.end(),
+                                     [&tuned](const auto &constant) { return constant.id == tuned.id; });
+        if (it != constants.end()) {
+            it->value = tuned.value;
+        } else {
+            constants.push_back(tuned);
+        }
+    }
+    return constants;
+}
+
+/// Key of a shader in the tuning database, changing with its code, specialization constants and tuning candidates
+uint64_t tuningShaderKey(const ShaderInfo &shaderInfo) {
+    const auto code = readShaderCode(shaderInfo);
+    PipelineKey key;
+    key.add(code).add(shaderInfo.entry);
+    const auto addConstants = [&key](const std::vector<SpecializationConstant> &constants) {
+        key.add(static_cast<uint64_t>(constants.size()));
+        for (const auto &constant : constants) {
+            key.add(constant.id).add(constant.value.ui);
+        }
+    };
+    addConstants(shaderInfo.specializationConstants);
+    key.add(static_cast<uint64_t>(shaderInfo.tuningCandidates.size()));
+    for (const auto &candidate : shaderInfo.tuningCandidates) {
+        addConstants(candidate);
+    }
+    return key.value();
+}
+
 std::optional<RawDataId> getGraphPushData(const std::vector<ResolvedPushConstantMap> &pushConstants,
                                           const std::string &moduleName) {
     for (const auto &pushConstant : pushConstants) {
@@ -155,8 +191,8 @@ struct ResourceInfoFactory {
         }
 
         GraphConstantInfo info(graphConstant.guidStr, getVkFormatFromString(graphConstant.format), graphConstant.dims);
-        MemoryMap mapped(graphConstant.src.value());
-        const auto constantData = vgfutils::numpy::parse(mapped);
+        const auto mapped = std::make_shared<MemoryMap>(graphConstant.src.value());
+        const auto constantData = vgfutils::numpy::parse(*mapped);
 
         if (constantData.shape.size() != info.dims.size()) {
             throw std::runtime_error("Graph constant dims mismatch for: " + graphConstant.guidStr);
@@ -177,8 +213,8 @@ struct ResourceInfoFactory {
                 std::to_string(expectedDataSize) + " vs " + std::to_string(actualDataSize));
         }
 
-        info.data.resize(static_cast<size_t>(actualDataSize));
-        std::memcpy(info.data.data(), constantData.ptr, static_cast<size_t>(actualDataSize));
+        info.data = std::shared_ptr<const uint8_t>(mapped, reinterpret_cast<const uint8_t *>(constantData.ptr));
+        info.size = static_cast<size_t>(actualDataSize);
         return info;
     }
 
@@ -289,7 +325,8 @@ struct ResourceInfoFactory {
                 shader.shaderType,
                 shader.stage,
                 shader.buildOpts,
-                shader.includeDirs};
+                shader.includeDirs,
+                shader.tuningCandidates};
     }
 };
 
@@ -724,15 +761,40 @@ void verifyOpticalFlowData(const DataManager &dataManager, const DispatchOptical
                             dispatchOpticalFlow.gridSize);
 }
 
+/// Budget and usage of every memory heap, empty when VK_EXT_memory_budget is not supported
+std::vector<MemoryHeapUsage> readHeapUsage(const Context &ctx) {
+    std::vector<MemoryHeapUsage> heapUsage;
+    if (!ctx._optionals.memory_budget) {
+        return heapUsage;
+    }
+    const auto properties =
+        ctx.physicalDevice()
+            .getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2, vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    const auto &heaps = properties.get<vk::PhysicalDeviceMemoryProperties2>().memoryProperties;
+    const auto &budget = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    for (uint32_t heapIndex = 0; heapIndex < heaps.memoryHeapCount; ++heapIndex) {
+        heapUsage.push_back({heapIndex, heaps.memoryHeaps[heapIndex].size, budget.heapBudget[heapIndex],
+                             budget.heapUsage[heapIndex]});
+    }
+    return heapUsage;
+}
+
 } // namespace
 
 Scenario::Scenario(const ScenarioOptions &opts, ScenarioSpec &scenarioSpec)
-    : _opts{opts}, _ctx{opts, getFamilyQueue(scenarioSpec)}, _scenarioSpec(scenarioSpec), _compute(_ctx) {
+    : _opts{opts}, _ctx{opts, getFamilyQueue(scenarioSpec)}, _scenarioSpec(scenarioSpec), _compute(_ctx),
+      _perfCounters(opts.perfCounterRawSamples) {
     registerResourceInfo();
     registerBarrierInfo();
     resolveCommands();
     setupResources();
     setupRuntimeCommands();
+    savePipelineReport();
+    sampleAllocatedMemory();
+    sampleHeapUsage();
+    if (_opts.lowMemory) {
+        releaseSetupState();
+    }
 }
 
 Scenario::~Scenario() = default;
@@ -794,15 +856,26 @@ void Scenario::run(int repeatCount, bool dryRun) {
         throw std::invalid_argument("Scenario repeat count must be greater than zero; received " +
                                     std::to_string(repeatCount) + ".");
     }
+    waitForPipelines();
 
     for (int iteration = 0; iteration < repeatCount; ++iteration) {
-        mlsdk::logging::debug("Iteration: " + std::to_string(iteration));
-        runIteration(iteration, repeatCount, dryRun);
-    }
-    saveResults(dryRun);
+        MLSDK_LOG_DEBUG("Iteration: " + std::to_string(iteration));
+        runIteration(iteration, dryRun);
+        sampleHeapUsage();
+    }
+    if (_opts.recordOnly) {
+        const auto &stats = _compute.getRecordingStats();
+        MLSDK_LOG_INFO("Recorded " + std::to_string(repeatCount) + " iteration(s) without submitting: " +
+                       std::to_string(stats.commands) + " commands, " + std::to_string(stats.dispatches) +
+                       " dispatches, " + std::to_string(stats.descriptorSetBinds) + " descriptor set binds, " +
+                       std::to_string(stats.barriers) + " barriers per iteration");
+    }
+    saveMemoryReport();
+    // Nothing was executed in record-only mode, so there are no results to save
+    saveResults(dryRun || _opts.recordOnly);
 }
 
-void Scenario::runIteration(int iteration, int repeatCount, bool dryRun) {
+void Scenario::runIteration(int iteration, bool dryRun) {
     if (_opts.captureFrame && !_frameCapturer) {
         _frameCapturer = std::make_unique<FrameCapturer>();
     }
@@ -814,14 +887,16 @@ void Scenario::runIteration(int iteration, int repeatCount, bool dryRun) {
         _frameCapturer->begin();
     }
 
-    if (!dryRun) {
+    if (_opts.recordOnly) {
+        _compute.recordWithoutSubmit();
+    } else if (!dryRun) {
         if (hasAliasedOptimalTensors()) {
             _compute.prepareCommandBuffer();
             handleAliasedLayoutTransitions();
         }
-        _compute.submitAndWaitOnFence(_perfCounters, iteration);
+        _compute.submitAndWaitOnFence();
     }
-    saveProfilingData(iteration, repeatCount, dryRun);
+    saveProfilingData(iteration, dryRun);
 
     _hasRun = true;
 
@@ -839,6 +914,57 @@ void Scenario::resetForNextRun() {
     }
 }
 
+void Scenario::releaseSetupState() {
+    // Data graph pipelines that are still being compiled read the mapped VGF files and their shader modules
+    waitForPipelines();
+    const auto usageBefore = getHostMemoryUsage();
+
+    _compute.releaseShaderModules();
+    _dataManager.releaseMappedData();
+
+    // Staging memory is only used again to store the outputs, along with the resources sharing their memory manager.
+    // Every resource is walked, including the intermediates created for VGF segments that the scenario does not list.
+    std::unordered_set<MemoryResourceId> outputIds;
+    for (const auto &output : _outputs) {
+        outputIds.insert(output.id);
+    }
+    std::unordered_set<const ResourceMemoryManager *> outputManagers;
+    std::vector<std::shared_ptr<ResourceMemoryManager>> managers;
+    auto addManager = [&](const MemoryResourceId &id, std::shared_ptr<ResourceMemoryManager> manager) {
+        if (!manager) {
+            return;
+        }
+        if (outputIds.find(id) != outputIds.end()) {
+            outputManagers.insert(manager.get());
+        }
+        managers.push_back(std::move(manager));
+    };
+    for (const auto &entry : _resources.buffers()) {
+        addManager(entry.id, _dataManager.getBuffer(entry.id).memoryManager());
+    }
+    for (const auto &entry : _resources.tensors()) {
+        addManager(entry.id, _dataManager.getTensor(entry.id).memoryManager());
+    }
+    for (const auto &entry : _resources.images()) {
+        addManager(entry.id, _dataManager.getImage(entry.id).memoryManager());
+    }
+    for (const auto &manager : managers) {
+        if (outputManagers.find(manager.get()) == outputManagers.end()) {
+            manager->releaseStagingMemory();
+        }
+    }
+
+    const auto usageAfter = getHostMemoryUsage();
+    if (usageBefore.has_value() && usageAfter.has_value()) {
+        _hostResidentBeforeReleaseBytes = usageBefore->residentBytes;
+        _hostResidentAfterReleaseBytes = usageAfter->residentBytes;
+        mlsdk::logging::info("Low memory mode: host resident memory " + std::to_string(usageBefore->residentBytes) +
+                             " -> " + std::to_string(usageAfter->residentBytes) + " bytes");
+    } else {
+        mlsdk::logging::info("Low memory mode: setup state released");
+    }
+}
+
 void Scenario::createRuntimeResources() {
     for (const auto &[id, info] : _resources.buffers()) {
         _dataManager.createBuffer(id, info);
@@ -853,7 +979,7 @@ void Scenario::createRuntimeResources() {
         _dataManager.createRawData(id, info);
     }
     for (const auto &[id, info] : _resources.dataGraphs()) {
-        PerfCounterGuard guard(_perfCounters, "Parse VGF: " + info.debugName, "Scenario Setup");
+        PerfCounterGuard guard(_perfCounters, "Parse VGF: " + info.debugName, PerfCategory::ScenarioSetup);
         _dataManager.createVgfView(id, info);
     }
 }
@@ -874,7 +1000,7 @@ void Scenario::createRuntimeBarriers() {
 }
 
 void Scenario::registerResourceInfo() {
-    mlsdk::logging::info("Setup resources, count: " + std::to_string(_scenarioSpec.resources.size()));
+    MLSDK_LOG_INFO("Setup resources, count: " + std::to_string(_scenarioSpec.resources.size()));
     // Setup resource info
     // (Memory for Tensors and Images is allocated in next pass)
     ResourceInfoFactory resourceInfoFactory;
@@ -924,7 +1050,19 @@ void Scenario::registerResourceInfo() {
             // Barriers can precede the regular resources they reference, so register them in a second pass.
             continue;
         }
-        mlsdk::logging::debug(resourceType(resource) + ": " + resource->guidStr + " loaded");
+        MLSDK_LOG_DEBUG(resourceType(resource) + ": " + resource->guidStr + " loaded");
+
+        const auto &dst = resource->getDestination();
+        if (!dst.has_value()) {
+            continue;
+        }
+        if (resource->resourceType != ResourceType::Buffer && resource->resourceType != ResourceType::Tensor &&
+            resource->resourceType != ResourceType::Image) {
+            throw std::runtime_error("Output destination is not supported for " + resourceType(resource) +
+                                     " resource " + resource->guidStr);
+        }
+        _outputs.push_back(
+            {resolveMemoryResourceId(_resourceIds, resource->guid), resourceType(resource), resource->guidStr, *dst});
     }
 }
 
@@ -953,7 +1091,7 @@ void Scenario::registerBarrierInfo() {
             // Regular resources were registered in registerResourceInfo().
             continue;
         }
-        mlsdk::logging::debug(resourceType(resource) + ": " + resource->guidStr + " loaded");
+        MLSDK_LOG_DEBUG(resourceType(resource) + ": " + resource->guidStr + " loaded");
     }
 }
 
@@ -1039,7 +1177,7 @@ void Scenario::loadJsonResourceData() {
         switch (resource->resourceType) {
         case ResourceType::Tensor: {
             const auto &tensor = reinterpret_cast<const std::unique_ptr<TensorDesc> &>(resource);
-            PerfCounterGuard guard(_perfCounters, "Load Tensor: " + tensor->guidStr, "Scenario Setup");
+            PerfCounterGuard guard(_perfCounters, "Load Tensor: " + tensor->guidStr, PerfCategory::ScenarioSetup);
             const auto id = resolveResourceId<TensorId>(_resourceIds, tensor->guid, "Tensor");
             if (tensor->src || !_groupManager.isAliased(id)) {
                 const auto tensorData = loadTensorData(*tensor);
@@ -1048,7 +1186,7 @@ void Scenario::loadJsonResourceData() {
         } break;
         case ResourceType::Image: {
             const auto &image = reinterpret_cast<const std::unique_ptr<ImageDesc> &>(resource);
-            PerfCounterGuard guard(_perfCounters, "Load Image: " + image->guidStr, "Scenario Setup");
+            PerfCounterGuard guard(_perfCounters, "Load Image: " + image->guidStr, PerfCategory::ScenarioSetup);
             const auto id = resolveResourceId<ImageId>(_resourceIds, image->guid, "Image");
             auto &imageRec = _dataManager.getImageMut(id);
             if (image->src || !_groupManager.isAliased(id)) {
@@ -1059,7 +1197,7 @@ void Scenario::loadJsonResourceData() {
         } break;
         case ResourceType::Buffer: {
             const auto &buffer = reinterpret_cast<const std::unique_ptr<BufferDesc> &>(resource);
-            PerfCounterGuard guard(_perfCounters, "Load Buffer: " + buffer->guidStr, "Scenario Setup");
+            PerfCounterGuard guard(_perfCounters, "Load Buffer: " + buffer->guidStr, PerfCategory::ScenarioSetup);
             const auto id = resolveResourceId<BufferId>(_resourceIds, buffer->guid, "Buffer");
             if (buffer->src || !_groupManager.isAliased(id)) {
                 const auto bufferData = loadBufferData(*buffer);
@@ -1070,7 +1208,7 @@ void Scenario::loadJsonResourceData() {
             // Only buffers, images, and tensors have JSON-provided runtime data to load.
             continue;
         }
-        mlsdk::logging::debug(resourceType(resource) + ": " + resource->guidStr + " loaded");
+        MLSDK_LOG_DEBUG(resourceType(resource) + ": " + resource->guidStr + " loaded");
     }
 }
 
@@ -1108,10 +1246,11 @@ void Scenario::resolveCommands() {
 void Scenario::setupRuntimeCommands() {
     if (_opts.enablePipelineCaching) {
         mlsdk::logging::info("Load Pipeline Cache");
-        PerfCounterGuard guard(_perfCounters, "Load Pipeline Cache.", "Load Pipeline Cache");
+        PerfCounterGuard guard(_perfCounters, "Load Pipeline Cache.", PerfCategory::LoadPipelineCache);
         _pipelineCache = std::make_shared<PipelineCache>(_ctx, _opts.pipelineCachePath, _opts.clearPipelineCache,
-                                                         _opts.failOnPipelineCacheMiss);
+                                                         _opts.failOnPipelineCacheMiss, _opts.pipelineCacheMaxSize);
     }
+    tuneShaders();
     // Setup commands
     mlsdk::logging::info("Setup commands");
 
@@ -1137,10 +1276,14 @@ void Scenario::setupRuntimeCommands() {
     for (const auto &command : _commands) {
         std::visit(setupCommand, command);
     }
+    // Pipelines that are still being created keep the constants they use mapped
+    _resources.releaseGraphConstantData();
     if (_pipelineCache) {
-        PerfCounterGuard guard(_perfCounters, "Save Pipeline Cache (setup)", "Save Pipeline Cache", false);
+        waitForPipelines();
+        PerfCounterGuard guard(_perfCounters, "Save Pipeline Cache (setup)", PerfCategory::SavePipelineCache, false);
         _pipelineCache->save();
     }
+    _compute.setupPerfCounters(_perfCounters);
     // Setup profiling
     if (!_opts.profilingPath.empty() && nQueries != 0) {
         mlsdk::logging::info("Setup profiling");
@@ -1280,14 +1423,113 @@ void Scenario::createComputePipeline(const DispatchComputeData &dispatchCompute,
     }
     const Compute::PipelineCreateArguments args{dispatchCompute.debugName, dispatchCompute.bindings, _pipelineCache};
 
-    PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + shaderInfo.debugName, "Pipeline Setup");
+    PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + shaderInfo.debugName, PerfCategory::PipelineSetup);
     _compute.createPipeline(args, shaderInfo);
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eComputeShader);
     const auto [pushConstantData, pushConstantSize] = getPushConstantData(dispatchCompute.pushData, _dataManager);
     _compute.registerPipelineFenced(_dataManager, dispatchCompute.bindings, pushConstantData, pushConstantSize,
                                     dispatchCompute.implicitBarrier, dispatchCompute.computeDispatch);
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eComputeShader);
-    mlsdk::logging::debug("Shader Pipeline: " + shaderInfo.debugName + " created");
+    MLSDK_LOG_DEBUG("Shader Pipeline: " + shaderInfo.debugName + " created");
+}
+
+void Scenario::tuneShaders() {
+    if (!_opts.tune && _opts.tuningDatabasePath.empty()) {
+        return;
+    }
+    std::optional<TuningDatabase> database;
+    if (!_opts.tuningDatabasePath.empty()) {
+        const auto properties = _ctx.physicalDevice().getProperties();
+        database.emplace(_opts.tuningDatabasePath,
+                         tuningDeviceKey(properties.vendorID, properties.deviceID, properties.driverVersion));
+    }
+
+    bool tuned = false;
+    std::unordered_set<ShaderId> shaders;
+    for (const auto &command : _commands) {
+        const auto *dispatchCompute = std::get_if<DispatchComputeData>(&command);
+        if (dispatchCompute == nullptr || getShader(dispatchCompute->shader).tuningCandidates.empty() ||
+            !shaders.insert(dispatchCompute->shader).second) {
+            continue;
+        }
+        // Shaders are tuned with the bindings and group count of their first dispatch
+        const auto &shaderInfo = getShader(dispatchCompute->shader);
+        const auto shaderKey = tuningShaderKey(shaderInfo);
+        std::optional<TuningResult> result;
+        if (database) {
+            result = database->find(shaderKey);
+        }
+        if (!result && _opts.tune) {
+            result = tuneShader(*dispatchCompute);
+            tuned = true;
+            if (database) {
+                database->insert(shaderKey, *result);
+            }
+        }
+        if (!result || result->candidate >= shaderInfo.tuningCandidates.size()) {
+            mlsdk::logging::warning("Shader " + shaderInfo.debugName +
+                                    " has not been tuned on this device, using its specialization constants");
+            continue;
+        }
+        mlsdk::logging::info("Shader " + shaderInfo.debugName + " uses tuning candidate " +
+                             std::to_string(result->candidate) + " (" + std::to_string(result->timeMs) + " ms)");
+        _resources.setSpecializationConstants(dispatchCompute->shader,
+                                              tunedSpecializationConstants(shaderInfo, result->candidate));
+    }
+
+    if (database) {
+        database->save();
+    }
+    if (tuned) {
+        // The tuning dispatches wrote to the bound resources
+        loadJsonResourceData();
+    }
+}
+
+TuningResult Scenario::tuneShader(const DispatchComputeData &dispatchCompute) {
+    const auto &shaderInfo = getShader(dispatchCompute.shader);
+    const auto [pushConstantData, pushConstantSize] = getPushConstantData(dispatchCompute.pushData, _dataManager);
+    const auto timestampPeriod = _ctx.physicalDevice().getProperties().limits.timestampPeriod;
+    mlsdk::logging::info("Tune shader " + shaderInfo.debugName + ", candidates: " +
+                         std::to_string(shaderInfo.tuningCandidates.size()));
+
+    std::vector<std::vector<double>> timesMs(shaderInfo.tuningCandidates.size());
+    for (size_t candidate = 0; candidate < shaderInfo.tuningCandidates.size(); ++candidate) {
+        ShaderInfo variant = shaderInfo;
+        variant.debugName = shaderInfo.debugName + " candidate " + std::to_string(candidate);
+        variant.specializationConstants = tunedSpecializationConstants(shaderInfo, candidate);
+        PerfCounterGuard guard(_perfCounters, "Tune Shader: " + variant.debugName, PerfCategory::PipelineSetup);
+
+        // Candidates are not added to the pipeline cache, only the winner is created again by the scenario
+        Compute tuner(_ctx);
+        const Compute::PipelineCreateArguments args{variant.debugName, dispatchCompute.bindings, nullptr};
+        tuner.createPipeline(args, variant);
+        tuner.registerWriteTimestamp(0, vk::PipelineStageFlagBits2::eComputeShader);
+        tuner.registerPipelineFenced(_dataManager, dispatchCompute.bindings, pushConstantData, pushConstantSize, true,
+                                     dispatchCompute.computeDispatch);
+        tuner.registerWriteTimestamp(1, vk::PipelineStageFlagBits2::eComputeShader);
+        tuner.setupQueryPool(2);
+
+        // The first submission warms up the caches and clocks and is not timed
+        for (uint32_t repeat = 0; repeat <= _opts.tuningRepeats; ++repeat) {
+            if (repeat > 0) {
+                tuner.reset();
+            }
+            tuner.submitAndWaitOnFence();
+            if (repeat > 0) {
+                const auto timestamps = tuner.getRuntimeProfilingData().timestamps;
+                timesMs[candidate].push_back(static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriod /
+                                             1000000.0);
+            }
+        }
+        MLSDK_LOG_DEBUG("Tuning candidate " + variant.debugName + " timed");
+    }
+
+    TuningResult result;
+    result.candidate = fastestTuningCandidate(timesMs);
+    result.timeMs = medianTuningTime(timesMs[result.candidate]);
+    result.shaderName = shaderInfo.debugName;
+    return result;
 }
 
 void Scenario::createFragmentPipeline(const DispatchFragmentData &dispatchFragment, uint32_t &nQueries) {
@@ -1302,7 +1544,7 @@ void Scenario::createFragmentPipeline(const DispatchFragmentData &dispatchFragme
 
     const Compute::PipelineCreateArguments args{dispatchFragment.debugName, dispatchFragment.bindings, _pipelineCache};
     PerfCounterGuard guard(_perfCounters, "Create Graphics Pipeline: " + fragmentShaderInfo.debugName,
-                           "Pipeline Setup");
+                           PerfCategory::PipelineSetup);
 
     std::vector<vk::Format> colorAttachmentFormats;
     std::vector<GraphicsDispatchAttachment> attachmentInfos;
@@ -1359,7 +1601,7 @@ void Scenario::createFragmentPipeline(const DispatchFragmentData &dispatchFragme
     _compute.registerPipelineFenced(_dataManager, dispatchFragment.bindings, pushConstantData, pushConstantSize,
                                     dispatchFragment.implicitBarrier, dispatchInfo);
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eColorAttachmentOutput);
-    mlsdk::logging::debug("Graphics Pipeline: " + fragmentShaderInfo.debugName + " created");
+    MLSDK_LOG_DEBUG("Graphics Pipeline: " + fragmentShaderInfo.debugName + " created");
 }
 
 void Scenario::createDataGraphPipeline(const DispatchDataGraphData &dispatchDataGraph, uint32_t &nQueries) {
@@ -1369,7 +1611,7 @@ void Scenario::createDataGraphPipeline(const DispatchDataGraphData &dispatchData
         const auto &sequenceBindings =
             vgfView.resolveBindings(segmentIndex, _dataManager, dispatchDataGraph.bindings, intermediates);
         auto moduleName = vgfView.getModuleName(segmentIndex);
-        PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + moduleName, "Pipeline Setup");
+        PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + moduleName, PerfCategory::PipelineSetup);
         createPipeline(segmentIndex, sequenceBindings, vgfView, dispatchDataGraph, nQueries);
     }
 }
@@ -1403,17 +1645,17 @@ void Scenario::createSpirvGraphPipeline(const DispatchSpirvGraphData &dispatchSp
         throw std::runtime_error("No resource with this guid found");
     }
 
-    const auto graphConstants = collectGraphConstants(dispatchSpirvGraph.graphConstants, _resources);
+    auto graphConstants = collectGraphConstants(dispatchSpirvGraph.graphConstants, _resources);
 
     // Create pipeline and record DataGraph dispatch
-    PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + shaderInfo.debugName, "Pipeline Setup");
+    PerfCounterGuard guard(_perfCounters, "Create Pipeline: " + shaderInfo.debugName, PerfCategory::PipelineSetup);
     const Compute::PipelineCreateArguments args{dispatchSpirvGraph.debugName, sequenceBindings, _pipelineCache};
-    _compute.createPipeline(args, shaderInfo, _dataManager, graphConstants, _opts.shouldDumpNeuralStatistics(),
-                            _opts.neuralStatisticsMode);
+    _compute.createPipeline(args, shaderInfo, _dataManager, std::move(graphConstants),
+                            _opts.shouldDumpNeuralStatistics(), _opts.neuralStatisticsMode);
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eDataGraphARM);
     _compute.registerPipelineFenced(_dataManager, sequenceBindings, nullptr, 0, dispatchSpirvGraph.implicitBarrier);
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eDataGraphARM);
-    mlsdk::logging::debug("Graph Pipeline: " + shaderInfo.debugName + " created");
+    MLSDK_LOG_DEBUG("Graph Pipeline: " + shaderInfo.debugName + " created");
 }
 
 void Scenario::createOpticalFlowPipeline(const DispatchOpticalFlowData &dispatchOpticalFlow, uint32_t &nQueries) {
@@ -1424,7 +1666,7 @@ void Scenario::createOpticalFlowPipeline(const DispatchOpticalFlowData &dispatch
     const auto gridSize = getOpticalFlowGridSize(dispatchOpticalFlow.gridSize);
 
     PerfCounterGuard guard(_perfCounters, "Create Optical Flow Pipeline: " + dispatchOpticalFlow.debugName,
-                           "Pipeline Setup");
+                           PerfCategory::PipelineSetup);
 
     std::vector<TypedBinding> bindings;
     bindings.reserve(5);
@@ -1454,7 +1696,7 @@ void Scenario::createOpticalFlowPipeline(const DispatchOpticalFlowData &dispatch
 
     _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eDataGraphARM);
 
-    mlsdk::logging::debug("Optical Flow Pipeline: " + dispatchOpticalFlow.debugName + " created");
+    MLSDK_LOG_DEBUG("Optical Flow Pipeline: " + dispatchOpticalFlow.debugName + " created");
 }
 
 void Scenario::createPipeline(const uint32_t segmentIndex, const std::vector<TypedBinding> &sequenceBindings,
@@ -1469,7 +1711,7 @@ void Scenario::createPipeline(const uint32_t segmentIndex, const std::vector<Typ
         _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eDataGraphARM);
         _compute.registerPipelineFenced(_dataManager, sequenceBindings, nullptr, 0, dispatchDataGraph.implicitBarrier);
         _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eDataGraphARM);
-        mlsdk::logging::debug("Graph Pipeline: " + vgfView.getModuleName(segmentIndex) + " created");
+        MLSDK_LOG_DEBUG("Graph Pipeline: " + vgfView.getModuleName(segmentIndex) + " created");
     } break;
     case ModuleType::SHADER: {
         const auto &dataGraph = _resources.get(dispatchDataGraph.dataGraph);
@@ -1527,29 +1769,151 @@ void Scenario::createPipeline(const uint32_t segmentIndex, const std::vector<Typ
                                         dispatchDataGraph.implicitBarrier,
                                         {dispatchShape[0], dispatchShape[1], dispatchShape[2], profileName});
         _compute.registerWriteTimestamp(nQueries++, vk::PipelineStageFlagBits2::eComputeShader);
-        mlsdk::logging::debug("Shader Pipeline: " + vgfView.getModuleName(segmentIndex) + " created");
+        MLSDK_LOG_DEBUG("Shader Pipeline: " + vgfView.getModuleName(segmentIndex) + " created");
     } break;
     default:
         throw std::runtime_error("Unknown module type");
     }
 }
 
-void Scenario::saveProfilingData(int iteration, int repeatCount, bool dryRun) {
+void Scenario::saveProfilingData(int iteration, bool dryRun) {
     // Save profiling data
     if (!_opts.profilingPath.empty()) {
+        if (!_profilingWriter) {
+            _profilingWriter = std::make_unique<ProfilingWriter>(_opts.profilingPath);
+        }
         std::optional<RuntimeProfilingData> runtimeProfilingData;
-        if (!dryRun) {
+        if (!dryRun && !_opts.recordOnly) {
             runtimeProfilingData = _compute.getRuntimeProfilingData();
         }
         const auto memoryProfilingData = _compute.getMemoryProfilingData();
-        writeProfilingData(runtimeProfilingData, memoryProfilingData, _opts.profilingPath, iteration, repeatCount);
+        _profilingWriter->write(runtimeProfilingData, memoryProfilingData, iteration);
+        if (_opts.recordOnly) {
+            _profilingWriter->writeRecording(_compute.getRecordingStats(), iteration);
+        }
         mlsdk::logging::info("Profiling data stored");
     }
 }
 
+MemoryReport Scenario::collectMemoryReport() const {
+    MemoryReport memoryReport;
+    const auto memoryProperties = _ctx.physicalDevice().getMemoryProperties();
+
+    // Resources of an alias group share one memory manager, so its allocations are only counted once
+    std::unordered_map<const ResourceMemoryManager *, uint64_t> requestedBytesPerManager;
+    auto addResource = [&](const char *type, const std::string &name, const MemoryResourceId &id,
+                           const std::shared_ptr<ResourceMemoryManager> &manager, vk::DeviceSize requestedBytes) {
+        if (!manager || !manager->isInitalized()) {
+            return;
+        }
+        ResourceMemoryUsage usage;
+        usage.type = type;
+        usage.name = name;
+        usage.requestedBytes = requestedBytes;
+        usage.allocatedBytes = manager->getMemSize();
+        usage.memoryTypeIndex = manager->getMemoryTypeIndex();
+        if (usage.memoryTypeIndex < memoryProperties.memoryTypeCount) {
+            usage.memoryProperties = vk::to_string(memoryProperties.memoryTypes[usage.memoryTypeIndex].propertyFlags);
+        }
+        usage.stagingBytes = manager->getStagingMemSize();
+        if (const auto group = _groupManager.getGroupForResource(id); group.has_value()) {
+            usage.aliasGroup = group->value();
+            usage.aliasCount = _groupManager.getAliasCount(id);
+        }
+
+        const auto [it, inserted] = requestedBytesPerManager.try_emplace(manager.get(), 0);
+        if (inserted) {
+            // Every memory manager allocates its device memory and a staging allocation, which low memory mode
+            // releases for the resources that are not stored
+            memoryReport.allocationCount += manager->isStagingReleased() ? 1 : 2;
+            memoryReport.resourceBytes += usage.allocatedBytes;
+            memoryReport.stagingBytes += usage.stagingBytes;
+        }
+        it->second += requestedBytes;
+        memoryReport.resources.push_back(std::move(usage));
+    };
+    for (const auto &entry : _resources.buffers()) {
+        const auto &buffer = _dataManager.getBuffer(entry.id);
+        addResource("Buffer", buffer.debugName(), entry.id, buffer.memoryManager(), buffer.memoryRequirement());
+    }
+    for (const auto &entry : _resources.tensors()) {
+        const auto &tensor = _dataManager.getTensor(entry.id);
+        addResource("Tensor", tensor.debugName(), entry.id, tensor.memoryManager(), tensor.memoryRequirement());
+    }
+    for (const auto &entry : _resources.images()) {
+        const auto &image = _dataManager.getImage(entry.id);
+        addResource("Image", image.debugName(), entry.id, image.memoryManager(), image.memoryRequirement());
+    }
+    for (const auto &[manager, requestedBytes] : requestedBytesPerManager) {
+        if (requestedBytes > manager->getMemSize()) {
+            memoryReport.aliasingSavedBytes += requestedBytes - manager->getMemSize();
+        }
+    }
+    _compute.addSessionMemory(memoryReport);
+    return memoryReport;
+}
+
+void Scenario::sampleAllocatedMemory() {
+    if (_opts.profilingPath.empty()) {
+        return;
+    }
+    const auto memoryReport = collectMemoryReport();
+    _peakAllocatedBytes = std::max(_peakAllocatedBytes, memoryReport.resourceBytes + memoryReport.stagingBytes +
+                                                            memoryReport.sessionMemoryBytes);
+}
+
+void Scenario::sampleHeapUsage() {
+    if (_opts.profilingPath.empty()) {
+        return;
+    }
+    const auto heaps = readHeapUsage(_ctx);
+    _peakHeapUsageBytes.resize(heaps.size(), 0);
+    for (const auto &heap : heaps) {
+        _peakHeapUsageBytes[heap.heapIndex] = std::max(_peakHeapUsageBytes[heap.heapIndex], heap.usageBytes);
+    }
+}
+
+void Scenario::saveMemoryReport() {
+    if (!_profilingWriter) {
+        return;
+    }
+    auto memoryReport = collectMemoryReport();
+    memoryReport.peakAllocatedBytes = std::max(
+        _peakAllocatedBytes, memoryReport.resourceBytes + memoryReport.stagingBytes + memoryReport.sessionMemoryBytes);
+    memoryReport.heaps = readHeapUsage(_ctx);
+    for (auto &heap : memoryReport.heaps) {
+        heap.peakUsageBytes = heap.usageBytes;
+        if (heap.heapIndex < _peakHeapUsageBytes.size()) {
+            heap.peakUsageBytes = std::max(heap.peakUsageBytes, _peakHeapUsageBytes[heap.heapIndex]);
+        }
+    }
+    if (const auto hostMemoryUsage = getHostMemoryUsage(); hostMemoryUsage.has_value()) {
+        memoryReport.hostResidentBytes = hostMemoryUsage->residentBytes;
+        memoryReport.hostPeakResidentBytes = hostMemoryUsage->peakResidentBytes;
+    }
+    memoryReport.hostResidentBeforeReleaseBytes = _hostResidentBeforeReleaseBytes;
+    memoryReport.hostResidentAfterReleaseBytes = _hostResidentAfterReleaseBytes;
+
+    _profilingWriter->writeMemoryReport(memoryReport);
+    mlsdk::logging::info("Memory report stored");
+}
+
+void Scenario::waitForPipelines() {
+    PerfCounterGuard guard(_perfCounters, "Wait for Pipelines", PerfCategory::PipelineSetup);
+    _compute.waitForPipelines();
+}
+
+void Scenario::savePipelineReport() {
+    if (_opts.pipelineReportPath.empty()) {
+        return;
+    }
+    waitForPipelines();
+    writePipelineReport(_compute.getPipelineReports(), _opts.pipelineReportPath);
+}
+
 void Scenario::saveResults(bool dryRun) {
     if (_pipelineCache) {
-        PerfCounterGuard guard(_perfCounters, "Save Pipeline Cache", "Save Pipeline Cache", false);
+        PerfCounterGuard guard(_perfCounters, "Save Pipeline Cache", PerfCategory::SavePipelineCache, false);
         _pipelineCache->save();
     }
 
@@ -1568,29 +1932,16 @@ void Scenario::saveResults(bool dryRun) {
 
     // Save resources that have an output destination
     {
-        PerfCounterGuard guard(_perfCounters, "Save Resources", "Save Results", false);
-        for (const auto &resourceDesc : _scenarioSpec.resources) {
-            const auto &dst = resourceDesc->getDestination();
-            if (dst.has_value()) {
-                switch (resourceDesc->resourceType) {
-                case ResourceType::Buffer:
-                    _dataManager.getBuffer(resolveResourceId<BufferId>(_resourceIds, resourceDesc->guid, "Buffer"))
-                        .store(_ctx, dst.value());
-                    break;
-                case ResourceType::Tensor:
-                    _dataManager.getTensor(resolveResourceId<TensorId>(_resourceIds, resourceDesc->guid, "Tensor"))
-                        .store(_ctx, dst.value());
-                    break;
-                case ResourceType::Image:
-                    _dataManager.getImageMut(resolveResourceId<ImageId>(_resourceIds, resourceDesc->guid, "Image"))
-                        .store(_ctx, dst.value());
-                    break;
-                default:
-                    throw std::runtime_error("Output destination is not supported for " + resourceType(resourceDesc) +
-                                             " resource " + resourceDesc->guidStr);
-                }
-                mlsdk::logging::debug(resourceType(resourceDesc) + " " + resourceDesc->guidStr + " output stored");
+        PerfCounterGuard guard(_perfCounters, "Save Resources", PerfCategory::SaveResults, false);
+        for (const auto &output : _outputs) {
+            if (const auto *bufferId = std::get_if<BufferId>(&output.id)) {
+                _dataManager.getBuffer(*bufferId).store(_ctx, output.destination);
+            } else if (const auto *tensorId = std::get_if<TensorId>(&output.id)) {
+                _dataManager.getTensor(*tensorId).store(_ctx, output.destination);
+            } else {
+                _dataManager.getImageMut(std::get<ImageId>(output.id)).store(_ctx, output.destination);
             }
+            MLSDK_LOG_DEBUG(output.type + " " + output.guidStr + " output stored");
         }
     }
     mlsdk::logging::info("Results stored");
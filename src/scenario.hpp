@@ -11,11 +11,14 @@
 #include "data_manager.hpp"
 #include "frame_capturer.hpp"
 #include "group_manager.hpp"
+#include "json_writer.hpp"
 #include "resource_data.hpp"
 #include "resource_manager.hpp"
 #include "scenario_desc.hpp"
+#include "tuning_database.hpp"
 #include "types.hpp"
 
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -30,13 +33,30 @@ struct ScenarioOptions {
     bool enableGPUDebugMarkers{false};
     bool captureFrame{false};
     bool enableRobustnessFeatures{false};
+    /// Record the command buffers of every iteration without submitting them
+    bool recordOnly{false};
+    /// Bind the transient memory of every data graph session to one shared allocation
+    bool aliasSessionMemory{false};
+    /// Release the host-side state that only setup needs once the scenario is set up. Afterwards, only resources
+    /// with an output destination can be uploaded to or downloaded from.
+    bool lowMemory{false};
+    /// Time the tuning candidates of the shaders without a tuning result for the device and use the fastest
+    bool tune{false};
+    /// Number of timed dispatches of every tuning candidate
+    uint32_t tuningRepeats{5};
+    /// Tuning results to apply and to add new results to, none when empty
+    std::filesystem::path tuningDatabasePath;
     std::filesystem::path pipelineCachePath;
+    /// Maximum total size of the pipeline cache entries in bytes
+    uint64_t pipelineCacheMaxSize{PipelineCache::defaultMaxSize};
     std::filesystem::path neuralDebugDatabaseDumpDir;
     std::filesystem::path neuralStatisticsDumpDir;
     std::filesystem::path graphProfilingDumpDir;
     std::filesystem::path sessionRAMsDumpDir;
     std::filesystem::path perfCountersPath;
+    size_t perfCounterRawSamples{0};
     std::filesystem::path profilingPath;
+    std::filesystem::path pipelineReportPath;
     std::vector<std::string> disabledExtensions;
     vk::NeuralAcceleratorStatisticsModeARM neuralStatisticsMode{};
 
@@ -77,7 +97,7 @@ class Scenario {
     TensorData download(TensorId id) const;
 
   private:
-    void runIteration(int iteration, int repeatCount, bool dryRun);
+    void runIteration(int iteration, bool dryRun);
 
     void createComputePipeline(const DispatchComputeData &dispatchCompute, uint32_t &nQueries);
     void createDataGraphPipeline(const DispatchDataGraphData &dispatchDataGraph, uint32_t &nQueries);
@@ -98,8 +118,34 @@ class Scenario {
     void resolveCommands();
     void setupRuntimeCommands();
 
-    /// \brief Save profiling data to file
-    void saveProfilingData(int iteration, int repeatCount, bool dryRun);
+    /// \brief Apply the tuning results of the shaders with tuning candidates, tuning them first when requested
+    void tuneShaders();
+
+    /// \brief Time every tuning candidate of the shader of @p dispatchCompute and return the fastest
+    TuningResult tuneShader(const DispatchComputeData &dispatchCompute);
+
+    /// \brief Append the profiling data of @p iteration to the profiling file
+    void saveProfilingData(int iteration, bool dryRun);
+
+    /// \brief Memory currently allocated for resources, staging and data graph sessions
+    MemoryReport collectMemoryReport() const;
+
+    /// \brief Update the peak allocated device memory
+    ///
+    /// Only setup allocates device memory and the low memory release only frees it, so this runs once after setup.
+    void sampleAllocatedMemory();
+
+    /// \brief Update the peak usage of every heap with the heap usage now
+    void sampleHeapUsage();
+
+    /// \brief Append the memory allocated for resources, staging and data graph sessions to the profiling file
+    void saveMemoryReport();
+
+    /// \brief Wait for the data graph pipelines still being compiled in the background
+    void waitForPipelines();
+
+    /// \brief Write the creation feedback and executable statistics of every pipeline to the report file
+    void savePipelineReport();
 
     /// \brief Save results of output resources to files
     void saveResults(bool dryRun);
@@ -107,6 +153,9 @@ class Scenario {
     /// \brief Reset transient execution state before another run
     void resetForNextRun();
 
+    /// \brief Release mapped input files, shader modules and the staging memory of resources that are not outputs
+    void releaseSetupState();
+
     bool hasAliasedOptimalTensors() const;
     void handleAliasedLayoutTransitions();
     MemoryResourceId getMemoryResourceId(const Guid &guid) const;
@@ -121,12 +170,28 @@ class Scenario {
     std::unordered_map<DataGraphId, VgfResourceCreationResult> _vgfResourceCreationResults;
     DataManager _dataManager;
     ScenarioSpec &_scenarioSpec;
+    /// \brief Resource with an output destination, stored by saveResults
+    struct OutputResource {
+        MemoryResourceId id;
+        std::string type;
+        std::string guidStr;
+        std::string destination;
+    };
+    std::vector<OutputResource> _outputs;
     std::vector<detail::ScenarioCommand> _commands;
     std::shared_ptr<PipelineCache> _pipelineCache;
     Compute _compute;
-    std::vector<PerformanceCounter> _perfCounters;
+    PerfCounterRegistry _perfCounters;
     GroupManager _groupManager;
     std::unique_ptr<FrameCapturer> _frameCapturer;
+    std::unique_ptr<ProfilingWriter> _profilingWriter;
+    /// Memory allocated once setup is done, the highest allocated during the run
+    uint64_t _peakAllocatedBytes{0};
+    /// Highest heap usage, sampled after setup and after every iteration
+    std::vector<uint64_t> _peakHeapUsageBytes;
+    /// Host resident memory around releaseSetupState, only sampled in low memory mode
+    std::optional<uint64_t> _hostResidentBeforeReleaseBytes;
+    std::optional<uint64_t> _hostResidentAfterReleaseBytes;
     bool _hasRun{false};
 };
 
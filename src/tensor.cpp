@@ -8,6 +8,8 @@
 #include "utils.hpp"
 #include "vulkan_debug_utils.hpp"
 
+#include <cstring>
+#include <stdexcept>
 #include <utility>
 
 namespace mlsdk::scenariorunner {
@@ -25,6 +27,35 @@ constexpr vk::TensorTilingARM convertTiling(const Tiling tiling) {
 
 } // namespace
 
+std::vector<char> packStridedTensorData(const char *src, const std::vector<int64_t> &shape,
+                                        const std::vector<int64_t> &strides, int64_t elementSize) {
+    if (shape.size() != 4 || strides.size() != 4) {
+        throw std::runtime_error("Strided tensor data must have 4 dimensions");
+    }
+    const auto rowSize = static_cast<size_t>(shape[3] * elementSize);
+    std::vector<char> out(static_cast<size_t>(shape[0] * shape[1] * shape[2]) * rowSize);
+    // Rows along the innermost dimension are copied in one go when their elements are contiguous
+    const bool contiguousRows = strides[3] == elementSize;
+    auto *dst = out.data();
+    for (int64_t a = 0; a < shape[0]; ++a) {
+        for (int64_t b = 0; b < shape[1]; ++b) {
+            for (int64_t c = 0; c < shape[2]; ++c) {
+                const auto *row = src + a * strides[0] + b * strides[1] + c * strides[2];
+                if (contiguousRows) {
+                    std::memcpy(dst, row, rowSize);
+                    dst += rowSize;
+                    continue;
+                }
+                for (int64_t d = 0; d < shape[3]; ++d) {
+                    std::memcpy(dst, row + d * strides[3], static_cast<size_t>(elementSize));
+                    dst += elementSize;
+                }
+            }
+        }
+    }
+    return out;
+}
+
 Tensor::Tensor(TensorInfo tensorInfo)
     : _debugName(std::move(tensorInfo.debugName)), _shape(std::move(tensorInfo.shape)), _dataType(tensorInfo.format),
       _tiling(convertTiling(tensorInfo.tiling)), _memoryOffset(tensorInfo.memoryOffset),
@@ -208,22 +239,9 @@ std::vector<char> Tensor::getTensorData(const Context &ctx) const {
 
     std::vector<char> out;
     // 2) If padded/tiled (_size != dataSize) *and* a 4D tensor with strides,
-    //    walk element-by-element using those strides to lay out the data correctly
+    //    use those strides to lay out the data correctly
     if (_size != dSize && _shape.size() == _strides.size() && _shape.size() == 4) {
-        out.reserve(dSize);
-        const int64_t elementSize{elementSizeFromVkFormat(dataType())};
-        for (int64_t a = 0; a < _shape[0]; ++a) {
-            for (int64_t b = 0; b < _shape[1]; ++b) {
-                for (int64_t c = 0; c < _shape[2]; ++c) {
-                    for (int64_t d = 0; d < _shape[3]; ++d) {
-                        for (int64_t e = 0; e < elementSize; ++e) {
-                            int64_t dataIdx = a * _strides[0] + b * _strides[1] + c * _strides[2] + d * _strides[3] + e;
-                            out.push_back(mapped[dataIdx]);
-                        }
-                    }
-                }
-            }
-        }
+        out = packStridedTensorData(mapped, _shape, _strides, elementSizeFromVkFormat(dataType()));
     } else {
         if (_size != dSize) {
             mlsdk::logging::warning("Tensor data size " + std::to_string(dSize) +
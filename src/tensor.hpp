@@ -12,6 +12,16 @@
 
 namespace mlsdk::scenariorunner {
 
+/// \brief Copy a strided 4D tensor into a tightly packed buffer
+///
+/// \param src         Start of the strided tensor data
+/// \param shape       Tensor shape, must have 4 dimensions
+/// \param strides     Byte stride of every dimension
+/// \param elementSize Size of one element in bytes
+/// \return Packed tensor data
+std::vector<char> packStridedTensorData(const char *src, const std::vector<int64_t> &shape,
+                                        const std::vector<int64_t> &strides, int64_t elementSize);
+
 class Tensor {
   public:
     /// \brief Constructor
@@ -73,6 +83,11 @@ class Tensor {
 
     const std::string &debugName() const;
 
+    std::shared_ptr<ResourceMemoryManager> memoryManager() const { return _memoryManager; }
+
+    /// \brief Get the size of device memory the tensor requires
+    vk::DeviceSize memoryRequirement() const { return _size; }
+
   private:
     uint64_t dataSize() const;
 
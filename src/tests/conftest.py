@@ -4,6 +4,7 @@
 #
 from __future__ import annotations
 
+import json
 import logging
 import os
 import platform
@@ -87,6 +88,13 @@ class ResourcesHelper:
         """Returns path to the scenario resource file."""
         return self.resources_path / "scenarios" / name
 
+    @staticmethod
+    def load_profiling_records(path: str | Path, record: str) -> list[dict]:
+        """Returns the records of one type from a JSON Lines profiling dump."""
+        with open(path, encoding="utf-8") as dump_file:
+            records = [json.loads(line) for line in dump_file if line.strip()]
+        return [entry for entry in records if entry["Record"] == record]
+
     def prepare_scenario(
         self, name: str, replacements: dict[str, str] | None = None
     ) -> Path:
@@ -1314,6 +1314,34 @@ TEST(JsonParser, ShaderResource) {
     ASSERT_TRUE(desc.specializationConstants[1].id == 1);
     ASSERT_TRUE(desc.specializationConstants[1].value.f == 12.0f);
     ASSERT_TRUE(desc.buildOpts == "-DQUANTIZE");
+    ASSERT_TRUE(desc.tuningCandidates.empty());
+}
+
+TEST(JsonParser, ShaderResourceTuningCandidates) {
+    auto jsonInput =
+        R"(
+    {
+        "specialization_constants": [{"id": 0, "value": 8}],
+        "src": "./shaders/matmul.spv",
+        "tuning_candidates": [
+            [{"id": 0, "value": 8}],
+            [{"id": 0, "value": 16}, {"id": 1, "value": 4}]
+        ],
+        "type": "SPIR-V",
+        "uid": "matmul_shader"
+    }
+    )"_json;
+
+    const auto desc = MakeFromJSON<ShaderDesc>(jsonInput);
+
+    ASSERT_EQ(desc.tuningCandidates.size(), 2U);
+    ASSERT_EQ(desc.tuningCandidates[0].size(), 1U);
+    ASSERT_EQ(desc.tuningCandidates[1].size(), 2U);
+    ASSERT_EQ(desc.tuningCandidates[1][0].value.ui, 16U);
+    ASSERT_EQ(desc.tuningCandidates[1][1].id, 1);
+
+    jsonInput["stage"] = "fragment";
+    ASSERT_THROW(MakeFromJSON<ShaderDesc>(jsonInput), std::runtime_error);
 }
 
 TEST(JsonParser, RawDataResource) {
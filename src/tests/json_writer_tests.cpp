@@ -10,55 +10,253 @@
 #include "nlohmann/json.hpp"
 #include "vgf-utils/temp_folder.hpp"
 
+#include <filesystem>
 #include <fstream>
+#include <string>
 #include <vector>
 
 namespace mlsdk::scenariorunner {
 
+namespace {
+
+std::vector<nlohmann::json> readRecords(const std::filesystem::path &path) {
+    std::ifstream dumpFile(path);
+    std::vector<nlohmann::json> records;
+    std::string line;
+    while (std::getline(dumpFile, line)) {
+        records.push_back(nlohmann::json::parse(line));
+    }
+    return records;
+}
+
+} // namespace
+
 TEST(JsonWriter, WritesMemoryUsageWithoutTimestamps) {
     TempFolder tempFolder("scenario_runner_json_writer_tests");
-    const auto profilingPath = tempFolder.relative("dry_run_profiling.json");
+    const auto profilingPath = tempFolder.relative("dry_run_profiling.jsonl");
     const MemoryProfilingData memoryProfilingData{{{"graph_ref/conv2d_graph_segment", 4096}}};
 
-    writeProfilingData(std::nullopt, memoryProfilingData, profilingPath, 0, 1);
+    ProfilingWriter writer(profilingPath);
+    writer.write(std::nullopt, memoryProfilingData, 0);
 
-    std::ifstream dumpFile(profilingPath);
-    const auto profilingData = nlohmann::json::parse(dumpFile);
+    const auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0]["Record"], "Memory Usage");
+    EXPECT_EQ(records[0]["Command type"], "DataGraphDispatch");
+    EXPECT_EQ(records[0]["Command name"], "graph_ref/conv2d_graph_segment");
+    EXPECT_EQ(records[0]["Session memory [bytes]"], 4096);
+}
 
-    ASSERT_FALSE(profilingData.contains("Timestamps"));
-    ASSERT_TRUE(profilingData.contains("Memory Usage"));
-    ASSERT_EQ(profilingData["Memory Usage"].size(), 1);
-    EXPECT_EQ(profilingData["Memory Usage"][0]["Command type"], "DataGraphDispatch");
-    EXPECT_EQ(profilingData["Memory Usage"][0]["Command name"], "graph_ref/conv2d_graph_segment");
-    EXPECT_EQ(profilingData["Memory Usage"][0]["Session memory [bytes]"], 4096);
+TEST(JsonWriter, WritesEmptyFileWithoutProfilingData) { // cppcheck-suppress syntaxError
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto profilingPath = tempFolder.relative("empty_dry_run_profiling.jsonl");
+
+    ProfilingWriter writer(profilingPath);
+    writer.write(std::nullopt, {}, 0);
+
+    EXPECT_TRUE(readRecords(profilingPath).empty());
 }
 
-TEST(JsonWriter, WritesEmptyObjectWithoutProfilingData) { // cppcheck-suppress syntaxError
+TEST(JsonWriter, StreamsEachIterationAndTotalExecutionTime) {
     TempFolder tempFolder("scenario_runner_json_writer_tests");
-    const auto profilingPath = tempFolder.relative("empty_dry_run_profiling.json");
+    const auto profilingPath = tempFolder.relative("runtime_profiling.jsonl");
+    const std::vector<ProfiledCommand> commands{{"ComputeDispatch", "first"}, {"ComputeDispatch", "second"}};
 
-    writeProfilingData(std::nullopt, {}, profilingPath, 0, 1);
+    ProfilingWriter writer(profilingPath);
+    writer.write(RuntimeProfilingData{{100, 150, 175, 250}, 2.0f, commands}, {}, 0);
 
-    std::ifstream dumpFile(profilingPath);
-    const auto profilingData = nlohmann::json::parse(dumpFile);
+    // The first iteration is readable before the run finishes
+    auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_EQ(records[0]["Record"], "Timestamp");
+    EXPECT_EQ(records[0]["Command name"], "first");
+    EXPECT_EQ(records[1]["Command name"], "second");
+    EXPECT_EQ(records[2]["Record"], "Execution Time");
+    EXPECT_EQ(records[3]["Record"], "Timeline");
 
-    EXPECT_TRUE(profilingData.is_object());
-    EXPECT_TRUE(profilingData.empty());
+    writer.write(RuntimeProfilingData{{1000, 1100, 1200, 1400}, 2.0f, commands}, {}, 1);
+
+    records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 8);
+    EXPECT_EQ(records[4]["Iteration"], 2);
+    EXPECT_EQ(records[6]["Record"], "Execution Time");
+    EXPECT_DOUBLE_EQ(records[6]["Execution time [ms]"].get<double>(), 0.0008);
+    EXPECT_DOUBLE_EQ(records[6]["Total execution time [ms]"].get<double>(), 0.0011);
 }
 
-TEST(JsonWriter, WritesTotalExecutionTimeAcrossIterations) {
+TEST(JsonWriter, WritesTimelineOfEachIteration) {
     TempFolder tempFolder("scenario_runner_json_writer_tests");
-    const auto profilingPath = tempFolder.relative("runtime_profiling.json");
-    const std::vector<ProfiledCommand> commands{{"ComputeDispatch", "first"}, {"ComputeDispatch", "second"}};
+    const auto profilingPath = tempFolder.relative("timeline_profiling.jsonl");
+    const std::vector<ProfiledCommand> commands{{"ComputeDispatch", "first"}, {"DataGraphDispatch", "second"}};
+
+    ProfilingWriter writer(profilingPath);
+    writer.write(RuntimeProfilingData{{1000, 3000, 4000, 10000}, 1.0f, commands}, {}, 0);
+
+    const auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 4);
+    const auto &timeline = records[3];
+    EXPECT_EQ(timeline["Record"], "Timeline");
+    EXPECT_DOUBLE_EQ(timeline["Frame time [ms]"].get<double>(), 0.009);
+    EXPECT_DOUBLE_EQ(timeline["Gap time [ms]"].get<double>(), 0.001);
+    ASSERT_EQ(timeline["Gaps"].size(), 1);
+    EXPECT_EQ(timeline["Gaps"][0]["After command"], "first");
+    EXPECT_EQ(timeline["Gaps"][0]["Before command"], "second");
+    EXPECT_EQ(timeline["Top commands"][0]["Command name"], "second");
+    EXPECT_EQ(timeline["Critical path"], nlohmann::json::array({"first", "second"}));
+}
+
+TEST(JsonWriter, WritesPipelineStatisticsNextToTimestamps) {
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto profilingPath = tempFolder.relative("statistics_profiling.jsonl");
+    std::vector<ProfiledCommand> commands{{"ComputeDispatch", "add"}, {"DataGraphDispatch", "graph"}};
+    commands[0].pipelineStatistics = ProfiledPipelineStatistics{4000, 0};
+
+    ProfilingWriter writer(profilingPath);
+    writer.write(RuntimeProfilingData{{1000, 3000, 3000, 3500}, 1.0f, commands}, {}, 0);
+
+    const auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_EQ(records[0]["Compute shader invocations"], 4000);
+    EXPECT_EQ(records[0]["Fragment shader invocations"], 0);
+    EXPECT_DOUBLE_EQ(records[0]["Time per invocation [ns]"].get<double>(), 0.5);
+    EXPECT_FALSE(records[1].contains("Compute shader invocations"));
+}
+
+TEST(JsonWriter, WritesRecordingStatistics) {
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto profilingPath = tempFolder.relative("record_only_profiling.jsonl");
+    const CommandRecordingStats stats{120, 1, 7, 3, 3, 2, 4, 6};
+
+    ProfilingWriter writer(profilingPath);
+    writer.writeRecording(stats, 0);
+    writer.writeRecording(stats, 1);
+
+    const auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0]["Record"], "Recording");
+    EXPECT_EQ(records[0]["Recording time [us]"], 120);
+    EXPECT_EQ(records[0]["Commands recorded"], 7);
+    EXPECT_EQ(records[0]["Dispatches"], 3);
+    EXPECT_EQ(records[0]["Pipeline barriers"], 2);
+    EXPECT_EQ(records[0]["Barriers"], 4);
+    EXPECT_EQ(records[0]["Setup descriptor writes"], 6);
+    EXPECT_EQ(records[1]["Iteration"], 2);
+}
+
+TEST(JsonWriter, WritesMemoryReport) {
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto profilingPath = tempFolder.relative("memory_report_profiling.jsonl");
+    MemoryReport memoryReport;
+    memoryReport.resources.resize(2);
+    memoryReport.resources[0].type = "Tensor";
+    memoryReport.resources[0].name = "input";
+    memoryReport.resources[0].requestedBytes = 1024;
+    memoryReport.resources[0].allocatedBytes = 1024;
+    memoryReport.resources[0].stagingBytes = 1024;
+    memoryReport.resources[0].aliasGroup = 3;
+    memoryReport.resources[0].aliasCount = 2;
+    memoryReport.resources[1].type = "Buffer";
+    memoryReport.resources[1].name = "output";
+    memoryReport.resources[1].requestedBytes = 256;
+    memoryReport.resources[1].allocatedBytes = 256;
+    memoryReport.allocationCount = 5;
+    memoryReport.resourceBytes = 1280;
+    memoryReport.stagingBytes = 1280;
+    memoryReport.sessionMemoryBytes = 4096;
+    memoryReport.peakAllocatedBytes = 16384;
+    memoryReport.aliasingSavedBytes = 1024;
+    memoryReport.sessionSharingSavedBytes = 2048;
+    memoryReport.sessionAliasingSavedBytes = 4096;
+    memoryReport.heaps.push_back({0, 1 << 20, 1 << 19, 8192, 12288});
+    memoryReport.hostPeakResidentBytes = 1 << 24;
+    memoryReport.hostResidentBeforeReleaseBytes = 1 << 23;
+    memoryReport.hostResidentAfterReleaseBytes = 1 << 22;
+
+    ProfilingWriter writer(profilingPath);
+    writer.writeMemoryReport(memoryReport);
 
-    writeProfilingData(RuntimeProfilingData{{100, 150, 175, 250}, 2.0f, commands}, {}, profilingPath, 0, 2);
-    writeProfilingData(RuntimeProfilingData{{1000, 1100, 1200, 1400}, 2.0f, commands}, {}, profilingPath, 1, 2);
+    const auto records = readRecords(profilingPath);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0]["Record"], "Resource Memory");
+    EXPECT_EQ(records[0]["Resource name"], "input");
+    EXPECT_EQ(records[0]["Alias group"], 3);
+    EXPECT_EQ(records[0]["Staging size [bytes]"], 1024);
+    EXPECT_FALSE(records[1].contains("Alias group"));
+    EXPECT_EQ(records[2]["Record"], "Memory Summary");
+    EXPECT_EQ(records[2]["Device allocations"], 5);
+    EXPECT_EQ(records[2]["Total allocated device memory [bytes]"], 1280 + 1280 + 4096);
+    EXPECT_EQ(records[2]["Peak allocated device memory [bytes]"], 16384);
+    EXPECT_EQ(records[2]["Aliasing savings [bytes]"], 1024);
+    EXPECT_EQ(records[2]["Session sharing savings [bytes]"], 2048);
+    EXPECT_EQ(records[2]["Session aliasing savings [bytes]"], 4096);
+    EXPECT_EQ(records[2]["Heaps"][0]["Usage [bytes]"], 8192);
+    EXPECT_EQ(records[2]["Heaps"][0]["Peak usage [bytes]"], 12288);
+    EXPECT_FALSE(records[2].contains("Host resident memory [bytes]"));
+    EXPECT_EQ(records[2]["Peak host resident memory [bytes]"], 1 << 24);
+    EXPECT_EQ(records[2]["Host resident memory before release [bytes]"], 1 << 23);
+    EXPECT_EQ(records[2]["Host resident memory after release [bytes]"], 1 << 22);
+}
+
+TEST(JsonWriter, WritesPerfCounterStatistics) {
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto perfCountersPath = tempFolder.relative("perf_counters.json");
+    PerfCounterRegistry registry(2);
+    const auto setupId = registry.registerCounter("Parse VGF: model", PerfCategory::ScenarioSetup);
+    const auto waitId = registry.registerCounter("Wait for Fence", PerfCategory::RunScenario, false);
+    registry.record(setupId, 40);
+    for (int64_t value : {10, 20, 30}) {
+        registry.record(waitId, value);
+    }
+
+    writePerfCounters(registry, perfCountersPath);
+
+    std::ifstream dumpFile(perfCountersPath);
+    const auto perfCounters = nlohmann::json::parse(dumpFile);
+
+    EXPECT_EQ(perfCounters["Time to Inference"], 40);
+    EXPECT_EQ(perfCounters["Total Scenario Time"], 100);
+    ASSERT_TRUE(perfCounters.contains("Run Scenario"));
+    EXPECT_EQ(perfCounters["Run Scenario"]["total time"], 60);
+    ASSERT_EQ(perfCounters["Run Scenario"]["counters"].size(), 1);
+    const auto &wait = perfCounters["Run Scenario"]["counters"][0];
+    EXPECT_EQ(wait["name"], "Wait for Fence");
+    EXPECT_EQ(wait["count"], 3);
+    EXPECT_EQ(wait["sum"], 60);
+    EXPECT_EQ(wait["min"], 10);
+    EXPECT_EQ(wait["max"], 30);
+    EXPECT_EQ(wait["p50"], 20);
+    EXPECT_EQ(wait["samples"], nlohmann::json::array({20, 30}));
+    EXPECT_EQ(perfCounters["Scenario Setup"]["counters"][0]["count"], 1);
+}
+
+TEST(JsonWriter, WritesPipelineReport) {
+    TempFolder tempFolder("scenario_runner_json_writer_tests");
+    const auto reportPath = tempFolder.relative("pipeline_report.json");
+    PipelineReport compute{"conv", "Compute", true, true, 1500, {1200}, {}};
+    compute.executables.push_back({"Compute shader", "main", "Compute", 16, {}});
+    compute.executables[0].statistics.push_back({"Register count", "registers", uint64_t{32}});
+    compute.executables[0].statistics.push_back({"Spills", "spilled", false});
+    const PipelineReport graph{"graph", "DataGraph", false, false, 0, {}, {}};
 
-    std::ifstream dumpFile(profilingPath);
-    const auto profilingData = nlohmann::json::parse(dumpFile);
+    writePipelineReport({compute, graph}, reportPath);
 
-    ASSERT_TRUE(profilingData.contains("Total execution time [ms]"));
-    EXPECT_DOUBLE_EQ(profilingData["Total execution time [ms]"].get<double>(), 0.0011);
+    std::ifstream reportFile(reportPath);
+    const auto report = nlohmann::json::parse(reportFile);
+    const auto &pipelines = report["Pipelines"];
+    ASSERT_EQ(pipelines.size(), 2);
+    EXPECT_EQ(pipelines[0]["Pipeline name"], "conv");
+    EXPECT_EQ(pipelines[0]["Pipeline type"], "Compute");
+    EXPECT_EQ(pipelines[0]["Pipeline cache hit"], true);
+    EXPECT_EQ(pipelines[0]["Creation time [ns]"], 1500);
+    EXPECT_EQ(pipelines[0]["Stage creation times [ns]"], nlohmann::json::array({1200}));
+    ASSERT_EQ(pipelines[0]["Executables"].size(), 1);
+    const auto &executable = pipelines[0]["Executables"][0];
+    EXPECT_EQ(executable["subgroup size"], 16);
+    ASSERT_EQ(executable["statistics"].size(), 2);
+    EXPECT_EQ(executable["statistics"][0]["value"], 32);
+    EXPECT_EQ(executable["statistics"][1]["value"], false);
+    EXPECT_EQ(pipelines[1]["Creation feedback valid"], false);
+    EXPECT_TRUE(pipelines[1]["Executables"].empty());
 }
 
 } // namespace mlsdk::scenariorunner
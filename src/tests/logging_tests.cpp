@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright 2024-2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-FileCopyrightText: Copyright 2024-2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -9,6 +9,7 @@
 
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace mlsdk::logging;
@@ -65,3 +66,58 @@ TEST(Logging, MessageFiltering) {
 
     ASSERT_TRUE(std::equal(logMessages.begin(), logMessages.end(), expected.begin(), expected.end()));
 }
+
+TEST(Logging, MacroSkipsFilteredMessages) {
+    std::vector<std::string> logMessages;
+    setDefaultHandler([&logMessages](const std::string &, LogLevel, const std::string &message) {
+        logMessages.emplace_back(message);
+    });
+    setDefaultLoggerName("logger");
+    setDefaultLogLevel(LogLevel::Warning);
+
+    int evaluations = 0;
+    auto makeMessage = [&evaluations](const std::string &text) {
+        ++evaluations;
+        return text;
+    };
+
+    MLSDK_LOG_DEBUG(makeMessage("debug message"));
+    MLSDK_LOG_INFO(makeMessage("info message"));
+    MLSDK_LOG_WARNING(makeMessage("warning message"));
+    MLSDK_LOG_ERROR(makeMessage("error message"));
+
+    ASSERT_FALSE(isEnabled(LogLevel::Info));
+    ASSERT_TRUE(isEnabled(LogLevel::Warning));
+    ASSERT_EQ(evaluations, 2);
+    ASSERT_EQ(logMessages, (std::vector<std::string>{"warning message", "error message"}));
+}
+
+TEST(Logging, AsyncLoggingDeliversInOrder) {
+    std::vector<std::string> logMessages;
+    std::thread::id handlerThread;
+    setDefaultHandler([&logMessages, &handlerThread](const std::string &, LogLevel, const std::string &message) {
+        handlerThread = std::this_thread::get_id();
+        logMessages.emplace_back(message);
+    });
+    setDefaultLoggerName("logger");
+    setDefaultLogLevel(LogLevel::Debug);
+
+    setAsyncLogging(true);
+    std::vector<std::string> expected;
+    for (int idx = 0; idx < 100; ++idx) {
+        expected.emplace_back("message " + std::to_string(idx));
+        info(expected.back());
+    }
+    flush();
+
+    ASSERT_EQ(logMessages, expected);
+    ASSERT_NE(handlerThread, std::this_thread::get_id());
+
+    // Disabling delivers the remaining messages and goes back to logging on the calling thread
+    info("queued message");
+    setAsyncLogging(false);
+    ASSERT_EQ(logMessages.back(), "queued message");
+    info("synchronous message");
+    ASSERT_EQ(logMessages.back(), "synchronous message");
+    ASSERT_EQ(handlerThread, std::this_thread::get_id());
+}
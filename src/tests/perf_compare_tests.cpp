@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../perf_compare.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+std::string timestampRecord(const std::string &name, double timeMs, int iteration) {
+    return R"({"Record":"Timestamp","Command type":"ComputeDispatch","Command name":")" + name +
+           R"(","Time for command [ms]":)" + std::to_string(timeMs) + R"(,"Iteration":)" + std::to_string(iteration) +
+           "}\n";
+}
+
+PerfRun profilingRun(const std::vector<double> &firstTimesMs, double secondTimeMs) {
+    std::stringstream stream;
+    for (size_t idx = 0; idx < firstTimesMs.size(); ++idx) {
+        const auto iteration = static_cast<int>(idx) + 1;
+        stream << timestampRecord("add", firstTimesMs[idx], iteration);
+        stream << timestampRecord("add", secondTimeMs, iteration);
+    }
+    PerfRun run;
+    run.loadProfiling(stream);
+    return run;
+}
+
+const MetricComparison &findMetric(const std::vector<MetricComparison> &comparisons, const std::string &metric) {
+    for (const auto &comparison : comparisons) {
+        if (comparison.metric == metric) {
+            return comparison;
+        }
+    }
+    throw std::runtime_error("Missing metric " + metric);
+}
+
+} // namespace
+
+TEST(PerfCompare, MatchesRepeatedCommandsByOccurrence) {
+    const auto run = profilingRun({1.0, 3.0}, 5.0);
+    const auto &samples = run.getSamples();
+
+    ASSERT_EQ(samples.at("Command ComputeDispatch add [ms]"), (std::vector<double>{1.0, 3.0}));
+    ASSERT_EQ(samples.at("Command ComputeDispatch add #2 [ms]"), (std::vector<double>{5.0, 5.0}));
+    ASSERT_EQ(samples.at("Command type ComputeDispatch [ms]"), (std::vector<double>{6.0, 8.0}));
+}
+
+TEST(PerfCompare, FlagsSignificantSlowdowns) {
+    const auto baseline = profilingRun({1.0, 1.1, 0.9, 1.0}, 5.0);
+    const auto candidate = profilingRun({2.0, 2.1, 1.9, 2.0}, 5.1);
+
+    const auto comparisons = comparePerfRuns(baseline, candidate, 5.0);
+
+    const auto &slower = findMetric(comparisons, "Command ComputeDispatch add [ms]");
+    ASSERT_NEAR(*slower.deltaPercent, 100.0, 1e-9);
+    ASSERT_GT(*slower.ciLowPercent, 0.0);
+    ASSERT_TRUE(slower.regression);
+
+    // A constant 2% slowdown stays below the threshold
+    const auto &unchanged = findMetric(comparisons, "Command ComputeDispatch add #2 [ms]");
+    ASSERT_NEAR(*unchanged.deltaPercent, 2.0, 1e-9);
+    ASSERT_FALSE(unchanged.regression);
+
+    std::ostringstream table;
+    ASSERT_EQ(printComparisonTable(comparisons, table), 2U);
+    ASSERT_NE(table.str().find("REGRESSION"), std::string::npos);
+}
+
+TEST(PerfCompare, IgnoresSlowdownsWithinNoise) {
+    const auto baseline = profilingRun({1.0, 3.0, 1.0, 3.0}, 5.0);
+    const auto candidate = profilingRun({3.0, 1.0, 3.0, 1.5}, 5.0);
+
+    const auto comparisons = comparePerfRuns(baseline, candidate, 5.0);
+
+    const auto &noisy = findMetric(comparisons, "Command ComputeDispatch add [ms]");
+    ASSERT_GT(*noisy.deltaPercent, 5.0);
+    ASSERT_LT(*noisy.ciLowPercent, 0.0);
+    ASSERT_FALSE(noisy.regression);
+}
+
+TEST(PerfCompare, LoadsPerfCounterReports) {
+    std::stringstream baselineReport(R"({"Time to Inference": 100, "Total Scenario Time": 120, "unit": "microseconds",
+        "Pipeline Setup": {"total time": 80, "unit": "microseconds", "counters": [
+            {"name": "Create Pipeline", "count": 2, "sum": 80, "samples": [30, 50]}]}})");
+    std::stringstream candidateReport(R"({"Time to Inference": 150, "Total Scenario Time": 170, "unit": "microseconds",
+        "Pipeline Setup": {"total time": 120, "unit": "microseconds", "counters": [
+            {"name": "Create Pipeline", "count": 1, "sum": 120}]}})");
+    PerfRun baseline;
+    baseline.loadPerfCounters(baselineReport);
+    PerfRun candidate;
+    candidate.loadPerfCounters(candidateReport);
+
+    const auto comparisons = comparePerfRuns(baseline, candidate, 10.0);
+
+    ASSERT_EQ(comparisons.size(), 4U);
+    const auto &counter = findMetric(comparisons, "Counter Pipeline Setup/Create Pipeline [us]");
+    ASSERT_EQ(counter.baselineCount, 2U);
+    ASSERT_DOUBLE_EQ(counter.baselineMean, 40.0);
+    ASSERT_DOUBLE_EQ(counter.candidateMean, 120.0);
+    // A single candidate sample has no confidence interval, so the threshold alone decides
+    ASSERT_FALSE(counter.ciLowPercent.has_value());
+    ASSERT_TRUE(counter.regression);
+    ASSERT_TRUE(findMetric(comparisons, "Category Pipeline Setup [us]").regression);
+    ASSERT_TRUE(findMetric(comparisons, "Time to Inference [us]").regression);
+}
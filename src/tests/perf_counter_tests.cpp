@@ -4,6 +4,7 @@
  */
 
 #include <chrono>
+#include <stdexcept>
 #include <thread>
 
 #include "../perf_counter.hpp"
@@ -12,45 +13,87 @@
 
 using namespace mlsdk::scenariorunner;
 
-TEST(PerformanceCounter, RawStartStopAndReset) {
-    PerformanceCounter counter("RawCounter", "UnitTest", true);
+TEST(PerformanceCounter, HistogramBucketsRoundTrip) {
+    for (uint64_t value : {0ULL, 1ULL, 15ULL, 16ULL, 31ULL, 32ULL, 1000ULL, 123456789ULL, (1ULL << 62) + 5}) {
+        const auto index = LogLinearHistogram::bucketIndex(value);
+        ASSERT_LT(index, LogLinearHistogram::bucketCount);
+        const auto upperBound = LogLinearHistogram::bucketUpperBound(index);
+        ASSERT_GE(upperBound, value);
+        ASSERT_LE(upperBound - value, value / LogLinearHistogram::subBucketCount);
+    }
+}
 
-    counter.start();
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
-    counter.stop();
+TEST(PerformanceCounter, HistogramStatistics) {
+    LogLinearHistogram histogram;
+    ASSERT_EQ(histogram.count(), 0U);
+    ASSERT_EQ(histogram.percentile(50.0), 0);
 
-    const auto firstElapsed = counter.getElapsedTime();
-    ASSERT_GT(firstElapsed, 0);
+    for (int64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.count(), 100U);
+    ASSERT_EQ(histogram.sum(), 5050);
+    ASSERT_EQ(histogram.min(), 1);
+    ASSERT_EQ(histogram.max(), 100);
+    ASSERT_NEAR(histogram.percentile(50.0), 50, 50 / LogLinearHistogram::subBucketCount);
+    ASSERT_NEAR(histogram.percentile(99.0), 99, 99 / LogLinearHistogram::subBucketCount);
+    ASSERT_EQ(histogram.percentile(100.0), 100);
+    ASSERT_EQ(histogram.percentile(0.0), 1);
+}
 
-    counter.start();
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
-    counter.stop();
+TEST(PerformanceCounter, RegistryInternsNames) {
+    PerfCounterRegistry registry;
 
-    ASSERT_GT(counter.getElapsedTime(), firstElapsed);
+    const auto first = registry.registerCounter("Wait for Fence", PerfCategory::RunScenario, false);
+    const auto second = registry.registerCounter("Submit Commands", PerfCategory::RunScenario, false);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(registry.registerCounter("Wait for Fence", PerfCategory::RunScenario, false), first);
+    ASSERT_THROW(registry.registerCounter("Wait for Fence", PerfCategory::RunScenario, true), std::runtime_error);
+    ASSERT_THROW(registry.registerCounter("Wait for Fence", PerfCategory::SaveResults, false), std::runtime_error);
 
-    counter.reset();
-    ASSERT_EQ(counter.getElapsedTime(), 0);
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        registry.record(first, iteration);
+    }
+
+    const auto &counters = registry.getCounters();
+    ASSERT_EQ(counters.size(), 2U);
+    ASSERT_EQ(counters[first].name, "Wait for Fence");
+    ASSERT_EQ(counters[first].category, PerfCategory::RunScenario);
+    ASSERT_FALSE(counters[first].isPartOfTimeToInference);
+    ASSERT_EQ(counters[first].histogram.count(), 1000U);
+    ASSERT_EQ(counters[second].histogram.count(), 0U);
+    ASSERT_TRUE(registry.getRawSamples(first).empty());
 }
 
-TEST(PerformanceCounter, RawMetadata) {
-    PerformanceCounter counter("CounterName", "Scenario Setup", false);
+TEST(PerformanceCounter, RegistryKeepsBoundedRawSamples) {
+    PerfCounterRegistry registry(3);
+    const auto id = registry.registerCounter("Counter", PerfCategory::ScenarioSetup);
 
-    ASSERT_EQ(counter.getName(), "CounterName");
-    ASSERT_EQ(counter.getCategory(), "Scenario Setup");
-    ASSERT_FALSE(counter.isPartOfTimeToInference());
+    registry.record(id, 1);
+    registry.record(id, 2);
+    ASSERT_EQ(registry.getRawSamples(id), (std::vector<int64_t>{1, 2}));
+
+    for (int64_t value = 3; value <= 7; ++value) {
+        registry.record(id, value);
+    }
+    ASSERT_EQ(registry.getRawSamples(id), (std::vector<int64_t>{5, 6, 7}));
+    ASSERT_EQ(registry.getCounters()[id].histogram.count(), 7U);
 }
 
-TEST(PerformanceCounter, GuardStartsAndStopsCounter) {
-    std::vector<PerformanceCounter> counters;
+TEST(PerformanceCounter, GuardRecordsElapsedTime) {
+    PerfCounterRegistry registry;
 
-    {
-        PerfCounterGuard guard(counters, "GuardCounter", "UnitTest", false);
+    for (int iteration = 0; iteration < 2; ++iteration) {
+        PerfCounterGuard guard(registry, "GuardCounter", PerfCategory::SaveResults, false);
         std::this_thread::sleep_for(std::chrono::milliseconds(2));
     }
 
+    const auto &counters = registry.getCounters();
     ASSERT_EQ(counters.size(), 1U);
-    ASSERT_EQ(counters.front().getName(), "GuardCounter");
-    ASSERT_EQ(counters.front().getCategory(), "UnitTest");
-    ASSERT_FALSE(counters.front().isPartOfTimeToInference());
-    ASSERT_GT(counters.front().getElapsedTime(), 0);
+    ASSERT_EQ(counters.front().name, "GuardCounter");
+    ASSERT_EQ(perfCategoryName(counters.front().category), std::string("Save Results"));
+    ASSERT_FALSE(counters.front().isPartOfTimeToInference);
+    ASSERT_EQ(counters.front().histogram.count(), 2U);
+    ASSERT_GT(counters.front().histogram.min(), 0);
 }
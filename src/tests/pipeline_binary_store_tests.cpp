@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "pipeline_binary_store.hpp"
+
+#include "vgf-utils/temp_folder.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+size_t countFiles(const std::filesystem::path &directory, const std::string &extension) {
+    size_t count = 0;
+    for (const auto &file : std::filesystem::directory_iterator(directory)) {
+        if (file.path().extension() == extension) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(PipelineBinaryStore, KeysAreStableAndOrderSensitive) {
+    // Reference value of 64-bit FNV-1a for "a"
+    ASSERT_EQ(PipelineKey().add("a", 1).value(), 0xaf63dc4c8601ec8cULL);
+
+    const auto key = PipelineKey().add(uint32_t{1}).add(std::string("main")).value();
+    ASSERT_EQ(PipelineKey().add(uint32_t{1}).add(std::string("main")).value(), key);
+    ASSERT_NE(PipelineKey().add(std::string("main")).add(uint32_t{1}).value(), key);
+    ASSERT_NE(PipelineKey().add(std::string("ab")).add(std::string("c")).value(),
+              PipelineKey().add(std::string("a")).add(std::string("bc")).value());
+    ASSERT_NE(PipelineKey().add(std::vector<uint32_t>{1, 2}).value(),
+              PipelineKey().add(std::vector<uint32_t>{1, 2, 0}).value());
+}
+
+TEST(PipelineBinaryStore, SavesOnlyNewEntries) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("new_entries.cache");
+    {
+        PipelineBinaryStore store(directory, 1024);
+        ASSERT_TRUE(store.empty());
+        ASSERT_FALSE(store.find(1).has_value());
+        // Nothing to write, so the directory is not created
+        ASSERT_EQ(store.save().written, 0U);
+        ASSERT_FALSE(std::filesystem::exists(directory));
+
+        store.insert(1, {1, 2, 3});
+        store.insert(2, {4, 5});
+        ASSERT_EQ(store.newEntries(), 2U);
+        ASSERT_EQ(store.find(2), (std::vector<uint8_t>{4, 5}));
+        ASSERT_EQ(store.save().written, 2U);
+        ASSERT_EQ(store.newEntries(), 0U);
+        ASSERT_EQ(countFiles(directory, ".bin"), 2U);
+        ASSERT_EQ(countFiles(directory, ".tmp"), 0U);
+    }
+
+    PipelineBinaryStore store(directory, 1024);
+    ASSERT_EQ(store.size(), 2U);
+    ASSERT_EQ(store.totalSize(), 5U);
+    ASSERT_EQ(store.find(1), (std::vector<uint8_t>{1, 2, 3}));
+    // Recording the use of entry 1 rewrites the index once, further uses in the same run do not
+    ASSERT_EQ(store.save().written, 0U);
+    ASSERT_EQ(store.find(1), (std::vector<uint8_t>{1, 2, 3}));
+    const auto indexTime = std::filesystem::last_write_time(directory / "index.json");
+    ASSERT_EQ(store.save().written, 0U);
+    ASSERT_EQ(std::filesystem::last_write_time(directory / "index.json"), indexTime);
+
+    store.clear();
+    ASSERT_TRUE(store.empty());
+    ASSERT_FALSE(std::filesystem::exists(directory / "index.json"));
+    ASSERT_EQ(countFiles(directory, ".bin"), 0U);
+}
+
+TEST(PipelineBinaryStore, EvictsLeastRecentlyUsedEntries) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("eviction.cache");
+    {
+        PipelineBinaryStore store(directory, 10);
+        store.insert(1, std::vector<uint8_t>(4, 1));
+        store.insert(2, std::vector<uint8_t>(4, 2));
+        ASSERT_EQ(store.save().written, 2U);
+    }
+    {
+        // Entry 1 is used again while entry 2 is not, so entry 2 goes when entry 3 exceeds the cap
+        PipelineBinaryStore store(directory, 10);
+        ASSERT_TRUE(store.find(1).has_value());
+        store.insert(3, std::vector<uint8_t>(4, 3));
+        const auto stats = store.save();
+        ASSERT_EQ(stats.written, 1U);
+        ASSERT_EQ(stats.total, 2U);
+        ASSERT_EQ(store.size(), 2U);
+    }
+
+    PipelineBinaryStore store(directory, 10);
+    ASSERT_EQ(store.size(), 2U);
+    ASSERT_TRUE(store.find(1).has_value());
+    ASSERT_FALSE(store.find(2).has_value());
+    ASSERT_TRUE(store.find(3).has_value());
+    ASSERT_EQ(countFiles(directory, ".bin"), 2U);
+}
+
+TEST(PipelineBinaryStore, RecordsUseOfEntriesInRunsWithoutNewEntries) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("recency.cache");
+    {
+        PipelineBinaryStore store(directory, 10);
+        store.insert(1, std::vector<uint8_t>(4, 1));
+        ASSERT_EQ(store.save().written, 1U);
+        store.insert(2, std::vector<uint8_t>(4, 2));
+        ASSERT_EQ(store.save().written, 1U);
+    }
+    {
+        // Only hits the store, yet makes the older entry 1 more recently used than entry 2
+        PipelineBinaryStore store(directory, 10);
+        ASSERT_TRUE(store.find(1).has_value());
+        ASSERT_EQ(store.save().written, 0U);
+    }
+    {
+        PipelineBinaryStore store(directory, 10);
+        store.insert(3, std::vector<uint8_t>(4, 3));
+        ASSERT_EQ(store.save().total, 2U);
+    }
+
+    PipelineBinaryStore store(directory, 10);
+    ASSERT_TRUE(store.find(1).has_value());
+    ASSERT_FALSE(store.find(2).has_value());
+    ASSERT_TRUE(store.find(3).has_value());
+}
+
+TEST(PipelineBinaryStore, SkipsInvalidEntriesAndIndex) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("invalid.cache");
+    {
+        PipelineBinaryStore store(directory, 1024);
+        store.insert(1, {1, 2, 3});
+        store.insert(2, {4, 5, 6});
+        store.save();
+    }
+    std::filesystem::resize_file(directory / "0000000000000001.bin", 2);
+
+    {
+        PipelineBinaryStore store(directory, 1024);
+        ASSERT_FALSE(store.find(1).has_value());
+        ASSERT_EQ(store.size(), 1U);
+        ASSERT_EQ(store.find(2), (std::vector<uint8_t>{4, 5, 6}));
+    }
+
+    std::ofstream(directory / "index.json") << R"({"version": "1", "entries": {}})";
+    ASSERT_TRUE(PipelineBinaryStore(directory, 1024).empty());
+
+    std::ofstream(directory / "index.json") << "not an index";
+    PipelineBinaryStore store(directory, 1024);
+    ASSERT_TRUE(store.empty());
+}
+
+TEST(PipelineBinaryStore, MergesEntriesSavedByOtherStores) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("merge.cache");
+
+    // Both stores start from the same empty directory, as concurrent runs sharing a cache path do
+    PipelineBinaryStore first(directory, 1024);
+    PipelineBinaryStore second(directory, 1024);
+    first.insert(1, {1});
+    second.insert(2, {2});
+    second.insert(3, {3});
+
+    auto stats = first.save();
+    ASSERT_EQ(stats.written, 1U);
+    ASSERT_EQ(stats.merged, 0U);
+    stats = second.save();
+    ASSERT_EQ(stats.written, 2U);
+    ASSERT_EQ(stats.merged, 1U);
+    ASSERT_EQ(stats.total, 3U);
+    ASSERT_EQ(second.find(1), (std::vector<uint8_t>{1}));
+
+    PipelineBinaryStore reloaded(directory, 1024);
+    ASSERT_EQ(reloaded.size(), 3U);
+    ASSERT_EQ(reloaded.find(3), (std::vector<uint8_t>{3}));
+}
+
+TEST(PipelineBinaryStore, ConcurrentSavesKeepEveryEntry) {
+    TempFolder tempFolder("scenario_runner_pipeline_binary_store_tests");
+    const auto directory = tempFolder.relative("concurrent.cache");
+    constexpr uint64_t storeCount = 8;
+    constexpr uint64_t entriesPerStore = 16;
+
+    std::vector<std::thread> threads;
+    for (uint64_t storeIdx = 0; storeIdx < storeCount; ++storeIdx) {
+        threads.emplace_back([&directory, storeIdx] {
+            PipelineBinaryStore store(directory, 1024 * 1024);
+            for (uint64_t idx = 0; idx < entriesPerStore; ++idx) {
+                store.insert(storeIdx * entriesPerStore + idx, std::vector<uint8_t>(8, uint8_t(storeIdx)));
+                // Interleave the saves of the stores
+                if (idx % 4 == 3) {
+                    store.save();
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    PipelineBinaryStore store(directory, 1024 * 1024);
+    ASSERT_EQ(store.size(), storeCount * entriesPerStore);
+    ASSERT_EQ(countFiles(directory, ".bin"), storeCount * entriesPerStore);
+    ASSERT_EQ(countFiles(directory, ".tmp"), 0U);
+    for (uint64_t key = 0; key < storeCount * entriesPerStore; ++key) {
+        ASSERT_EQ(store.find(key), std::vector<uint8_t>(8, uint8_t(key / entriesPerStore)));
+    }
+}
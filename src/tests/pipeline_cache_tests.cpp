@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "pipeline_cache.hpp"
+
+using namespace mlsdk::scenariorunner;
+
+TEST(PipelineCreationFeedback, FlagsAreClearedBeforeCreation) {
+    PipelineCreationFeedback feedback;
+    auto *createInfo = feedback.getCreateInfo(PipelineType::Graphics);
+    ASSERT_EQ(createInfo->pipelineStageCreationFeedbackCount, 2U);
+    ASSERT_FALSE(static_cast<bool>(feedback.pipeline().flags & vk::PipelineCreationFeedbackFlagBits::eValid));
+    for (const auto &stageFeedback : feedback.stages()) {
+        ASSERT_FALSE(static_cast<bool>(stageFeedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid));
+    }
+
+    // Feedback the driver filled in for a previous pipeline must not be reported for the next one
+    createInfo->pPipelineCreationFeedback->flags = vk::PipelineCreationFeedbackFlagBits::eValid |
+                                                   vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit;
+    createInfo->pPipelineStageCreationFeedbacks[0].flags = vk::PipelineCreationFeedbackFlagBits::eValid;
+    ASSERT_TRUE(feedback.wasPipelineCacheHit());
+
+    feedback.getCreateInfo(PipelineType::Compute);
+    ASSERT_EQ(feedback.stages().size(), 1U);
+    ASSERT_FALSE(static_cast<bool>(feedback.pipeline().flags & vk::PipelineCreationFeedbackFlagBits::eValid));
+    ASSERT_FALSE(static_cast<bool>(feedback.stages()[0].flags & vk::PipelineCreationFeedbackFlagBits::eValid));
+    ASSERT_FALSE(feedback.wasPipelineCacheHit());
+}
@@ -7,10 +7,12 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace mlsdk::scenariorunner;
 
@@ -70,7 +72,9 @@ TEST(ResourceManager, PreservesResourceInfo) {
     const auto rawDataId = resources.addRawData({"raw_data", "data.npy"});
     const auto dataGraphId = resources.addDataGraph({"data_graph", "graph.vgf", 0, {}});
     GraphConstantInfo graphConstant{"constant", vk::Format::eR32Sint, {2}};
-    graphConstant.data = {1, 2, 3, 4, 5, 6, 7, 8};
+    const auto constantData = std::make_shared<std::vector<uint8_t>>(std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8});
+    graphConstant.data = std::shared_ptr<const uint8_t>(constantData, constantData->data());
+    graphConstant.size = constantData->size();
     const auto graphConstantId = resources.addGraphConstant(std::move(graphConstant));
 
     EXPECT_EQ(resources.get(rawDataId).debugName, "raw_data");
@@ -80,7 +84,15 @@ TEST(ResourceManager, PreservesResourceInfo) {
     EXPECT_EQ(resources.get(graphConstantId).debugName, "constant");
     EXPECT_EQ(resources.get(graphConstantId).format, vk::Format::eR32Sint);
     EXPECT_EQ(resources.get(graphConstantId).dims, std::vector<int64_t>({2}));
-    EXPECT_EQ(resources.get(graphConstantId).data.size(), 8U);
+    EXPECT_EQ(resources.get(graphConstantId).size, 8U);
+    EXPECT_EQ(resources.get(graphConstantId).data.get(), constantData->data());
+
+    // The resource manager and the test share the data until the views are released
+    EXPECT_EQ(constantData.use_count(), 2);
+    resources.releaseGraphConstantData();
+    EXPECT_EQ(constantData.use_count(), 1);
+    EXPECT_EQ(resources.get(graphConstantId).data, nullptr);
+    EXPECT_EQ(resources.get(graphConstantId).dims, std::vector<int64_t>({2}));
 }
 
 TEST(ResourceManager, IteratesTypedIdsWithResourceInfo) {
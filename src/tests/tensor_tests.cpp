@@ -35,6 +35,39 @@ size_t bytesFor(vk::Format format, const std::vector<int64_t> &shape) {
     return static_cast<size_t>(elementSizeFromVkFormat(format) * totalElementsFromShape(shape));
 }
 
+TEST(TensorPacking, PacksPaddedRows) {
+    const std::vector<int64_t> shape{1, 2, 2, 3};
+    const std::vector<int64_t> strides{32, 16, 8, 2};
+    std::vector<char> strided(32, 0);
+    for (int64_t b = 0; b < 2; ++b) {
+        for (int64_t c = 0; c < 2; ++c) {
+            for (int64_t d = 0; d < 3; ++d) {
+                const auto value = static_cast<char>((b * 2 + c) * 3 + d);
+                strided[static_cast<size_t>(b * 16 + c * 8 + d * 2)] = value;
+                strided[static_cast<size_t>(b * 16 + c * 8 + d * 2 + 1)] = static_cast<char>(value + 100);
+            }
+        }
+    }
+
+    const auto packed = packStridedTensorData(strided.data(), shape, strides, 2);
+
+    ASSERT_EQ(packed.size(), 24);
+    for (size_t element = 0; element < 12; ++element) {
+        EXPECT_EQ(packed[element * 2], static_cast<char>(element));
+        EXPECT_EQ(packed[element * 2 + 1], static_cast<char>(element + 100));
+    }
+}
+
+TEST(TensorPacking, PacksInterleavedElements) {
+    const std::vector<int64_t> shape{1, 1, 2, 2};
+    const std::vector<int64_t> strides{8, 8, 4, 2};
+    const std::vector<char> strided{0, -1, 1, -1, 2, -1, 3, -1};
+
+    const auto packed = packStridedTensorData(strided.data(), shape, strides, 1);
+
+    EXPECT_EQ(packed, (std::vector<char>{0, 1, 2, 3}));
+}
+
 TEST(TensorInMemoryTransfer, UploadThrowsOnShapeMismatch) {
     ScenarioOptions opts{};
     Context ctx{opts};
@@ -23,3 +23,24 @@ def test_graph_profiling_dump_dir_requires_existing_directory(
         )
 
     assert "Invalid graph profiling dump directory:" in (exc_info.value.stderr or "")
+
+
+def test_alias_session_memory_rejects_session_memory_dump(
+    scenario_runner, resources_helper
+):
+    scenario = resources_helper.get_scenario_path("test_shader/add_shader.json")
+    dump_dir = resources_helper.get_testenv_path("session_memory_dump")
+    dump_dir.mkdir()
+
+    with pytest.raises(subprocess.CalledProcessError) as exc_info:
+        scenario_runner.run(
+            "--scenario",
+            scenario,
+            "--alias-session-memory",
+            "--session-memory-dump-dir",
+            dump_dir,
+        )
+
+    assert "--alias-session-memory cannot be combined with" in (
+        exc_info.value.stderr or ""
+    )
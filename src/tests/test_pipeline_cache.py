@@ -18,6 +18,15 @@ pytestmark = pytest.mark.pipeline_cache
 PIPELINE_CACHE_HEADER_SIZE = 32
 
 
+def _cache_entries(cache_path):
+    """Return the entry files of the single per-scenario store in cache_path."""
+    stores = list(cache_path.iterdir())
+    assert len(stores) == 1 and stores[0].suffix == ".cache" and stores[0].is_dir()
+    assert (stores[0] / "index.json").is_file()
+    assert not list(stores[0].glob("*.tmp"))
+    return sorted(stores[0].glob("*.bin"))
+
+
 def _seed_real_pipeline_cache_file(
     sdk_tools, resources_helper, numpy_helper, cache_path, target_scenario
 ):
@@ -47,9 +56,9 @@ def _seed_real_pipeline_cache_file(
     target_cache_name = (
         f"{os.path.splitext(os.path.basename(target_scenario))[0]}.cache"
     )
-    target_cache_file = cache_path / target_cache_name
-    assert target_cache_file.is_file()
-    assert target_cache_file.stat().st_size > 0
+    target_cache_dir = cache_path / target_cache_name
+    assert (target_cache_dir / "index.json").is_file()
+    assert any(entry.stat().st_size > 0 for entry in target_cache_dir.glob("*.bin"))
 
 
 def _setup_compute_pipeline_cache_miss(sdk_tools, resources_helper, numpy_helper):
@@ -236,16 +245,14 @@ def test_enable_pipeline_cache(sdk_tools, resources_helper, numpy_helper, capfd)
         and first_dispatch_idx != -1
         and first_store_idx < first_dispatch_idx
     )
-    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 2
+    # All pipelines are created during setup, so the final save has nothing new to write
+    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 1
 
     result_first = numpy_helper.load("outBufferAdd2.npy", np.float32)
     assert np.array_equal(result_first, input1 + input2 + input2)
 
-    files = list(cache_path.iterdir())
-    assert len(files) == 1 and files[0].suffix == ".cache"
-
-    cache_data_first = files[0].read_bytes()
-    assert len(cache_data_first) >= PIPELINE_CACHE_HEADER_SIZE
+    entries_first = _cache_entries(cache_path)
+    assert entries_first and all(entry.stat().st_size > 0 for entry in entries_first)
 
     # Run the second time and verify the cache file is accepted.
     sdk_tools.run_scenario(
@@ -260,16 +267,13 @@ def test_enable_pipeline_cache(sdk_tools, resources_helper, numpy_helper, capfd)
     captured = capfd.readouterr()
     assert "[Scenario-Runner] INFO: Pipeline Cache cleared" not in captured.out
     assert "[Scenario-Runner] INFO: Pipeline Cache loaded" in captured.out
-    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 2
+    # Every pipeline was found, so no entry is written again
+    assert "[Scenario-Runner] INFO: Pipeline Cache stored" not in captured.out
 
     result_second = numpy_helper.load("outBufferAdd2.npy", np.float32)
     assert np.array_equal(result_second, result_first)
 
-    files = list(cache_path.iterdir())
-    assert len(files) == 1 and files[0].suffix == ".cache"
-
-    cache_data_second = files[0].read_bytes()
-    assert len(cache_data_second) > 0
+    assert _cache_entries(cache_path) == entries_first
 
     # run the third time and see that cache is cleared
     sdk_tools.run_scenario(
@@ -285,16 +289,12 @@ def test_enable_pipeline_cache(sdk_tools, resources_helper, numpy_helper, capfd)
     captured = capfd.readouterr()
     assert "[Scenario-Runner] INFO: Pipeline Cache cleared" in captured.out
     assert "[Scenario-Runner] INFO: Pipeline Cache loaded" not in captured.out
-    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 2
+    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 1
 
     result_third = numpy_helper.load("outBufferAdd2.npy", np.float32)
     assert np.array_equal(result_third, result_first)
 
-    files = list(cache_path.iterdir())
-    assert len(files) == 1 and files[0].suffix == ".cache"
-
-    cache_data_third = files[0].read_bytes()
-    assert len(cache_data_third) > 0
+    assert len(_cache_entries(cache_path)) == len(entries_first)
 
 
 def test_pipeline_cache_hit(sdk_tools, resources_helper, numpy_helper, capfd):
@@ -309,13 +309,10 @@ def test_pipeline_cache_hit(sdk_tools, resources_helper, numpy_helper, capfd):
     options = ["--pipeline-caching", "--cache-path", cache_path, "--dry-run"]
     sdk_tools.run_scenario(scenario, replacements, options=options)
 
-    cache_files = list(cache_path.glob("*.cache"))
-    assert len(cache_files) == 1
-    cache_data = cache_files[0].read_bytes()
-    assert len(cache_data) >= PIPELINE_CACHE_HEADER_SIZE
-    header_size = int.from_bytes(cache_data[:4], byteorder=sys.byteorder)
-    assert header_size == PIPELINE_CACHE_HEADER_SIZE
-    if len(cache_data) == header_size:
+    entries = _cache_entries(cache_path)
+    assert len(entries) == 1
+    # Entries hold either pipeline binaries or the data of a pipeline cache, which starts with its header
+    if entries[0].stat().st_size <= PIPELINE_CACHE_HEADER_SIZE:
         pytest.skip("Vulkan driver did not serialize a pipeline cache payload")
 
     capfd.readouterr()
@@ -354,13 +351,12 @@ def test_pipeline_cache_dry_run_precompiles(
     )
 
     captured = capfd.readouterr()
-    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 2
+    assert captured.out.count("[Scenario-Runner] INFO: Pipeline Cache stored") == 1
     assert "[Scenario-Runner] INFO: Dispatch compute" not in captured.out
     assert not (resources_helper.get_testenv_path() / "outBufferAdd2.npy").exists()
 
-    files = list(cache_path.iterdir())
-    assert len(files) == 1 and files[0].suffix == ".cache"
-    assert files[0].stat().st_size > 0
+    entries = _cache_entries(cache_path)
+    assert entries and all(entry.stat().st_size > 0 for entry in entries)
 
 
 def test_incorrect_pipeline_cache(sdk_tools, resources_helper, numpy_helper, capfd):
@@ -389,10 +385,9 @@ def test_incorrect_pipeline_cache(sdk_tools, resources_helper, numpy_helper, cap
     result_first = numpy_helper.load("outBufferAdd2.npy", np.float32)
     assert np.array_equal(result_first, input1 + input2 + input2)
 
-    files = list(cache_path.iterdir())
-    assert len(files) == 1 and files[0].suffix == ".cache"
-    with open(files[0], "wb") as fout:
-        fout.write(os.urandom(1024))
+    # Keep the sizes recorded in the index so the junk reaches the pipeline cache validation
+    for entry in _cache_entries(cache_path):
+        entry.write_bytes(os.urandom(entry.stat().st_size))
 
     # run the second time with junk cache
     sdk_tools.run_scenario(
@@ -405,8 +400,45 @@ def test_incorrect_pipeline_cache(sdk_tools, resources_helper, numpy_helper, cap
     )
 
     captured = capfd.readouterr()
-    assert (
-        "WARNING: Pipeline validation: Incorrect pipeline cache header size"
-        in captured.out
+    assert "WARNING: Pipeline Cache entry skipped" in captured.out
+    # The rejected entries are compiled and stored again
+    assert "[Scenario-Runner] INFO: Pipeline Cache stored" in captured.out
+
+    result_second = numpy_helper.load("outBufferAdd2.npy", np.float32)
+    assert np.array_equal(result_second, result_first)
+
+
+def test_pipeline_cache_size_cap(sdk_tools, resources_helper, numpy_helper, capfd):
+    numpy_helper.generate([10], dtype=np.float32, filename="inBufferA.npy")
+    numpy_helper.generate([10], dtype=np.float32, filename="inBufferB.npy")
+
+    sdk_tools.compile_shader("test_shader/add_shader.comp", {"TestType": "float"})
+
+    cache_path = resources_helper.get_testenv_path("pipeline_cache_size_cap")
+    cache_path.mkdir()
+
+    options = ["--pipeline-caching", "--cache-path", cache_path, "--dry-run"]
+    sdk_tools.run_scenario(
+        "test_pipeline_cache/enable_pipeline_cache.json", options=options
+    )
+    entries = _cache_entries(cache_path)
+    assert entries
+    capfd.readouterr()
+
+    # Entries that do not fit into the cap are evicted on save, least recently used first
+    store = entries[0].parent
+    index = json.loads((store / "index.json").read_text())
+    index["entries"]["ffffffffffffffff"] = {"size": 2 * 1024 * 1024, "last use": 0}
+    (store / "index.json").write_text(json.dumps(index))
+    (store / "ffffffffffffffff.bin").write_bytes(bytes(2 * 1024 * 1024))
+    entries[0].unlink()
+
+    sdk_tools.run_scenario(
+        "test_pipeline_cache/enable_pipeline_cache.json",
+        options=[*options, "--pipeline-cache-max-size", "1"],
     )
-    assert "WARNING: Pipeline Cache skipped: failed to validate" in captured.out
+
+    captured = capfd.readouterr()
+    assert "Pipeline Cache evicted 1 least recently used entries" in captured.out
+    assert not (store / "ffffffffffffffff.bin").exists()
+    assert len(_cache_entries(cache_path)) == len(entries)
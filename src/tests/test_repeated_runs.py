@@ -4,7 +4,6 @@
 # SPDX-License-Identifier: Apache-2.0
 #
 import io
-import json
 import os
 
 import numpy as np
@@ -154,11 +153,10 @@ def test_conv2d_vgf_count(sdk_tools, resources_helper, numpy_helper):
         options=["--dry-run", "--profiling-dump-path", dry_run_dump_path.as_posix()],
     )
 
-    with open(dry_run_dump_path, encoding="utf-8") as dump_file:
-        dry_run_profiling_data = json.load(dump_file)
-
-    dry_run_memory_usages = dry_run_profiling_data["Memory Usage"]
-    assert "Timestamps" not in dry_run_profiling_data
+    dry_run_memory_usages = resources_helper.load_profiling_records(
+        dry_run_dump_path, "Memory Usage"
+    )
+    assert not resources_helper.load_profiling_records(dry_run_dump_path, "Timestamp")
     assert len(dry_run_memory_usages) == 1
     assert dry_run_memory_usages[0]["Command name"] == expected_command_name
     assert not resources_helper.get_testenv_path("conv2dOutput.npy").exists()
@@ -169,11 +167,8 @@ def test_conv2d_vgf_count(sdk_tools, resources_helper, numpy_helper):
         options=["--repeat", "2", "--profiling-dump-path", dump_path],
     )
 
-    with open(dump_path, encoding="utf-8") as dump_file:
-        profiling_data = json.load(dump_file)
-
-    timestamps = profiling_data["Timestamps"]
-    memory_usages = profiling_data["Memory Usage"]
+    timestamps = resources_helper.load_profiling_records(dump_path, "Timestamp")
+    memory_usages = resources_helper.load_profiling_records(dump_path, "Memory Usage")
     assert len(timestamps) == 2
     assert len(memory_usages) == 2
     assert all(
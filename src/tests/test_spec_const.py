@@ -3,6 +3,8 @@
 # SPDX-FileCopyrightText: Copyright 2025-2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
 # SPDX-License-Identifier: Apache-2.0
 #
+import json
+
 import numpy as np
 import pytest
 
@@ -139,3 +141,40 @@ def test_compute_shader_spirv_passthrough_spec_const_value(
     result = numpy_helper.load("out_data.npy", dtype)
 
     assert result == expected_result
+
+
+def test_compute_shader_tuning_candidates(sdk_tools, resources_helper, numpy_helper):
+    sdk_tools.compile_shader("test_spec_const/int_shader.comp")
+
+    # Without tuning, the shader keeps its specialization constants
+    sdk_tools.run_scenario("test_spec_const/int_tuning_glsl.json")
+    assert numpy_helper.load("out_data.npy", np.int32) == -42
+
+    database_path = resources_helper.get_testenv_path("tuning.json")
+    sdk_tools.run_scenario(
+        "test_spec_const/int_tuning_glsl.json",
+        options=[
+            "--tune",
+            "--tuning-repeats",
+            "2",
+            "--tuning-database",
+            database_path.as_posix(),
+        ],
+    )
+    tuned_result = numpy_helper.load("out_data.npy", np.int32)
+
+    with open(database_path) as database_file:
+        database = json.load(database_file)
+    assert len(database["devices"]) == 1
+    (results,) = database["devices"].values()
+    assert len(results) == 1
+    (result,) = results.values()
+    assert result["shader"] == "int_shader"
+    assert tuned_result == -1 - result["candidate"]
+
+    # Later runs apply the stored candidate without tuning
+    sdk_tools.run_scenario(
+        "test_spec_const/int_tuning_glsl.json",
+        options=["--tuning-database", database_path.as_posix()],
+    )
+    assert numpy_helper.load("out_data.npy", np.int32) == tuned_result
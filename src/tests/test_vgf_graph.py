@@ -4,6 +4,7 @@
 # SPDX-License-Identifier: Apache-2.0
 #
 import io
+import json
 import subprocess
 
 import numpy as np
@@ -21,8 +22,8 @@ pretendVulkanHeaderVersion = 123
 pytestmark = pytest.mark.vgf_graph
 
 
-def test_conv2d_vgf(sdk_tools, resources_helper, numpy_helper):
-
+def write_conv2d_vgf(sdk_tools, resources_helper):
+    """Writes conv2d.vgf with one conv2d graph segment and its constant."""
     conv2d_spv_path = sdk_tools.assemble_spirv(
         "test_vgf_graph/conv2d.spvasm",
         {
@@ -66,7 +67,7 @@ def test_conv2d_vgf(sdk_tools, resources_helper, numpy_helper):
 
     constantRef0 = encoder.AddConstant(constantResource0, constantData0)
 
-    segment0 = encoder.AddSegmentInfo(
+    encoder.AddSegmentInfo(
         module0,
         "conv2d_graph_segment",
         [conv2dDescSetInfo],
@@ -81,6 +82,12 @@ def test_conv2d_vgf(sdk_tools, resources_helper, numpy_helper):
     assert encoder.WriteTo(vgfStream)
     vgfStream.close()
 
+    return module0, conv2dCode
+
+
+def test_conv2d_vgf(sdk_tools, resources_helper, numpy_helper):
+    module0, conv2dCode = write_conv2d_vgf(sdk_tools, resources_helper)
+
     vgfStream = io.FileIO(resources_helper.get_testenv_path("conv2d.vgf"), mode="rb")
     buffer = memoryview(vgfStream.read())
 
@@ -361,8 +368,8 @@ def test_external_binding_resolves_model_output_with_shader_local_binding(
     )
 
 
-def test_maxpool_conv2d_parallel_vgf(sdk_tools, resources_helper, numpy_helper):
-
+def write_maxpool_conv2d_vgf(sdk_tools, resources_helper):
+    """Writes a VGF with independent maxpool and conv2d graph segments."""
     maxpool_spv_path = sdk_tools.assemble_spirv(
         "test_vgf_graph/maxpool.spvasm",
         {
@@ -457,6 +464,14 @@ def test_maxpool_conv2d_parallel_vgf(sdk_tools, resources_helper, numpy_helper):
     assert encoder.WriteTo(vgfStream)
     vgfStream.close()
 
+    return module0, module1, maxpoolCode, conv2dCode
+
+
+def test_maxpool_conv2d_parallel_vgf(sdk_tools, resources_helper, numpy_helper):
+    module0, module1, maxpoolCode, conv2dCode = write_maxpool_conv2d_vgf(
+        sdk_tools, resources_helper
+    )
+
     vgfStream = io.FileIO(
         resources_helper.get_testenv_path("multiple_modules.vgf"), mode="rb"
     )
@@ -495,3 +510,169 @@ def test_maxpool_conv2d_parallel_vgf(sdk_tools, resources_helper, numpy_helper):
     )
 
     sdk_tools.run_scenario("test_vgf_graph/maxpool_conv2d.json")
+
+
+def test_conv2d_vgf_shared_across_dispatches(
+    sdk_tools, resources_helper, numpy_helper
+):
+    write_conv2d_vgf(sdk_tools, resources_helper)
+
+    # Both dispatches bind tensors of the same description, so they share one pipeline
+    input = numpy_helper.generate(
+        [1, 16, 16, 16], dtype=np.int8, filename="conv2dInput0.npy"
+    )
+    numpy_helper.save(input, "conv2dInput1.npy")
+    report_path = resources_helper.get_testenv_path("pipeline_report.json")
+    dump_path = resources_helper.get_testenv_path("sharedPipeline.json")
+
+    sdk_tools.run_scenario(
+        "test_vgf_graph/conv2d_shared.json",
+        options=[
+            "--pipeline-report-path",
+            report_path,
+            "--profiling-dump-path",
+            dump_path.as_posix(),
+        ],
+    )
+
+    report = json.loads(report_path.read_text())
+    assert len(report["Pipelines"]) == 1
+    assert np.array_equal(
+        numpy_helper.load("conv2dOutput0.npy"), numpy_helper.load("conv2dOutput1.npy")
+    )
+    summaries = resources_helper.load_profiling_records(dump_path, "Memory Summary")
+    assert len(summaries) == 1
+    assert summaries[0]["Session sharing savings [bytes]"] > 0
+
+
+def test_maxpool_conv2d_vgf_alias_session_memory(
+    sdk_tools, resources_helper, numpy_helper
+):
+    write_maxpool_conv2d_vgf(sdk_tools, resources_helper)
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="maxpoolInput.npy")
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="conv2dInput.npy")
+
+    default_dump_path = resources_helper.get_testenv_path("defaultSessionMemory.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=["--profiling-dump-path", default_dump_path.as_posix()],
+    )
+    maxpoolOutput = numpy_helper.load("maxpoolOutput.npy")
+    conv2dOutput = numpy_helper.load("conv2dOutput.npy")
+
+    # Implicit barriers separate the segments, so their sessions alias one allocation
+    dump_path = resources_helper.get_testenv_path("aliasSessionMemory.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=[
+            "--alias-session-memory",
+            "--profiling-dump-path",
+            dump_path.as_posix(),
+        ],
+    )
+
+    assert np.array_equal(numpy_helper.load("maxpoolOutput.npy"), maxpoolOutput)
+    assert np.array_equal(numpy_helper.load("conv2dOutput.npy"), conv2dOutput)
+    default = resources_helper.load_profiling_records(
+        default_dump_path, "Memory Summary"
+    )
+    summaries = resources_helper.load_profiling_records(dump_path, "Memory Summary")
+    assert len(summaries) == 1
+    assert summaries[0]["Session aliasing savings [bytes]"] > 0
+    assert default[0]["Session aliasing savings [bytes]"] == 0
+    assert summaries[0]["Session memory [bytes]"] < default[0]["Session memory [bytes]"]
+
+
+def test_maxpool_conv2d_vgf_deferred_creation(
+    sdk_tools, resources_helper, numpy_helper
+):
+    write_maxpool_conv2d_vgf(sdk_tools, resources_helper)
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="maxpoolInput.npy")
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="conv2dInput.npy")
+
+    # Both segments are created by deferred operations joined by the worker pool
+    deferred_report_path = resources_helper.get_testenv_path("deferredReport.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=["--pipeline-report-path", deferred_report_path],
+    )
+    maxpoolOutput = numpy_helper.load("maxpoolOutput.npy")
+    conv2dOutput = numpy_helper.load("conv2dOutput.npy")
+
+    report_path = resources_helper.get_testenv_path("pipelineReport.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=[
+            "--disable-extension",
+            "VK_KHR_deferred_host_operations",
+            "--pipeline-report-path",
+            report_path,
+        ],
+    )
+
+    assert np.array_equal(numpy_helper.load("maxpoolOutput.npy"), maxpoolOutput)
+    assert np.array_equal(numpy_helper.load("conv2dOutput.npy"), conv2dOutput)
+
+    def pipelines(path):
+        return [
+            (pipeline["Pipeline name"], pipeline["Pipeline type"])
+            for pipeline in json.loads(path.read_text())["Pipelines"]
+        ]
+
+    assert len(pipelines(report_path)) == 2
+    assert pipelines(deferred_report_path) == pipelines(report_path)
+
+
+def test_maxpool_conv2d_vgf_low_memory(sdk_tools, resources_helper, numpy_helper):
+    write_maxpool_conv2d_vgf(sdk_tools, resources_helper)
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="maxpoolInput.npy")
+    numpy_helper.generate([1, 16, 16, 16], dtype=np.int8, filename="conv2dInput.npy")
+
+    default_dump_path = resources_helper.get_testenv_path("defaultMemory.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=[
+            "--repeat",
+            "2",
+            "--profiling-dump-path",
+            default_dump_path.as_posix(),
+        ],
+    )
+    maxpoolOutput = numpy_helper.load("maxpoolOutput.npy")
+    conv2dOutput = numpy_helper.load("conv2dOutput.npy")
+
+    # Repeated runs only store the outputs, which keep their staging memory
+    low_memory_dump_path = resources_helper.get_testenv_path("lowMemory.json")
+    sdk_tools.run_scenario(
+        "test_vgf_graph/maxpool_conv2d.json",
+        options=[
+            "--low-memory",
+            "--repeat",
+            "2",
+            "--profiling-dump-path",
+            low_memory_dump_path.as_posix(),
+        ],
+    )
+
+    assert np.array_equal(numpy_helper.load("maxpoolOutput.npy"), maxpoolOutput)
+    assert np.array_equal(numpy_helper.load("conv2dOutput.npy"), conv2dOutput)
+    default = resources_helper.load_profiling_records(
+        default_dump_path, "Memory Summary"
+    )[0]
+    low_memory = resources_helper.load_profiling_records(
+        low_memory_dump_path, "Memory Summary"
+    )[0]
+    resident = "Total allocated device memory [bytes]"
+    peak = "Peak allocated device memory [bytes]"
+    assert low_memory["Staging memory [bytes]"] < default["Staging memory [bytes]"]
+    assert low_memory["Device allocations"] < default["Device allocations"]
+    assert low_memory[resident] < default[resident]
+    # The input staging memory is only released once setup is done
+    assert low_memory[peak] > low_memory[resident]
+    assert default[peak] == default[resident]
+    # Host memory is only reported where /proc/self/status exists
+    before = "Host resident memory before release [bytes]"
+    after = "Host resident memory after release [bytes]"
+    assert before not in default
+    if "Host resident memory [bytes]" in low_memory:
+        assert 0 < low_memory[after] <= low_memory[before]
@@ -4,7 +4,6 @@
 # SPDX-License-Identifier: Apache-2.0
 #
 import io
-import json
 import subprocess
 
 import numpy as np
@@ -755,10 +754,7 @@ def test_two_spirv_shader_module_in_vgf_with_shader_substitution(
         options=["--profiling-dump-path", dump_path.as_posix()],
     )
 
-    with open(dump_path, encoding="utf-8") as dump_file:
-        profiling_data = json.load(dump_file)
-
-    timestamps = profiling_data["Timestamps"]
+    timestamps = resources_helper.load_profiling_records(dump_path, "Timestamp")
     assert [timestamp["Command type"] for timestamp in timestamps] == [
         "ComputeDispatch",
         "ComputeDispatch",
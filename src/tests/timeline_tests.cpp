@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "../timeline.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mlsdk::scenariorunner;
+
+TEST(Timeline, ReportsGapsBetweenSerialCommands) {
+    // Three commands of 2, 1 and 4 ticks with gaps of 1 and 3 ticks, at one millisecond per tick
+    const std::vector<uint64_t> timestamps{0, 2, 3, 4, 7, 11};
+
+    const auto analysis = analyzeTimeline(timestamps, 1000000.0f, 2);
+
+    ASSERT_DOUBLE_EQ(analysis.frameTimeMs, 11.0);
+    ASSERT_DOUBLE_EQ(analysis.busyTimeMs, 7.0);
+    ASSERT_DOUBLE_EQ(analysis.gapTimeMs, 4.0);
+    ASSERT_EQ(analysis.gaps.size(), 2U);
+    ASSERT_EQ(analysis.gaps[0].afterCommand, 0U);
+    ASSERT_EQ(analysis.gaps[0].beforeCommand, 1U);
+    ASSERT_DOUBLE_EQ(analysis.gaps[0].durationMs, 1.0);
+    ASSERT_EQ(analysis.gaps[1].afterCommand, 1U);
+    ASSERT_DOUBLE_EQ(analysis.gaps[1].durationMs, 3.0);
+    ASSERT_EQ(analysis.topCommands, (std::vector<size_t>{2, 0}));
+    ASSERT_EQ(analysis.criticalPath, (std::vector<size_t>{0, 1, 2}));
+    ASSERT_DOUBLE_EQ(analysis.criticalPathTimeMs, 7.0);
+}
+
+TEST(Timeline, ExcludesOverlappedCommandsFromCriticalPath) {
+    // Command 1 runs entirely while command 0 executes, and command 2 starts once both have finished
+    const std::vector<uint64_t> timestamps{0, 10, 2, 5, 10, 12};
+
+    const auto analysis = analyzeTimeline(timestamps, 1000000.0f, 5);
+
+    ASSERT_DOUBLE_EQ(analysis.frameTimeMs, 12.0);
+    ASSERT_DOUBLE_EQ(analysis.busyTimeMs, 12.0);
+    ASSERT_DOUBLE_EQ(analysis.gapTimeMs, 0.0);
+    ASSERT_TRUE(analysis.gaps.empty());
+    ASSERT_EQ(analysis.topCommands.size(), 3U);
+    ASSERT_EQ(analysis.criticalPath, (std::vector<size_t>{0, 2}));
+    ASSERT_DOUBLE_EQ(analysis.criticalPathTimeMs, 12.0);
+}
+
+TEST(Timeline, PrefersEarliestSubmittedPredecessorAmongEqualEnds) {
+    // Commands 0 and 1 both end at tick 4, command 2 waits on them and command 3 overlaps command 2
+    const std::vector<uint64_t> timestamps{0, 4, 1, 4, 6, 9, 5, 8};
+
+    const auto analysis = analyzeTimeline(timestamps, 1000000.0f, 5);
+
+    ASSERT_EQ(analysis.criticalPath, (std::vector<size_t>{0, 2}));
+    ASSERT_DOUBLE_EQ(analysis.criticalPathTimeMs, 7.0);
+}
+
+TEST(Timeline, HandlesEmptyAndInvalidTimestamps) {
+    const auto analysis = analyzeTimeline({}, 1.0f, 5);
+    ASSERT_DOUBLE_EQ(analysis.frameTimeMs, 0.0);
+    ASSERT_TRUE(analysis.criticalPath.empty());
+
+    ASSERT_THROW(analyzeTimeline({1, 2, 3}, 1.0f, 5), std::runtime_error);
+}
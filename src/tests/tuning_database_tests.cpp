@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "tuning_database.hpp"
+
+#include "vgf-utils/temp_folder.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+TEST(TuningDatabase, PicksCandidateWithLowestMedian) {
+    // Candidate 0 has the fastest single repeat, but candidate 2 is faster on most repeats
+    const std::vector<std::vector<double>> timesMs{{0.5, 3.0, 3.0}, {}, {2.0, 2.0, 9.0}, {2.5, 2.5, 2.5}};
+    ASSERT_EQ(fastestTuningCandidate(timesMs), 2U);
+    ASSERT_EQ(fastestTuningCandidate({{}, {1.0}}), 1U);
+    ASSERT_THROW(fastestTuningCandidate({{}, {}}), std::runtime_error);
+    ASSERT_DOUBLE_EQ(medianTuningTime({3.0, 1.0, 2.0}), 2.0);
+}
+
+TEST(TuningDatabase, KeepsResultsPerDevice) {
+    TempFolder tempFolder("scenario_runner_tuning_database_tests");
+    const auto path = tempFolder.relative("devices.json");
+    const auto deviceKey = tuningDeviceKey(0x13b5, 1, 2);
+    const auto otherDeviceKey = tuningDeviceKey(0x13b5, 1, 3);
+    ASSERT_NE(deviceKey, otherDeviceKey);
+    {
+        TuningDatabase database(path, deviceKey);
+        ASSERT_EQ(database.size(), 0U);
+        // Nothing to write, so the file is not created
+        database.save();
+        ASSERT_FALSE(std::filesystem::exists(path));
+
+        database.insert(7, {2, 1.5, "shader"});
+        database.save();
+    }
+    {
+        TuningDatabase database(path, otherDeviceKey);
+        ASSERT_FALSE(database.find(7).has_value());
+        database.insert(7, {0, 3.0, "shader"});
+        database.save();
+    }
+
+    TuningDatabase database(path, deviceKey);
+    ASSERT_EQ(database.size(), 1U);
+    const auto result = database.find(7);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->candidate, 2U);
+    ASSERT_DOUBLE_EQ(result->timeMs, 1.5);
+    ASSERT_EQ(result->shaderName, "shader");
+    ASSERT_EQ(TuningDatabase(path, otherDeviceKey).find(7)->candidate, 0U);
+}
+
+TEST(TuningDatabase, MergesResultsSavedByOtherRuns) {
+    TempFolder tempFolder("scenario_runner_tuning_database_tests");
+    const auto path = tempFolder.relative("merge.json");
+    const auto deviceKey = tuningDeviceKey(1, 2, 3);
+
+    TuningDatabase first(path, deviceKey);
+    TuningDatabase second(path, deviceKey);
+    first.insert(1, {1, 1.0, "first"});
+    second.insert(2, {2, 2.0, "second"});
+    first.save();
+    second.save();
+
+    TuningDatabase reloaded(path, deviceKey);
+    ASSERT_EQ(reloaded.size(), 2U);
+    ASSERT_EQ(reloaded.find(1)->shaderName, "first");
+    ASSERT_EQ(reloaded.find(2)->shaderName, "second");
+}
+
+TEST(TuningDatabase, ConcurrentSavesKeepEveryResult) {
+    TempFolder tempFolder("scenario_runner_tuning_database_tests");
+    const auto path = tempFolder.relative("concurrent.json");
+    const auto deviceKey = tuningDeviceKey(1, 2, 3);
+    constexpr uint64_t databaseCount = 8;
+    constexpr uint64_t resultsPerDatabase = 16;
+
+    std::vector<std::thread> threads;
+    for (uint64_t databaseIdx = 0; databaseIdx < databaseCount; ++databaseIdx) {
+        threads.emplace_back([&path, &deviceKey, databaseIdx] {
+            TuningDatabase database(path, deviceKey);
+            for (uint64_t idx = 0; idx < resultsPerDatabase; ++idx) {
+                database.insert(databaseIdx * resultsPerDatabase + idx, {databaseIdx, 1.0, "shader"});
+                // Interleave the saves of the databases
+                if (idx % 4 == 3) {
+                    database.save();
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    TuningDatabase database(path, deviceKey);
+    ASSERT_EQ(database.size(), databaseCount * resultsPerDatabase);
+    for (uint64_t key = 0; key < databaseCount * resultsPerDatabase; ++key) {
+        ASSERT_EQ(database.find(key)->candidate, key / resultsPerDatabase);
+    }
+}
+
+TEST(TuningDatabase, SkipsInvalidFile) {
+    TempFolder tempFolder("scenario_runner_tuning_database_tests");
+    const auto path = tempFolder.relative("invalid.json");
+    const auto deviceKey = tuningDeviceKey(1, 2, 3);
+    std::ofstream(path) << "not a database";
+
+    TuningDatabase database(path, deviceKey);
+    ASSERT_EQ(database.size(), 0U);
+    database.insert(1, {0, 1.0, "shader"});
+    database.save();
+    ASSERT_EQ(TuningDatabase(path, deviceKey).size(), 0U);
+    std::ifstream stream(path);
+    ASSERT_EQ(std::string(std::istreambuf_iterator<char>(stream), {}), "not a database");
+}
+
+TEST(TuningDatabase, KeepsFileOfOtherVersion) {
+    TempFolder tempFolder("scenario_runner_tuning_database_tests");
+    const auto path = tempFolder.relative("other_version.json");
+    const auto deviceKey = tuningDeviceKey(1, 2, 3);
+    const std::string versions[] = {R"({"version": 2, "devices": {}})", R"({"version": "1", "devices": {}})"};
+
+    for (const auto &content : versions) {
+        std::ofstream(path) << content;
+        TuningDatabase database(path, deviceKey);
+        ASSERT_EQ(database.size(), 0U);
+        database.insert(1, {0, 1.0, "shader"});
+        database.save();
+        std::ifstream stream(path);
+        ASSERT_EQ(std::string(std::istreambuf_iterator<char>(stream), {}), content);
+    }
+}
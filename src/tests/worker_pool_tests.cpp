@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "worker_pool.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mlsdk::scenariorunner;
+
+TEST(WorkerPool, RunsEveryTask) {
+    WorkerPool pool(4);
+    ASSERT_EQ(pool.threadCount(), 4U);
+    ASSERT_GE(WorkerPool().threadCount(), 1U);
+
+    std::atomic<size_t> runs{0};
+    std::vector<std::future<void>> done;
+    for (size_t idx = 0; idx < 100; ++idx) {
+        done.push_back(pool.submit([&runs] {
+            ++runs;
+            return true;
+        }));
+    }
+    for (auto &future : done) {
+        future.get();
+    }
+    ASSERT_EQ(runs, 100U);
+}
+
+TEST(WorkerPool, RetriedTasksLeaveThreadsToOtherTasks) {
+    // The only thread is held by a task that cannot progress until the task submitted after it has run
+    WorkerPool pool(1);
+    std::atomic<bool> released{false};
+    std::atomic<size_t> attempts{0};
+    auto waiting = pool.submit([&] {
+        ++attempts;
+        return released.load();
+    });
+    auto releasing = pool.submit([&released] {
+        released = true;
+        return true;
+    });
+    releasing.get();
+    waiting.get();
+    ASSERT_GE(attempts, 2U);
+}
+
+TEST(WorkerPool, ForwardsExceptions) {
+    WorkerPool pool(2);
+    auto failing = pool.submit([]() -> bool { throw std::runtime_error("failed"); });
+    ASSERT_THROW(failing.get(), std::runtime_error);
+    ASSERT_NO_THROW(pool.submit([] { return true; }).get());
+}
+
+TEST(WorkerPool, DestructorRunsQueuedTasks) {
+    std::atomic<size_t> runs{0};
+    {
+        WorkerPool pool(1);
+        for (size_t idx = 0; idx < 10; ++idx) {
+            pool.submit([&runs] { return ++runs > 0; });
+        }
+    }
+    ASSERT_EQ(runs, 10U);
+}
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace mlsdk::scenariorunner {
+
+namespace {
+struct Interval {
+    uint64_t begin;
+    uint64_t end;
+};
+} // namespace
+
+TimelineAnalysis analyzeTimeline(const std::vector<uint64_t> &timestamps, float timestampPeriod, size_t topCount) {
+    if (timestamps.size() % 2 != 0) {
+        throw std::runtime_error("Cannot map all timestamps to their respective commands");
+    }
+    TimelineAnalysis analysis;
+    const size_t commandCount = timestamps.size() / 2;
+    if (commandCount == 0) {
+        return analysis;
+    }
+
+    const auto toMs = [timestampPeriod](uint64_t ticks) {
+        return static_cast<double>(ticks) * static_cast<double>(timestampPeriod) / 1000000.0;
+    };
+    std::vector<Interval> intervals(commandCount);
+    for (size_t idx = 0; idx < commandCount; ++idx) {
+        intervals[idx] = {timestamps[2 * idx], std::max(timestamps[2 * idx], timestamps[2 * idx + 1])};
+    }
+
+    // Idle time before each command, measured from the latest end of all commands submitted before it
+    size_t latestEnding = 0;
+    for (size_t idx = 1; idx < commandCount; ++idx) {
+        if (intervals[idx].begin > intervals[latestEnding].end) {
+            analysis.gaps.push_back({latestEnding, idx, toMs(intervals[idx].begin - intervals[latestEnding].end)});
+        }
+        if (intervals[idx].end >= intervals[latestEnding].end) {
+            latestEnding = idx;
+        }
+    }
+
+    // Merge overlapping intervals to find the busy time
+    std::vector<size_t> byBegin(commandCount);
+    std::iota(byBegin.begin(), byBegin.end(), 0);
+    std::sort(byBegin.begin(), byBegin.end(),
+              [&intervals](size_t lhs, size_t rhs) { return intervals[lhs].begin < intervals[rhs].begin; });
+    uint64_t busyTicks = 0;
+    uint64_t mergedBegin = intervals[byBegin.front()].begin;
+    uint64_t mergedEnd = intervals[byBegin.front()].end;
+    uint64_t frameEnd = mergedEnd;
+    for (const auto idx : byBegin) {
+        const auto &interval = intervals[idx];
+        if (interval.begin > mergedEnd) {
+            busyTicks += mergedEnd - mergedBegin;
+            mergedBegin = interval.begin;
+        }
+        mergedEnd = std::max(mergedEnd, interval.end);
+        frameEnd = std::max(frameEnd, interval.end);
+    }
+    busyTicks += mergedEnd - mergedBegin;
+    const uint64_t frameTicks = frameEnd - intervals[byBegin.front()].begin;
+    analysis.frameTimeMs = toMs(frameTicks);
+    analysis.busyTimeMs = toMs(busyTicks);
+    analysis.gapTimeMs = toMs(frameTicks - busyTicks);
+
+    // Most expensive commands
+    std::vector<size_t> byDuration(commandCount);
+    std::iota(byDuration.begin(), byDuration.end(), 0);
+    std::stable_sort(byDuration.begin(), byDuration.end(), [&intervals](size_t lhs, size_t rhs) {
+        return intervals[lhs].end - intervals[lhs].begin > intervals[rhs].end - intervals[rhs].begin;
+    });
+    byDuration.resize(std::min(topCount, commandCount));
+    analysis.topCommands = std::move(byDuration);
+
+    // Walk back from the command that ends last through the command that finished most recently before each start.
+    // Commands are sorted by end time, the earliest submitted last among equal ends, to binary-search predecessors.
+    std::vector<size_t> byEnd(commandCount);
+    std::iota(byEnd.begin(), byEnd.end(), 0);
+    std::sort(byEnd.begin(), byEnd.end(), [&intervals](size_t lhs, size_t rhs) {
+        return intervals[lhs].end != intervals[rhs].end ? intervals[lhs].end < intervals[rhs].end : lhs > rhs;
+    });
+    auto current = static_cast<size_t>(
+        std::max_element(intervals.begin(), intervals.end(),
+                         [](const Interval &lhs, const Interval &rhs) { return lhs.end < rhs.end; }) -
+        intervals.begin());
+    // Start times and submission indices only decrease along the path, so the candidates only ever shrink
+    size_t candidateCount = commandCount;
+    while (true) {
+        analysis.criticalPath.push_back(current);
+        analysis.criticalPathTimeMs += toMs(intervals[current].end - intervals[current].begin);
+        const auto endedBeforeStart =
+            std::upper_bound(byEnd.begin(), byEnd.begin() + static_cast<std::ptrdiff_t>(candidateCount),
+                             intervals[current].begin,
+                             [&intervals](uint64_t begin, size_t idx) { return begin < intervals[idx].end; });
+        candidateCount = static_cast<size_t>(endedBeforeStart - byEnd.begin());
+        // Only commands submitted earlier can hold up the current one
+        while (candidateCount > 0 && byEnd[candidateCount - 1] >= current) {
+            --candidateCount;
+        }
+        if (candidateCount == 0) {
+            break;
+        }
+        current = byEnd[candidateCount - 1];
+    }
+    std::reverse(analysis.criticalPath.begin(), analysis.criticalPath.end());
+    return analysis;
+}
+
+} // namespace mlsdk::scenariorunner
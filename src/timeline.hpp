@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief GPU idle time before a command while no earlier submitted command was executing
+struct TimelineGap {
+    /// Index of the earlier command that finished last before the gap
+    size_t afterCommand{};
+    /// Index of the command that starts after the gap
+    size_t beforeCommand{};
+    double durationMs{};
+};
+
+/// \brief GPU timeline of one iteration reconstructed from the timestamps written around every command
+struct TimelineAnalysis {
+    /// Time from the start of the first command to the end of the last one
+    double frameTimeMs{};
+    /// Time during which at least one command was executing
+    double busyTimeMs{};
+    /// Time during which no command was executing, spent in barriers, layout transitions and idling
+    double gapTimeMs{};
+    /// Idle gaps in submission order
+    std::vector<TimelineGap> gaps;
+    /// Indices of the most expensive commands, longest first
+    std::vector<size_t> topCommands;
+    /// Indices of the commands on the critical path in execution order
+    std::vector<size_t> criticalPath;
+    double criticalPathTimeMs{};
+};
+
+/// \brief Reconstruct the GPU timeline from begin/end timestamp pairs
+///
+/// Commands that overlap in time share the busy time. The critical path starts at the command that ends last and
+/// walks back to the earlier submitted command that ended most recently before the current one started, so commands
+/// hidden by overlapping work are not part of it.
+///
+/// \param timestamps      Begin and end timestamp of every command in submission order
+/// \param timestampPeriod Nanoseconds per timestamp tick
+/// \param topCount        Maximum number of entries in TimelineAnalysis::topCommands
+TimelineAnalysis analyzeTimeline(const std::vector<uint64_t> &timestamps, float timestampPeriod, size_t topCount);
+
+} // namespace mlsdk::scenariorunner
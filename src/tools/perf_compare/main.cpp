@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <argparse/argparse.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <version.hpp>
+
+#include "perf_compare.hpp"
+
+using namespace mlsdk::scenariorunner;
+
+namespace {
+
+PerfRun loadRun(const std::vector<std::string> &paths) {
+    PerfRun run;
+    for (const auto &path : paths) {
+        run.load(path);
+    }
+    return run;
+}
+
+} // namespace
+
+int main(int argc, const char **argv) {
+    try {
+        argparse::ArgumentParser parser(argv[0], details::version);
+
+        parser.add_argument("--baseline")
+            .help("profiling or performance counter files of the baseline run; several files are pooled as repeats")
+            .nargs(argparse::nargs_pattern::at_least_one)
+            .required();
+        parser.add_argument("--candidate")
+            .help("profiling or performance counter files of the candidate run; several files are pooled as repeats")
+            .nargs(argparse::nargs_pattern::at_least_one)
+            .required();
+        parser.add_argument("--threshold")
+            .help("relative slowdown in percent above which a metric regresses")
+            .default_value(5.0)
+            .scan<'g', double>();
+
+        parser.parse_args(argc, argv);
+
+        const auto baseline = loadRun(parser.get<std::vector<std::string>>("--baseline"));
+        const auto candidate = loadRun(parser.get<std::vector<std::string>>("--candidate"));
+        const auto threshold = parser.get<double>("--threshold");
+
+        const auto comparisons = comparePerfRuns(baseline, candidate, threshold);
+        const auto regressions = printComparisonTable(comparisons, std::cout);
+
+        if (regressions != 0) {
+            std::cerr << regressions << " metric(s) regressed by more than " << threshold << "%." << std::endl;
+            return 1;
+        }
+        std::cout << "No regressions found." << std::endl;
+    } catch (const std::exception &error) {
+        std::cerr << "[ERROR]: " << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
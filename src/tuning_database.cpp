@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tuning_database.hpp"
+#include "file_utils.hpp"
+#include "logging.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace mlsdk::scenariorunner {
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int databaseVersion = 1;
+
+/// Read the database at @p path, returning an empty one when it is missing and nothing when it is invalid
+std::optional<json> readDatabase(const std::filesystem::path &path) {
+    std::ifstream stream(path);
+    if (!stream.is_open()) {
+        return json::object();
+    }
+    auto database = json::parse(stream, nullptr, false);
+    if (database.is_discarded() || !database.is_object()) {
+        return std::nullopt;
+    }
+    const auto version = database.find("version");
+    if (version == database.end() || !version->is_number_integer() || *version != databaseVersion ||
+        !database.contains("devices") || !database.at("devices").is_object()) {
+        return std::nullopt;
+    }
+    return database;
+}
+
+} // namespace
+
+std::string tuningDeviceKey(uint32_t vendorID, uint32_t deviceID, uint32_t driverVersion) {
+    std::ostringstream stream;
+    stream << std::hex << std::setfill('0') << std::setw(8) << vendorID << "-" << std::setw(8) << deviceID << "-"
+           << std::setw(8) << driverVersion;
+    return stream.str();
+}
+
+double medianTuningTime(std::vector<double> timesMs) {
+    if (timesMs.empty()) {
+        throw std::runtime_error("Tuning candidate has not been timed");
+    }
+    const auto middle = timesMs.begin() + static_cast<std::ptrdiff_t>(timesMs.size() / 2);
+    std::nth_element(timesMs.begin(), middle, timesMs.end());
+    return *middle;
+}
+
+size_t fastestTuningCandidate(const std::vector<std::vector<double>> &timesMs) {
+    std::optional<size_t> fastest;
+    double fastestMedian = std::numeric_limits<double>::max();
+    for (size_t candidate = 0; candidate < timesMs.size(); ++candidate) {
+        if (timesMs[candidate].empty()) {
+            continue;
+        }
+        const auto median = medianTuningTime(timesMs[candidate]);
+        if (!fastest.has_value() || median < fastestMedian) {
+            fastest = candidate;
+            fastestMedian = median;
+        }
+    }
+    if (!fastest.has_value()) {
+        throw std::runtime_error("No tuning candidate has been timed");
+    }
+    return *fastest;
+}
+
+TuningDatabase::TuningDatabase(const std::filesystem::path &path, std::string deviceKey)
+    : _path(path), _deviceKey(std::move(deviceKey)) {
+    const auto database = readDatabase(_path);
+    if (!database.has_value()) {
+        mlsdk::logging::warning("Tuning database skipped: failed to parse " + _path.string());
+        return;
+    }
+    if (!database->contains("devices") || !database->at("devices").contains(_deviceKey)) {
+        return;
+    }
+    try {
+        for (const auto &[key, entry] : database->at("devices").at(_deviceKey).items()) {
+            TuningResult result;
+            result.candidate = entry.at("candidate").get<size_t>();
+            result.timeMs = entry.at("time ms").get<double>();
+            result.shaderName = entry.value("shader", std::string{});
+            _results[std::stoull(key, nullptr, 16)] = std::move(result);
+        }
+    } catch (const std::exception &) {
+        mlsdk::logging::warning("Tuning database skipped: invalid results in " + _path.string());
+        _results.clear();
+    }
+}
+
+std::optional<TuningResult> TuningDatabase::find(uint64_t shaderKey) const {
+    const auto it = _results.find(shaderKey);
+    if (it == _results.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void TuningDatabase::insert(uint64_t shaderKey, TuningResult result) {
+    _results[shaderKey] = std::move(result);
+    _modified = true;
+}
+
+void TuningDatabase::save() {
+    if (!_modified) {
+        return;
+    }
+
+    if (_path.has_parent_path()) {
+        std::filesystem::create_directories(_path.parent_path());
+    }
+    auto lockPath = _path;
+    lockPath += ".lock";
+    const FileLock fileLock(lockPath);
+
+    // Other devices, and other runs on this device, may have saved results since the database was opened
+    auto database = readDatabase(_path);
+    if (!database.has_value()) {
+        // The file may hold the results of other devices in another version, which must not be lost
+        mlsdk::logging::warning("Tuning database not stored: " + _path.string() +
+                                " exists but is not a tuning database of version " + std::to_string(databaseVersion));
+        return;
+    }
+    (*database)["version"] = databaseVersion;
+    auto &deviceResults = (*database)["devices"][_deviceKey];
+    if (!deviceResults.is_object()) {
+        deviceResults = json::object();
+    }
+    for (const auto &[key, result] : _results) {
+        deviceResults[formatKey(key)] = {
+            {"shader", result.shaderName}, {"candidate", result.candidate}, {"time ms", result.timeMs}};
+    }
+
+    const auto content = database->dump(2);
+    writeFileAtomically(_path, content.data(), content.size());
+    _modified = false;
+}
+
+} // namespace mlsdk::scenariorunner
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief Winning tuning candidate of a shader
+struct TuningResult {
+    /// Index of the candidate in the tuning candidates of the shader
+    size_t candidate{0};
+    /// Median dispatch time of the candidate
+    double timeMs{0.0};
+    /// Name of the shader, to make the database readable
+    std::string shaderName;
+};
+
+/// \brief Key of the device a tuning result was measured on
+///
+/// Results only carry over to the same device running the same driver.
+std::string tuningDeviceKey(uint32_t vendorID, uint32_t deviceID, uint32_t driverVersion);
+
+/// \brief Median of the dispatch times of a tuning candidate, which must have at least one
+double medianTuningTime(std::vector<double> timesMs);
+
+/// \brief Index of the candidate with the lowest median time
+///
+/// \param timesMs Dispatch times of every repeat of every candidate, candidates without times are skipped
+size_t fastestTuningCandidate(const std::vector<std::vector<double>> &timesMs);
+
+/// \brief JSON file with the tuning results of every device
+///
+/// Results are keyed by the device and by a hash of the shader code, its specialization constants and its tuning
+/// candidates, so editing any of them invalidates the result. Saving locks the file next to the database with the
+/// .lock extension and rewrites the results of the current device in the file on disk, keeping those of other
+/// devices and of concurrent runs. A file that cannot be parsed, or has another version, is never overwritten.
+class TuningDatabase {
+  public:
+    /// \brief Open the database at @p path for the device with @p deviceKey, the file does not need to exist
+    TuningDatabase(const std::filesystem::path &path, std::string deviceKey);
+
+    /// \brief Result of the shader with @p shaderKey on the current device, if it has been tuned
+    std::optional<TuningResult> find(uint64_t shaderKey) const;
+
+    /// \brief Add or replace the result of the shader with @p shaderKey, written by the next save
+    void insert(uint64_t shaderKey, TuningResult result);
+
+    /// \brief Write the results of the current device when some were added since the database was opened
+    ///
+    /// Logs a warning and writes nothing when the file on disk is not a database of the current version.
+    void save();
+
+    /// \brief Number of results of the current device
+    size_t size() const { return _results.size(); }
+
+    const std::filesystem::path &path() const { return _path; }
+
+  private:
+    std::filesystem::path _path;
+    std::string _deviceKey;
+    std::unordered_map<uint64_t, TuningResult> _results;
+    bool _modified{false};
+};
+
+} // namespace mlsdk::scenariorunner
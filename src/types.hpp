@@ -10,6 +10,7 @@
 #include "vulkan/vulkan_raii.hpp"
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
 #include <variant>
@@ -134,7 +135,9 @@ struct GraphConstantInfo {
 
     vk::Format format{vk::Format::eUndefined};
     std::vector<int64_t> dims;
-    std::vector<uint8_t> data;
+    /// View of the constant in the file it was loaded from, which stays mapped while any copy of the view exists
+    std::shared_ptr<const uint8_t> data;
+    size_t size{0};
     std::string debugName;
 };
 
@@ -185,6 +188,8 @@ struct ShaderInfo {
     ShaderStage stage{ShaderStage::Unknown};
     std::string buildOpts;
     std::vector<std::string> includeDirs;
+    /// Sets of specialization constants to tune, each overriding or adding to the specialization constants
+    std::vector<std::vector<SpecializationConstant>> tuningCandidates;
 };
 
 struct BaseBarrierInfo {
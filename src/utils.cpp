@@ -20,6 +20,7 @@
 #include <fstream>
 #include <limits>
 #include <numeric>
+#include <sstream>
 
 namespace mlsdk::scenariorunner {
 
@@ -276,6 +277,34 @@ std::string lowercaseExtension(const std::string &path) {
     return ext;
 }
 
+std::optional<HostMemoryUsage> getHostMemoryUsage() {
+    std::ifstream status("/proc/self/status");
+    if (!status) {
+        return std::nullopt;
+    }
+    // VmRSS and VmHWM are reported in kB
+    std::optional<uint64_t> residentKb;
+    std::optional<uint64_t> peakResidentKb;
+    std::string line;
+    while (std::getline(status, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        uint64_t value = 0;
+        if (!(fields >> key >> value)) {
+            continue;
+        }
+        if (key == "VmRSS:") {
+            residentKb = value;
+        } else if (key == "VmHWM:") {
+            peakResidentKb = value;
+        }
+    }
+    if (!residentKb.has_value() || !peakResidentKb.has_value()) {
+        return std::nullopt;
+    }
+    return HostMemoryUsage{*residentKb * 1024, *peakResidentKb * 1024};
+}
+
 std::vector<uint32_t> readShaderCode(const ShaderInfo &shaderInfo) {
     switch (shaderInfo.shaderType) {
     case ShaderType::SPIR_V: {
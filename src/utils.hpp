@@ -12,6 +12,7 @@
 #include "vgf-utils/numpy.hpp"
 #include "vulkan/vulkan_raii.hpp"
 #include <limits>
+#include <optional>
 #include <string>
 
 namespace mlsdk::scenariorunner {
@@ -97,6 +98,18 @@ std::vector<uint32_t> readShaderCode(const ShaderInfo &shaderInfo);
  */
 std::string lowercaseExtension(const std::string &path);
 
+/** Resident and peak resident host memory of the current process in bytes */
+struct HostMemoryUsage {
+    uint64_t residentBytes{};
+    uint64_t peakResidentBytes{};
+};
+
+/** Read the host memory usage of the current process.
+ *
+ * @return Host memory usage, or nothing on platforms without /proc/self/status
+ */
+std::optional<HostMemoryUsage> getHostMemoryUsage();
+
 /** Consumer function for messages communicated from the SPIRV-Tools library
  *
  *  @param[in] level    Message level
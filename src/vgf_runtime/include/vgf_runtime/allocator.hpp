@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <vulkan/vulkan_raii.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace mlsdk::vgf_runtime {
+
+/** @brief Range of device memory handed out by an Allocator. */
+struct MemoryAllocation {
+    vk::DeviceMemory memory;
+    vk::DeviceSize offset = 0;
+    vk::DeviceSize size = 0;
+};
+
+/**
+ * @brief Device memory allocator used by sessions for the memory they own.
+ *
+ * Sessions allocate intermediate resources and data graph session memory
+ * through an allocator, so applications that already pool device memory can
+ * sub-allocate from their own blocks instead of the session calling
+ * vkAllocateMemory for every object.
+ */
+class Allocator {
+  public:
+    virtual ~Allocator() = default;
+
+    /**
+     * @brief Allocate memory satisfying @p requirements.
+     *
+     * The returned range must be at least requirements.size bytes, start at an
+     * offset aligned to requirements.alignment, and come from a memory type
+     * allowed by requirements.memoryTypeBits that has @p properties.
+     */
+    virtual MemoryAllocation allocate(const vk::MemoryRequirements &requirements,
+                                      vk::MemoryPropertyFlags properties) = 0;
+
+    /** @brief Release a range previously returned by allocate(). */
+    virtual void free(const MemoryAllocation &allocation) = 0;
+};
+
+/** @brief Allocator that makes one dedicated vkAllocateMemory call per allocation. */
+class DefaultAllocator final : public Allocator {
+  public:
+    /** @brief Create an allocator for @p device. Both devices must outlive the allocator. */
+    DefaultAllocator(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device);
+
+    MemoryAllocation allocate(const vk::MemoryRequirements &requirements, vk::MemoryPropertyFlags properties) override;
+    void free(const MemoryAllocation &allocation) override;
+
+  private:
+    const vk::raii::PhysicalDevice &physicalDevice_;
+    const vk::raii::Device &device_;
+    std::mutex mutex_;
+    std::vector<vk::raii::DeviceMemory> memory_;
+};
+
+} // namespace mlsdk::vgf_runtime
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vgf_runtime/workload_frontends/vgf.hpp>
+
+#include <vulkan/vulkan.hpp>
+#include <vulkan/vulkan_raii.hpp>
+
+#include <memory>
+
+namespace mlsdk::vgf_runtime {
+
+class Session;
+
+/**
+ * @brief Immutable Vulkan pipeline state compiled from a decoded VGF.
+ *
+ * A compiled graph owns the shader modules, descriptor set layouts, pipeline
+ * layouts and pipelines of every segment. It can be shared by any number of
+ * sessions created on the same device, each of which only owns its descriptor
+ * sets, intermediate resources and data graph session memory.
+ *
+ * The device and the VGF must outlive the compiled graph.
+ */
+class CompiledGraph {
+  public:
+    /** @brief Compile every segment of @p vgf for @p device. */
+    CompiledGraph(const vk::raii::Device &device, const VGF &vgf);
+    ~CompiledGraph();
+
+    CompiledGraph(const CompiledGraph &) = delete;
+    CompiledGraph &operator=(const CompiledGraph &) = delete;
+    CompiledGraph(CompiledGraph &&) = delete;
+    CompiledGraph &operator=(CompiledGraph &&) = delete;
+
+    /** @brief Return the VGF the graph was compiled from. */
+    const VGF &getVGF() const;
+
+  private:
+    friend class Session;
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace mlsdk::vgf_runtime
@@ -4,5 +4,7 @@
  */
 #pragma once
 
+#include <vgf_runtime/allocator.hpp>
+#include <vgf_runtime/compiled_graph.hpp>
 #include <vgf_runtime/session.hpp>
 #include <vgf_runtime/workload_frontends/vgf.hpp>
@@ -4,12 +4,17 @@
  */
 #pragma once
 
+#include <vgf_runtime/allocator.hpp>
+#include <vgf_runtime/compiled_graph.hpp>
 #include <vgf_runtime/workload_frontends/vgf.hpp>
 
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_raii.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace mlsdk::vgf_runtime {
 
@@ -17,7 +22,11 @@ namespace mlsdk::vgf_runtime {
  * @brief Configures and runs VGF graph segments on a Vulkan device.
  *
  * A session binds tensors to VGF resources, creates the required Vulkan state
- * once with configure(), and then executes the graph with run().
+ * once with configure(), and then executes the graph with run(), or with
+ * submit() when the caller wants to overlap host work with execution.
+ *
+ * The device must have the synchronization2 and timelineSemaphore features
+ * enabled.
  */
 class Session {
   public:
@@ -27,9 +36,56 @@ class Session {
         vk::DeviceSize size;
     };
 
-    /** @brief Create a session bound to a Vulkan device, queue, and decoded VGF. */
+    /** @brief Semaphore wait or signal operation attached to a submission. */
+    struct SemaphoreInfo {
+        vk::Semaphore semaphore;
+        /** Timeline value to wait for or signal. Ignored for binary semaphores. */
+        uint64_t value = 0;
+        vk::PipelineStageFlags2 stageMask = vk::PipelineStageFlagBits2::eAllCommands;
+    };
+
+    /** @brief Device memory used by the intermediate resources the session allocates. */
+    struct IntermediateMemoryInfo {
+        /** Bytes the intermediates would need with one allocation each. */
+        vk::DeviceSize unaliasedBytes = 0;
+        /** Bytes actually allocated for the intermediates. */
+        vk::DeviceSize allocatedBytes = 0;
+    };
+
+    /** @brief Device memory owned by a configured session. */
+    struct MemoryInfo {
+        /** Data graph session memory bound for each segment; zero for compute shader segments. */
+        std::vector<vk::DeviceSize> segmentSessionMemoryBytes;
+        /** Size of each device memory allocation made for intermediates, in allocation order. */
+        std::vector<vk::DeviceSize> intermediateAllocationBytes;
+        IntermediateMemoryInfo intermediates;
+    };
+
+    /** @brief GPU execution time of one segment in a profiled submission. */
+    struct SegmentTiming {
+        std::string name;
+        double durationNs = 0.0;
+    };
+
+    /** @brief Maximum number of submissions the session keeps in flight at once. */
+    static constexpr uint32_t maxSubmissionsInFlight = 3;
+
+    /**
+     * @brief Create a session bound to a Vulkan device, queue, and decoded VGF.
+     *
+     * The session compiles its own pipelines in configure().
+     */
     Session(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device, uint32_t queueFamilyIndex,
             const vk::raii::Queue &queue, const VGF &vgf);
+
+    /**
+     * @brief Create a session that executes pipelines shared through @p graph.
+     *
+     * configure() then only creates the per-session state: descriptor sets,
+     * intermediate resources and data graph session memory.
+     */
+    Session(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device, uint32_t queueFamilyIndex,
+            const vk::raii::Queue &queue, std::shared_ptr<const CompiledGraph> graph);
     ~Session();
 
     Session(const Session &) = delete;
@@ -59,12 +115,104 @@ class Session {
     void bindImage(const vk::raii::Image &image, DescriptorBindingInfo binding, vk::ImageLayout currentLayout,
                    BoundMemoryInfo memory = BoundMemoryInfo());
 
+    /**
+     * @brief Allocate intermediate resources and data graph session memory through @p allocator.
+     *
+     * By default the session uses a DefaultAllocator. The session keeps the
+     * allocator alive and frees its allocations through it when destroyed.
+     * Must be called before configure().
+     */
+    void setAllocator(std::shared_ptr<Allocator> allocator);
+
+    /**
+     * @brief Let intermediate tensors and buffers with disjoint segment lifetimes share device memory.
+     *
+     * Each intermediate is live from the first to the last segment that binds
+     * it. When enabled, configure() packs the intermediates of each memory type
+     * into one allocation at offsets that never overlap for intermediates that
+     * are live at the same time. Intermediate images are not aliased.
+     * Must be called before configure().
+     */
+    void setIntermediateMemoryAliasing(bool enable);
+
+    /**
+     * @brief Write GPU timestamps around every segment dispatch.
+     *
+     * Profiling is disabled by default, in which case the session creates no
+     * query pool and records no timestamp commands. Must be called before
+     * configure(). The queue family must support timestamps.
+     */
+    void setProfiling(bool enable);
+
+    /**
+     * @brief Execute the graph @p batchSize times per submission.
+     *
+     * Every submission records one execution of the segment chain per batch
+     * entry and submits them together, with a barrier between entries. Each
+     * entry gets its own descriptor sets. Inputs and outputs bound with a
+     * batch index are used by that entry only; entries without their own
+     * binding for a resource use the one of batch entry 0. Intermediate
+     * resources and data graph session memory are shared by all entries.
+     * Must be called before configure() and before binding with a non-zero
+     * batch index.
+     */
+    void setBatchSize(uint32_t batchSize);
+
+    /** @brief Bind a tensor for batch entry @p batchIndex. Resources in alias groups only support entry 0. */
+    void bindTensor(uint32_t batchIndex, const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding,
+                    BoundMemoryInfo memory = BoundMemoryInfo());
+
+    /** @brief Bind a buffer for batch entry @p batchIndex. Resources in alias groups only support entry 0. */
+    void bindBuffer(uint32_t batchIndex, const vk::raii::Buffer &buffer, DescriptorBindingInfo binding,
+                    BoundMemoryInfo memory = BoundMemoryInfo());
+
+    /** @brief Bind an image for batch entry @p batchIndex, describing its layout before the first dispatch. */
+    void bindImage(uint32_t batchIndex, const vk::raii::Image &image, DescriptorBindingInfo binding,
+                   vk::ImageLayout currentLayout, BoundMemoryInfo memory = BoundMemoryInfo());
+
     /** @brief Create the Vulkan objects needed to execute the decoded graph. */
     void configure();
 
     /** @brief Submit the configured graph to the session queue and wait for completion. */
     void run();
 
+    /**
+     * @brief Submit the configured graph to the session queue without waiting for completion.
+     *
+     * The submission waits on @p waitSemaphores before executing and signals
+     * @p signalSemaphores once it completes. When maxSubmissionsInFlight
+     * submissions are already pending, the call blocks until the oldest one
+     * has completed.
+     *
+     * @return Value the session timeline semaphore reaches when the submission completes.
+     */
+    uint64_t submit(const std::vector<SemaphoreInfo> &waitSemaphores = {},
+                    const std::vector<SemaphoreInfo> &signalSemaphores = {});
+
+    /** @brief Block until the submission identified by @p value has completed. */
+    void wait(uint64_t value) const;
+
+    /** @brief Return true if the submission identified by @p value has completed. */
+    bool poll(uint64_t value) const;
+
+    /** @brief Return the timeline semaphore signalled by every submission. */
+    vk::Semaphore getTimelineSemaphore() const;
+
+    /** @brief Return the device memory used by intermediates allocated in configure(). */
+    IntermediateMemoryInfo getIntermediateMemoryInfo() const;
+
+    /** @brief Return the data graph session and intermediate memory allocated in configure(). */
+    MemoryInfo getMemoryInfo() const;
+
+    /**
+     * @brief Return the per-segment GPU durations of the submission identified by @p value.
+     *
+     * Blocks until the submission has completed. Requires profiling to be
+     * enabled, and only the last maxSubmissionsInFlight submissions are kept.
+     * Batched submissions report the sum over all batch entries.
+     */
+    std::vector<SegmentTiming> getSegmentTimings(uint64_t value) const;
+
   private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <vgf_runtime/allocator.hpp>
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mlsdk::vgf_runtime {
+namespace {
+
+using ::vgf_runtime::detail::vulkan_helpers::findMemoryType;
+
+} // namespace
+
+DefaultAllocator::DefaultAllocator(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device)
+    : physicalDevice_(physicalDevice), device_(device) {}
+
+MemoryAllocation DefaultAllocator::allocate(const vk::MemoryRequirements &requirements,
+                                            vk::MemoryPropertyFlags properties) {
+    const auto memoryType = findMemoryType(physicalDevice_, requirements.memoryTypeBits, properties);
+    std::lock_guard<std::mutex> lock(mutex_);
+    memory_.emplace_back(device_, vk::MemoryAllocateInfo(requirements.size, memoryType));
+    return {*memory_.back(), 0, requirements.size};
+}
+
+void DefaultAllocator::free(const MemoryAllocation &allocation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = std::find_if(memory_.begin(), memory_.end(),
+                                    [&allocation](const vk::raii::DeviceMemory &memory) {
+                                        return *memory == allocation.memory;
+                                    });
+    if (found == memory_.end()) {
+        throw std::runtime_error("DefaultAllocator::free() called with memory it did not allocate");
+    }
+    memory_.erase(found);
+}
+
+} // namespace mlsdk::vgf_runtime
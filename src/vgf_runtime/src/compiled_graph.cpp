@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "compiled_graph.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace mlsdk::vgf_runtime {
+namespace {
+
+using ::vgf_runtime::detail::vulkan_helpers::imageLayout;
+using ::vgf_runtime::detail::vulkan_helpers::rawLayouts;
+using ::vgf_runtime::detail::vulkan_helpers::validateImageFormat;
+
+std::vector<std::vector<DescriptorBindingInfo>> splitBindingsBySet(const std::vector<DescriptorBindingInfo> &bindings) {
+    std::vector<std::vector<DescriptorBindingInfo>> sets;
+    for (const auto &binding : bindings) {
+        while (sets.size() <= binding.set) {
+            sets.emplace_back();
+        }
+        sets[binding.set].push_back(binding);
+    }
+    return sets;
+}
+
+} // namespace
+
+void CompiledGraph::Impl::compileSegment(uint32_t segmentIndex) {
+    const auto segment = vgf.getSegment(segmentIndex);
+    if (segment.type != vgflib::ModuleType::GRAPH && segment.type != vgflib::ModuleType::COMPUTE) {
+        throw std::runtime_error("CompiledGraph cannot compile VGF segment " + std::to_string(segmentIndex) +
+                                 ": only data graph and compute shader segments are supported");
+    }
+
+    auto &state = segments.emplace_back();
+    state.type = segment.type;
+    state.bindings = vgf.getDescriptorBindings(segmentIndex);
+    const auto module = vgf.getSPIRVModule(segment.moduleIndex);
+    for (const auto &binding : state.bindings) {
+        if (binding.descriptorType != vk::DescriptorType::eStorageBuffer &&
+            binding.descriptorType != vk::DescriptorType::eTensorARM &&
+            binding.descriptorType != vk::DescriptorType::eCombinedImageSampler &&
+            binding.descriptorType != vk::DescriptorType::eStorageImage) {
+            throw std::runtime_error("CompiledGraph cannot compile VGF segment " + std::to_string(segmentIndex) +
+                                     ": unsupported descriptor type " +
+                                     std::to_string(static_cast<uint32_t>(binding.descriptorType)));
+        }
+        if (binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
+            binding.descriptorType == vk::DescriptorType::eStorageImage) {
+            validateImageFormat(vgf.getResource(binding.resourceIndex).format);
+        }
+    }
+
+    const auto bindingSets = splitBindingsBySet(state.bindings);
+    state.descriptorSetLayouts.reserve(bindingSets.size());
+    for (const auto &setBindings : bindingSets) {
+        std::vector<vk::DescriptorSetLayoutBinding> layoutBindings;
+        layoutBindings.reserve(setBindings.size());
+        for (const auto &binding : setBindings) {
+            layoutBindings.emplace_back(binding.binding, binding.descriptorType, 1, vk::ShaderStageFlagBits::eAll);
+        }
+        state.descriptorSetLayouts.emplace_back(device, vk::DescriptorSetLayoutCreateInfo({}, layoutBindings));
+    }
+
+    const auto descriptorSetLayouts = rawLayouts(state.descriptorSetLayouts);
+    const vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo({}, descriptorSetLayouts);
+    state.pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutCreateInfo);
+
+    const vk::ShaderModuleCreateInfo shaderCreateInfo({}, module.code.size() * sizeof(uint32_t), module.code.data());
+    state.shaderModule = vk::raii::ShaderModule(device, shaderCreateInfo);
+
+    if (segment.type == vgflib::ModuleType::COMPUTE) {
+        const auto dispatchShape = vgf.getDispatchShape(segmentIndex);
+        if (dispatchShape.size() != state.dispatchShape.size() || dispatchShape[0] == 0 || dispatchShape[1] == 0 ||
+            dispatchShape[2] == 0) {
+            throw std::runtime_error("CompiledGraph cannot compile VGF segment " + std::to_string(segmentIndex) +
+                                     ": compute shader segments must have a non-zero 3D dispatch shape");
+        }
+        std::copy(dispatchShape.begin(), dispatchShape.end(), state.dispatchShape.begin());
+
+        const vk::PipelineShaderStageCreateInfo shaderStageCreateInfo({}, vk::ShaderStageFlagBits::eCompute,
+                                                                      *state.shaderModule, module.entryPoint.c_str());
+        const vk::ComputePipelineCreateInfo pipelineCreateInfo({}, shaderStageCreateInfo, *state.pipelineLayout);
+        const vk::raii::PipelineCache *pipelineCache = nullptr;
+        state.pipeline = vk::raii::Pipeline(device, pipelineCache, pipelineCreateInfo);
+        return;
+    }
+
+    std::vector<vk::TensorDescriptionARM> tensorDescriptions;
+    std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> imageLayouts;
+    std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
+    tensorDescriptions.reserve(state.bindings.size());
+    imageLayouts.reserve(state.bindings.size());
+    resourceInfos.reserve(state.bindings.size());
+    for (const auto &binding : state.bindings) {
+        const auto resource = vgf.getResource(binding.resourceIndex);
+        const auto tensorTiling = binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
+                                          binding.descriptorType == vk::DescriptorType::eStorageImage
+                                      ? vk::TensorTilingARM::eOptimal
+                                      : vk::TensorTilingARM::eLinear;
+        tensorDescriptions.emplace_back(tensorTiling, resource.format, static_cast<uint32_t>(resource.shape.size()),
+                                        resource.shape.data(),
+                                        resource.stride.empty() ? nullptr : resource.stride.data(),
+                                        vk::TensorUsageFlagBitsARM::eDataGraph);
+        if (binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
+            binding.descriptorType == vk::DescriptorType::eStorageImage) {
+            imageLayouts.emplace_back(imageLayout(binding.descriptorType), &tensorDescriptions.back());
+            resourceInfos.emplace_back(binding.set, binding.binding, 0, &imageLayouts.back());
+        } else {
+            resourceInfos.emplace_back(binding.set, binding.binding, 0, &tensorDescriptions.back());
+        }
+    }
+
+    const uint32_t numConstants = vgf.getNumConstants(segmentIndex);
+    std::vector<vk::TensorDescriptionARM> constantTensorDescriptions;
+    std::vector<vk::DataGraphPipelineConstantARM> constants;
+    constantTensorDescriptions.reserve(numConstants);
+    constants.reserve(numConstants);
+    for (uint32_t constantIndex = 0; constantIndex < numConstants; ++constantIndex) {
+        const auto constant = vgf.getConstant(segmentIndex, constantIndex);
+        if (constant.sparsityDimension >= 0) {
+            throw std::runtime_error("CompiledGraph cannot compile VGF segment " + std::to_string(segmentIndex) +
+                                     ": sparse graph constants are not supported");
+        }
+        constantTensorDescriptions.emplace_back(vk::TensorTilingARM::eLinear, constant.format,
+                                                static_cast<uint32_t>(constant.shape.size()), constant.shape.data(),
+                                                constant.stride.empty() ? nullptr : constant.stride.data(),
+                                                vk::TensorUsageFlagBitsARM::eDataGraph);
+        constants.emplace_back(constant.graphConstantId, constant.data.data(), &constantTensorDescriptions.back());
+    }
+
+    const vk::DataGraphPipelineShaderModuleCreateInfoARM shaderModuleInfo(
+        *state.shaderModule, module.entryPoint.c_str(), nullptr, static_cast<uint32_t>(constants.size()),
+        constants.data(), nullptr);
+    const vk::DataGraphPipelineCreateInfoARM pipelineCreateInfo({}, *state.pipelineLayout,
+                                                                static_cast<uint32_t>(resourceInfos.size()),
+                                                                resourceInfos.data(), &shaderModuleInfo);
+    const vk::raii::DeferredOperationKHR deferredOperation(nullptr);
+    const vk::raii::PipelineCache *pipelineCache = nullptr;
+    state.pipeline = vk::raii::Pipeline(device, deferredOperation, pipelineCache, pipelineCreateInfo);
+}
+
+CompiledGraph::CompiledGraph(const vk::raii::Device &device, const VGF &vgf)
+    : impl_(std::make_unique<Impl>(device, vgf)) {
+    impl_->segments.reserve(vgf.getNumSegments());
+    for (uint32_t segmentIndex = 0; segmentIndex < vgf.getNumSegments(); ++segmentIndex) {
+        impl_->compileSegment(segmentIndex);
+    }
+}
+
+CompiledGraph::~CompiledGraph() = default;
+
+const VGF &CompiledGraph::getVGF() const { return impl_->vgf; }
+
+} // namespace mlsdk::vgf_runtime
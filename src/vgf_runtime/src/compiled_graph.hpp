@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vgf_runtime/compiled_graph.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mlsdk::vgf_runtime {
+
+/** @brief Device objects of one segment that are shared by every session executing it. */
+struct CompiledSegment {
+    vgflib::ModuleType type = vgflib::ModuleType::GRAPH;
+    vk::raii::ShaderModule shaderModule{nullptr};
+    std::vector<vk::raii::DescriptorSetLayout> descriptorSetLayouts;
+    vk::raii::PipelineLayout pipelineLayout{nullptr};
+    vk::raii::Pipeline pipeline{nullptr};
+    std::vector<DescriptorBindingInfo> bindings;
+    // Shader
+    std::array<uint32_t, 3> dispatchShape = {};
+};
+
+struct CompiledGraph::Impl {
+    Impl(const vk::raii::Device &deviceIn, const VGF &vgfIn) : device(deviceIn), vgf(vgfIn) {}
+
+    void compileSegment(uint32_t segmentIndex);
+
+    const vk::raii::Device &device;
+    const VGF &vgf;
+    std::vector<CompiledSegment> segments;
+};
+
+} // namespace mlsdk::vgf_runtime
@@ -4,57 +4,46 @@
  */
 #include <vgf_runtime/session.hpp>
 
+#include "compiled_graph.hpp"
+#include "utils.hpp"
+
 #include <algorithm>
-#include <array>
 #include <limits>
 #include <map>
+#include <numeric>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace mlsdk::vgf_runtime {
 namespace {
 
-std::vector<std::vector<DescriptorBindingInfo>> splitBindingsBySet(const std::vector<DescriptorBindingInfo> &bindings) {
-    std::vector<std::vector<DescriptorBindingInfo>> sets;
-    for (const auto &binding : bindings) {
-        while (sets.size() <= binding.set) {
-            sets.emplace_back();
-        }
-        sets[binding.set].push_back(binding);
-    }
-    return sets;
-}
-
-std::vector<vk::DescriptorSetLayout>
-rawLayouts(const std::vector<vk::raii::DescriptorSetLayout> &descriptorSetLayouts) {
-    std::vector<vk::DescriptorSetLayout> layouts;
-    layouts.reserve(descriptorSetLayouts.size());
-    for (const auto &layout : descriptorSetLayouts) {
-        layouts.push_back(*layout);
-    }
-    return layouts;
-}
-
-uint32_t findMemoryType(const vk::raii::PhysicalDevice &physicalDevice, uint32_t memoryTypeBits,
-                        vk::MemoryPropertyFlags requiredFlags) {
-    const auto memoryProperties = physicalDevice.getMemoryProperties();
-    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
-        const bool supportsType = (memoryTypeBits & (uint32_t{1} << i)) != 0;
-        const bool hasFlags = (memoryProperties.memoryTypes[i].propertyFlags & requiredFlags) == requiredFlags;
-        if (supportsType && hasFlags) {
-            return i;
-        }
+using ::vgf_runtime::detail::vulkan_helpers::imageLayout;
+using ::vgf_runtime::detail::vulkan_helpers::rawLayouts;
+using ::vgf_runtime::detail::vulkan_helpers::validateImageFormat;
+
+void waitForSemaphore(const vk::raii::Device &device, const vk::raii::Semaphore &semaphore, uint64_t value) {
+    const vk::Semaphore rawSemaphore = *semaphore;
+    vk::SemaphoreWaitInfo waitInfo;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &rawSemaphore;
+    waitInfo.pValues = &value;
+    const auto result = device.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("vkWaitSemaphores failed with VkResult " +
+                                 std::to_string(static_cast<int32_t>(result)));
     }
-    throw std::runtime_error("Cannot find a compatible memory type");
 }
 
-void waitForFence(const vk::raii::Device &device, const vk::raii::Fence &fence) {
-    const auto result = device.waitForFences(*fence, true, std::numeric_limits<uint64_t>::max());
-    if (result != vk::Result::eSuccess) {
-        throw std::runtime_error("vkWaitForFences failed with VkResult " +
-                                 std::to_string(static_cast<int32_t>(result)));
+std::vector<vk::SemaphoreSubmitInfo> semaphoreSubmitInfos(const std::vector<Session::SemaphoreInfo> &semaphores) {
+    std::vector<vk::SemaphoreSubmitInfo> submitInfos;
+    submitInfos.reserve(semaphores.size() + 1);
+    for (const auto &semaphore : semaphores) {
+        submitInfos.emplace_back(semaphore.semaphore, semaphore.value, semaphore.stageMask);
     }
+    return submitInfos;
 }
 
 vk::PipelineBindPoint bindPoint(vgflib::ModuleType type) {
@@ -133,12 +122,6 @@ vk::DeviceSize resourceByteSize(const ResourceInfo &resource) {
     return elements;
 }
 
-void validateImageFormat(vk::Format format) {
-    if (format != vk::Format::eR8G8B8A8Snorm) {
-        throw std::runtime_error("Session only supports eR8G8B8A8Snorm VGF image resources");
-    }
-}
-
 vk::Extent3D imageExtent(const ResourceInfo &resource) {
     validateImageFormat(resource.format);
     if (resource.shape.size() == 4 && resource.shape[0] == 1 && resource.shape[3] == 4) {
@@ -147,17 +130,6 @@ vk::Extent3D imageExtent(const ResourceInfo &resource) {
     throw std::runtime_error("Session only supports 4D NHWC VGF image resources with batch 1 and 4 channels");
 }
 
-vk::ImageLayout imageLayout(vk::DescriptorType descriptorType) {
-    switch (descriptorType) {
-    case vk::DescriptorType::eCombinedImageSampler:
-        return vk::ImageLayout::eShaderReadOnlyOptimal;
-    case vk::DescriptorType::eStorageImage:
-        return vk::ImageLayout::eGeneral;
-    default:
-        throw std::runtime_error("Descriptor type is not an image descriptor");
-    }
-}
-
 vk::ImageUsageFlags imageUsage(vk::DescriptorType descriptorType, bool aliased) {
     vk::ImageUsageFlags usage{};
     switch (descriptorType) {
@@ -187,6 +159,71 @@ vk::AccessFlags2 imageAccess(vgflib::ModuleType type, vk::DescriptorType descrip
     throw std::runtime_error("Descriptor type is not an image descriptor");
 }
 
+uint64_t boundKey(uint32_t batchIndex, uint32_t resourceIndex) {
+    return (static_cast<uint64_t>(batchIndex) << 32) | resourceIndex;
+}
+
+void insertFullMemoryBarrier(vk::raii::CommandBuffer &commandBuffer) {
+    vk::MemoryBarrier2 memoryBarrier;
+    memoryBarrier.srcStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+    memoryBarrier.srcAccessMask = vk::AccessFlagBits2::eMemoryWrite;
+    memoryBarrier.dstStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+    memoryBarrier.dstAccessMask = vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eMemoryWrite;
+    vk::DependencyInfo dependencyInfo;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    commandBuffer.pipelineBarrier2(dependencyInfo);
+}
+
+vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+    return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+}
+
+/** @brief Intermediate resource live from its first to its last segment, placed at @p offset in an arena. */
+struct ArenaInterval {
+    size_t firstSegment = 0;
+    size_t lastSegment = 0;
+    vk::DeviceSize size = 0;
+    vk::DeviceSize alignment = 1;
+    vk::DeviceSize offset = 0;
+};
+
+// Greedy-by-size interval placement: larger intervals are placed first, each at the lowest aligned offset that does
+// not overlap an already placed interval with an intersecting lifetime. Returns the resulting arena size.
+vk::DeviceSize assignArenaOffsets(std::vector<ArenaInterval> &intervals) {
+    std::vector<size_t> order(intervals.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&intervals](size_t lhs, size_t rhs) { return intervals[lhs].size > intervals[rhs].size; });
+
+    vk::DeviceSize arenaSize = 0;
+    std::vector<size_t> placed;
+    placed.reserve(intervals.size());
+    for (const auto index : order) {
+        auto &interval = intervals[index];
+        std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>> liveRanges;
+        for (const auto placedIndex : placed) {
+            const auto &other = intervals[placedIndex];
+            if (other.firstSegment <= interval.lastSegment && interval.firstSegment <= other.lastSegment) {
+                liveRanges.emplace_back(other.offset, other.offset + other.size);
+            }
+        }
+        std::sort(liveRanges.begin(), liveRanges.end());
+
+        vk::DeviceSize offset = 0;
+        for (const auto &[begin, end] : liveRanges) {
+            if (alignUp(offset, interval.alignment) + interval.size <= begin) {
+                break;
+            }
+            offset = std::max(offset, end);
+        }
+        interval.offset = alignUp(offset, interval.alignment);
+        arenaSize = std::max(arenaSize, interval.offset + interval.size);
+        placed.push_back(index);
+    }
+    return arenaSize;
+}
+
 std::string resourceCategoryName(vgflib::ResourceCategory category) {
     switch (category) {
     case vgflib::ResourceCategory::INPUT:
@@ -230,38 +267,68 @@ struct Session::Impl {
 
     struct SegmentState {
         // Common members
-        vgflib::ModuleType type;
-        vk::raii::ShaderModule shaderModule{nullptr};
-        std::vector<vk::raii::DescriptorSetLayout> descriptorSetLayouts;
-        vk::raii::PipelineLayout pipelineLayout{nullptr};
-        vk::raii::Pipeline pipeline{nullptr};
-        std::vector<vk::raii::DeviceMemory> sessionMemory;
-        vk::raii::DescriptorPool descriptorPool{nullptr};
-        std::vector<vk::raii::DescriptorSet> descriptorSets;
-        std::vector<DescriptorBindingInfo> bindings;
+        const CompiledSegment *compiled = nullptr;
+        // Descriptor sets of every batch entry, indexed by batch then by set
+        std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets;
         // Graph
         vk::raii::DataGraphPipelineSessionARM graphSession{nullptr};
-        // Shader
-        std::array<uint32_t, 3> dispatchShape = {};
+        vk::DeviceSize sessionMemoryBytes = 0;
+    };
+
+    /** @brief Allocations made through the session allocator, released after every object bound to them. */
+    struct OwnedAllocations {
+        OwnedAllocations() = default;
+        OwnedAllocations(const OwnedAllocations &) = delete;
+        OwnedAllocations &operator=(const OwnedAllocations &) = delete;
+        ~OwnedAllocations() {
+            for (auto allocation = allocations.rbegin(); allocation != allocations.rend(); ++allocation) {
+                try {
+                    allocator->free(*allocation);
+                } catch (const std::exception &) {
+                    // Destructors must not throw; a failing allocator leaks the allocation
+                }
+            }
+        }
+
+        std::shared_ptr<Allocator> allocator;
+        std::vector<MemoryAllocation> allocations;
+    };
+
+    struct Submission {
+        vk::raii::CommandBuffer commandBuffer{nullptr};
+        // Timeline value signalled when the last use of commandBuffer completes
+        uint64_t value = 0;
+        // First of the two timestamp queries per segment written by this submission when profiling
+        uint32_t firstQuery = 0;
     };
 
     Impl(const vk::raii::PhysicalDevice &physicalDeviceIn, const vk::raii::Device &deviceIn,
-         uint32_t queueFamilyIndexIn, const vk::raii::Queue &queueIn, const VGF &vgfIn)
-        : physicalDevice(physicalDeviceIn), device(deviceIn), vgf(vgfIn), queueFamilyIndex(queueFamilyIndexIn),
-          queue(queueIn) {}
+         uint32_t queueFamilyIndexIn, const vk::raii::Queue &queueIn, const VGF &vgfIn,
+         std::shared_ptr<const CompiledGraph> graphIn = nullptr)
+        : physicalDevice(physicalDeviceIn), device(deviceIn), vgf(vgfIn), graph(std::move(graphIn)),
+          queueFamilyIndex(queueFamilyIndexIn), queue(queueIn) {
+        resources.reserve(vgf.getNumResources());
+        for (uint32_t resourceIndex = 0; resourceIndex < vgf.getNumResources(); ++resourceIndex) {
+            resources.push_back(vgf.getResource(resourceIndex));
+        }
+    }
+    ~Impl();
+
+    const ResourceInfo &getResource(uint32_t resourceIndex) const;
 
-    const BoundTensor *findBoundTensor(uint32_t resourceIndex) const;
-    const BoundBuffer *findBoundBuffer(uint32_t resourceIndex) const;
+    const BoundTensor *findBoundTensor(uint32_t resourceIndex, uint32_t batchIndex = 0) const;
+    const BoundBuffer *findBoundBuffer(uint32_t resourceIndex, uint32_t batchIndex = 0) const;
     const BoundTensor *findBoundTensorInAliasGroup(uint32_t aliasGroupId) const;
     const BoundBuffer *findBoundBufferInAliasGroup(uint32_t aliasGroupId) const;
-    const BoundImage *findBoundImage(uint32_t resourceIndex) const;
+    const BoundImage *findBoundImage(uint32_t resourceIndex, uint32_t batchIndex = 0) const;
     const BoundImage *findBoundImageInAliasGroup(uint32_t aliasGroupId) const;
     void updateDescriptorSets(const std::vector<vk::raii::DescriptorSet> &descriptorSets,
-                              const std::vector<DescriptorBindingInfo> &bindings) const;
+                              const std::vector<DescriptorBindingInfo> &bindings, uint32_t batchIndex) const;
     void insertInitialImageLayoutTransitions(vk::raii::CommandBuffer &commandBuffer);
-    void insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer, const SegmentState &producer,
-                              const SegmentState &consumer) const;
-    void configureSegment(uint32_t segmentIndex);
+    void insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer, const CompiledSegment &producer,
+                              const CompiledSegment &consumer, uint32_t batchIndex) const;
+    void configureSegment(const CompiledSegment &compiled);
+    void allocateDescriptorSets();
     void allocateResources();
     vk::raii::TensorARM createIntermediateTensor(const DescriptorBindingInfo &binding) const;
     vk::raii::Buffer createIntermediateBuffer(const DescriptorBindingInfo &binding) const;
@@ -270,114 +337,174 @@ struct Session::Impl {
     void allocateIntermediateBuffer(const DescriptorBindingInfo &binding);
     void allocateIntermediateImage(const DescriptorBindingInfo &binding);
     void allocateAliasedResources(const std::vector<DescriptorBindingInfo> &bindings);
+    void allocateIntermediateArenas(const std::vector<DescriptorBindingInfo> &bindings);
+    MemoryAllocation allocateMemory(const vk::MemoryRequirements &memoryRequirements);
     void addBoundTensor(vk::TensorARM tensor, DescriptorBindingInfo binding,
-                        BoundMemoryInfo memory = BoundMemoryInfo());
-    void addBoundBuffer(vk::Buffer buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory = BoundMemoryInfo());
+                        BoundMemoryInfo memory = BoundMemoryInfo(), uint32_t batchIndex = 0);
+    void addBoundBuffer(vk::Buffer buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory = BoundMemoryInfo(),
+                        uint32_t batchIndex = 0);
     void addBoundImage(vk::Image image, DescriptorBindingInfo binding, BoundMemoryInfo memory = BoundMemoryInfo(),
-                       vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined);
-
-    void bindTensor(const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding, BoundMemoryInfo memory);
-    void bindBuffer(const vk::raii::Buffer &buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory);
-    void bindImage(const vk::raii::Image &image, DescriptorBindingInfo binding, BoundMemoryInfo memory,
-                   vk::ImageLayout currentLayout);
-
-    void configure();
-
-    void run();
+                       vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined, uint32_t batchIndex = 0);
+
+    void validateManualBinding(const DescriptorBindingInfo &binding, uint32_t batchIndex) const;
+    void bindTensor(uint32_t batchIndex, const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding,
+                    BoundMemoryInfo memory);
+    void bindBuffer(uint32_t batchIndex, const vk::raii::Buffer &buffer, DescriptorBindingInfo binding,
+                    BoundMemoryInfo memory);
+    void bindImage(uint32_t batchIndex, const vk::raii::Image &image, DescriptorBindingInfo binding,
+                   BoundMemoryInfo memory, vk::ImageLayout currentLayout);
+
+    void configure(const std::vector<CompiledSegment> &compiledSegments);
+
+    uint32_t queryCount() const { return static_cast<uint32_t>(segments.size()) * 2 * batchSize; }
+    void recordCommandBuffer(vk::raii::CommandBuffer &commandBuffer, uint32_t firstQuery);
+    std::vector<SegmentTiming> getSegmentTimings(uint64_t value) const;
+    uint64_t submit(const std::vector<SemaphoreInfo> &waitSemaphores,
+                    const std::vector<SemaphoreInfo> &signalSemaphores);
+    void wait(uint64_t value) const;
+    bool poll(uint64_t value) const;
 
     const vk::raii::PhysicalDevice &physicalDevice;
     const vk::raii::Device &device;
     const VGF &vgf;
+    std::shared_ptr<const CompiledGraph> graph;
+    // Decoded once, the VGF decoder re-reads the resource table on every lookup
+    std::vector<ResourceInfo> resources;
 
     uint32_t queueFamilyIndex = 0;
     const vk::raii::Queue &queue;
 
-    std::vector<vk::raii::DeviceMemory> ownedMemory;
+    // Declared before every object bound to the allocations so that they are released last
+    OwnedAllocations ownedMemory;
     std::vector<vk::raii::TensorARM> ownedTensors;
     std::vector<vk::raii::Buffer> ownedBuffers;
     std::vector<vk::raii::Image> ownedImages;
     std::vector<BoundTensor> boundTensors;
     std::vector<BoundBuffer> boundBuffers;
     std::vector<BoundImage> boundImages;
+    // Latest bound object per batch and resource index (see boundKey) and per alias group, as positions in the
+    // vectors above
+    std::unordered_map<uint64_t, size_t> boundTensorIndices;
+    std::unordered_map<uint64_t, size_t> boundBufferIndices;
+    std::unordered_map<uint64_t, size_t> boundImageIndices;
+    std::unordered_map<uint32_t, size_t> boundTensorAliasGroups;
+    std::unordered_map<uint32_t, size_t> boundBufferAliasGroups;
+    std::unordered_map<uint32_t, size_t> boundImageAliasGroups;
+    vk::raii::DescriptorPool descriptorPool{nullptr};
     std::vector<SegmentState> segments;
+    uint32_t batchSize = 1;
+    bool aliasIntermediates = false;
+    std::set<uint32_t> arenaResourceIndices;
+    IntermediateMemoryInfo intermediateMemory;
+    std::vector<vk::DeviceSize> intermediateAllocationBytes;
 
     vk::raii::CommandPool commandPool{nullptr};
-    vk::raii::CommandBuffer commandBuffer{nullptr};
-    vk::raii::Fence fence{nullptr};
+    std::vector<Submission> submissions;
+    size_t nextSubmission = 0;
+    vk::raii::Semaphore timelineSemaphore{nullptr};
+    uint64_t submittedValue = 0;
+    bool descriptorSetsDirty = true;
+    bool profiling = false;
+    vk::raii::QueryPool queryPool{nullptr};
+    float timestampPeriod = 1.0f;
+    uint64_t timestampMask = std::numeric_limits<uint64_t>::max();
     bool configured = false;
 };
 
+Session::Impl::~Impl() {
+    // Pending submissions reference the command buffers and descriptor sets destroyed with the session
+    if (submittedValue > 0) {
+        try {
+            wait(submittedValue);
+        } catch (const std::exception &) {
+            // Nothing sensible can be done about a lost device during destruction
+        }
+    }
+}
+
 Session::Session(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device,
                  uint32_t queueFamilyIndex, const vk::raii::Queue &queue, const VGF &vgf)
     : impl_(std::make_unique<Impl>(physicalDevice, device, queueFamilyIndex, queue, vgf)) {}
 
+Session::Session(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device,
+                 uint32_t queueFamilyIndex, const vk::raii::Queue &queue, std::shared_ptr<const CompiledGraph> graph) {
+    if (graph == nullptr) {
+        throw std::runtime_error("Session requires a compiled graph");
+    }
+    if (*graph->impl_->device != *device) {
+        throw std::runtime_error("Compiled graph was created for a different device");
+    }
+    const auto &vgf = graph->getVGF();
+    impl_ = std::make_unique<Impl>(physicalDevice, device, queueFamilyIndex, queue, vgf, std::move(graph));
+}
+
 Session::~Session() = default;
 
-const Session::Impl::BoundTensor *Session::Impl::findBoundTensor(uint32_t resourceIndex) const {
-    const auto tensor =
-        std::find_if(boundTensors.rbegin(), boundTensors.rend(), [resourceIndex](const auto &boundTensor) {
-            return boundTensor.binding.resourceIndex == resourceIndex;
-        });
-    if (tensor == boundTensors.rend()) {
+const ResourceInfo &Session::Impl::getResource(uint32_t resourceIndex) const {
+    if (resourceIndex >= resources.size()) {
+        throw std::runtime_error("VGF resource " + std::to_string(resourceIndex) + " does not exist");
+    }
+    return resources[resourceIndex];
+}
+
+const Session::Impl::BoundTensor *Session::Impl::findBoundTensor(uint32_t resourceIndex, uint32_t batchIndex) const {
+    // Batch entries without their own binding share the one of the first entry
+    auto tensor = boundTensorIndices.find(boundKey(batchIndex, resourceIndex));
+    if (tensor == boundTensorIndices.end() && batchIndex != 0) {
+        tensor = boundTensorIndices.find(boundKey(0, resourceIndex));
+    }
+    if (tensor == boundTensorIndices.end()) {
         throw std::runtime_error("No tensor bound for VGF resource " + std::to_string(resourceIndex));
     }
-    return &*tensor;
+    return &boundTensors[tensor->second];
 }
 
-const Session::Impl::BoundBuffer *Session::Impl::findBoundBuffer(uint32_t resourceIndex) const {
-    const auto buffer =
-        std::find_if(boundBuffers.rbegin(), boundBuffers.rend(), [resourceIndex](const auto &boundBuffer) {
-            return boundBuffer.binding.resourceIndex == resourceIndex;
-        });
-    if (buffer == boundBuffers.rend()) {
+const Session::Impl::BoundBuffer *Session::Impl::findBoundBuffer(uint32_t resourceIndex, uint32_t batchIndex) const {
+    // Batch entries without their own binding share the one of the first entry
+    auto buffer = boundBufferIndices.find(boundKey(batchIndex, resourceIndex));
+    if (buffer == boundBufferIndices.end() && batchIndex != 0) {
+        buffer = boundBufferIndices.find(boundKey(0, resourceIndex));
+    }
+    if (buffer == boundBufferIndices.end()) {
         throw std::runtime_error("No buffer bound for VGF resource " + std::to_string(resourceIndex));
     }
-    return &*buffer;
+    return &boundBuffers[buffer->second];
 }
 
 const Session::Impl::BoundTensor *Session::Impl::findBoundTensorInAliasGroup(uint32_t aliasGroupId) const {
-    const auto tensor =
-        std::find_if(boundTensors.rbegin(), boundTensors.rend(), [this, aliasGroupId](const auto &boundTensor) {
-            const auto resource = vgf.getResource(boundTensor.binding.resourceIndex);
-            return resource.aliasGroupId.has_value() && *resource.aliasGroupId == aliasGroupId;
-        });
-    return tensor != boundTensors.rend() ? &*tensor : nullptr;
+    const auto tensor = boundTensorAliasGroups.find(aliasGroupId);
+    return tensor != boundTensorAliasGroups.end() ? &boundTensors[tensor->second] : nullptr;
 }
 
 const Session::Impl::BoundBuffer *Session::Impl::findBoundBufferInAliasGroup(uint32_t aliasGroupId) const {
-    const auto buffer =
-        std::find_if(boundBuffers.rbegin(), boundBuffers.rend(), [this, aliasGroupId](const auto &boundBuffer) {
-            const auto resource = vgf.getResource(boundBuffer.binding.resourceIndex);
-            return resource.aliasGroupId.has_value() && *resource.aliasGroupId == aliasGroupId;
-        });
-    return buffer != boundBuffers.rend() ? &*buffer : nullptr;
-}
-
-const Session::Impl::BoundImage *Session::Impl::findBoundImage(uint32_t resourceIndex) const {
-    const auto image = std::find_if(boundImages.rbegin(), boundImages.rend(), [resourceIndex](const auto &boundImage) {
-        return boundImage.binding.resourceIndex == resourceIndex;
-    });
-    if (image == boundImages.rend()) {
+    const auto buffer = boundBufferAliasGroups.find(aliasGroupId);
+    return buffer != boundBufferAliasGroups.end() ? &boundBuffers[buffer->second] : nullptr;
+}
+
+const Session::Impl::BoundImage *Session::Impl::findBoundImage(uint32_t resourceIndex, uint32_t batchIndex) const {
+    // Batch entries without their own binding share the one of the first entry
+    auto image = boundImageIndices.find(boundKey(batchIndex, resourceIndex));
+    if (image == boundImageIndices.end() && batchIndex != 0) {
+        image = boundImageIndices.find(boundKey(0, resourceIndex));
+    }
+    if (image == boundImageIndices.end()) {
         throw std::runtime_error("No image bound for VGF resource " + std::to_string(resourceIndex));
     }
-    return &*image;
+    return &boundImages[image->second];
 }
 
 const Session::Impl::BoundImage *Session::Impl::findBoundImageInAliasGroup(uint32_t aliasGroupId) const {
-    const auto image =
-        std::find_if(boundImages.rbegin(), boundImages.rend(), [this, aliasGroupId](const auto &boundImage) {
-            const auto resource = vgf.getResource(boundImage.binding.resourceIndex);
-            return resource.aliasGroupId.has_value() && *resource.aliasGroupId == aliasGroupId;
-        });
-    return image != boundImages.rend() ? &*image : nullptr;
+    const auto image = boundImageAliasGroups.find(aliasGroupId);
+    return image != boundImageAliasGroups.end() ? &boundImages[image->second] : nullptr;
 }
 
 void Session::Impl::updateDescriptorSets(const std::vector<vk::raii::DescriptorSet> &descriptorSets,
-                                         const std::vector<DescriptorBindingInfo> &bindings) const {
+                                         const std::vector<DescriptorBindingInfo> &bindings,
+                                         uint32_t batchIndex) const {
     for (const auto &binding : bindings) {
         switch (binding.descriptorType) {
         case vk::DescriptorType::eTensorARM: {
-            const auto *const tensor = findBoundTensor(binding.resourceIndex);
+            const auto *const tensor = findBoundTensor(binding.resourceIndex, batchIndex);
             const auto tensorView = *tensor->tensorView;
             const vk::WriteDescriptorSetTensorARM tensorInfo(1, &tensorView);
             const vk::WriteDescriptorSet write(*descriptorSets[binding.set], binding.binding, 0, 1,
@@ -386,7 +513,7 @@ void Session::Impl::updateDescriptorSets(const std::vector<vk::raii::DescriptorS
             break;
         }
         case vk::DescriptorType::eStorageBuffer: {
-            const auto *const buffer = findBoundBuffer(binding.resourceIndex);
+            const auto *const buffer = findBoundBuffer(binding.resourceIndex, batchIndex);
             const vk::DescriptorBufferInfo bufferInfo(buffer->buffer, 0, vk::WholeSize);
             const vk::WriteDescriptorSet write(*descriptorSets[binding.set], binding.binding, 0, 1,
                                                binding.descriptorType, nullptr, &bufferInfo);
@@ -395,7 +522,7 @@ void Session::Impl::updateDescriptorSets(const std::vector<vk::raii::DescriptorS
         }
         case vk::DescriptorType::eCombinedImageSampler:
         case vk::DescriptorType::eStorageImage: {
-            const auto *const image = findBoundImage(binding.resourceIndex);
+            const auto *const image = findBoundImage(binding.resourceIndex, batchIndex);
             const vk::DescriptorImageInfo imageInfo(
                 binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ? *image->sampler : vk::Sampler(),
                 *image->imageView, image->layout);
@@ -413,24 +540,30 @@ void Session::Impl::updateDescriptorSets(const std::vector<vk::raii::DescriptorS
 
 void Session::Impl::insertInitialImageLayoutTransitions(vk::raii::CommandBuffer &commandBuffer) {
     std::vector<vk::ImageMemoryBarrier2> imageBarriers;
-    std::vector<vk::Image> transitionedImages;
+    std::set<vk::Image> transitionedImages;
     imageBarriers.reserve(boundImages.size());
+    if (boundImages.empty()) {
+        return;
+    }
+
+    std::unordered_map<uint32_t, const SegmentState *> firstConsumers;
+    for (const auto &segment : segments) {
+        for (const auto &binding : segment.compiled->bindings) {
+            firstConsumers.emplace(binding.resourceIndex, &segment);
+        }
+    }
 
     for (auto &boundImage : boundImages) {
-        if (std::find(transitionedImages.begin(), transitionedImages.end(), boundImage.image) !=
-            transitionedImages.end()) {
+        if (transitionedImages.count(boundImage.image) != 0) {
             continue;
         }
 
-        const auto firstConsumer = std::find_if(segments.begin(), segments.end(), [&boundImage](const auto &segment) {
-            return std::any_of(segment.bindings.begin(), segment.bindings.end(), [&boundImage](const auto &binding) {
-                return binding.resourceIndex == boundImage.binding.resourceIndex;
-            });
-        });
-        if (firstConsumer == segments.end()) {
+        const auto consumer = firstConsumers.find(boundImage.binding.resourceIndex);
+        if (consumer == firstConsumers.end()) {
             throw std::runtime_error("No segment uses VGF image resource " +
                                      std::to_string(boundImage.binding.resourceIndex));
         }
+        const auto *const firstConsumer = consumer->second;
 
         vk::ImageMemoryBarrier2 imageBarrier;
         imageBarrier.srcStageMask = boundImage.currentLayout == vk::ImageLayout::eUndefined
@@ -439,8 +572,8 @@ void Session::Impl::insertInitialImageLayoutTransitions(vk::raii::CommandBuffer
         imageBarrier.srcAccessMask = boundImage.currentLayout == vk::ImageLayout::eUndefined
                                          ? vk::AccessFlags2{}
                                          : vk::AccessFlagBits2::eMemoryWrite;
-        imageBarrier.dstStageMask = pipelineStage(firstConsumer->type);
-        imageBarrier.dstAccessMask = imageAccess(firstConsumer->type, boundImage.binding.descriptorType);
+        imageBarrier.dstStageMask = pipelineStage(firstConsumer->compiled->type);
+        imageBarrier.dstAccessMask = imageAccess(firstConsumer->compiled->type, boundImage.binding.descriptorType);
         imageBarrier.oldLayout = boundImage.currentLayout;
         imageBarrier.newLayout = boundImage.layout;
         imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -448,7 +581,7 @@ void Session::Impl::insertInitialImageLayoutTransitions(vk::raii::CommandBuffer
         imageBarrier.image = boundImage.image;
         imageBarrier.subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
         imageBarriers.push_back(imageBarrier);
-        transitionedImages.push_back(boundImage.image);
+        transitionedImages.insert(boundImage.image);
         boundImage.currentLayout = boundImage.layout;
     }
 
@@ -462,8 +595,8 @@ void Session::Impl::insertInitialImageLayoutTransitions(vk::raii::CommandBuffer
     commandBuffer.pipelineBarrier2(dependencyInfo);
 }
 
-void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer, const SegmentState &producer,
-                                         const SegmentState &consumer) const {
+void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer, const CompiledSegment &producer,
+                                         const CompiledSegment &consumer, uint32_t batchIndex) const {
     std::vector<vk::MemoryBarrier2> memoryBarriers;
     std::vector<vk::TensorMemoryBarrierARM> tensorBarriers;
     std::vector<vk::BufferMemoryBarrier2> bufferBarriers;
@@ -471,15 +604,27 @@ void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer,
     std::vector<uint32_t> barrierAliasGroupIds;
     std::vector<uint32_t> barrierResourceIndices;
 
+    if (!arenaResourceIndices.empty()) {
+        // Arena intermediates reuse memory of intermediates that died in earlier segments, so every segment boundary
+        // must order prior reads and writes before the overwrite
+        vk::MemoryBarrier2 memoryBarrier;
+        memoryBarrier.srcStageMask = pipelineStage(producer.type);
+        memoryBarrier.srcAccessMask = readAccess(producer.type) | writeAccess(producer.type);
+        memoryBarrier.dstStageMask = pipelineStage(consumer.type);
+        memoryBarrier.dstAccessMask = readAccess(consumer.type) | writeAccess(consumer.type);
+        memoryBarriers.push_back(memoryBarrier);
+    }
+
     for (const auto &producerBinding : producer.bindings) {
         if ((producerBinding.resourceCategory != vgflib::ResourceCategory::OUTPUT &&
              producerBinding.resourceCategory != vgflib::ResourceCategory::INTERMEDIATE) ||
             std::find(barrierResourceIndices.begin(), barrierResourceIndices.end(), producerBinding.resourceIndex) !=
-                barrierResourceIndices.end()) {
+                barrierResourceIndices.end() ||
+            arenaResourceIndices.count(producerBinding.resourceIndex) != 0) {
             continue;
         }
 
-        const auto resource = vgf.getResource(producerBinding.resourceIndex);
+        const auto &resource = getResource(producerBinding.resourceIndex);
         if (resource.aliasGroupId.has_value()) {
             if (std::find(barrierAliasGroupIds.begin(), barrierAliasGroupIds.end(), *resource.aliasGroupId) !=
                 barrierAliasGroupIds.end()) {
@@ -499,7 +644,7 @@ void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer,
 
         switch (producerBinding.descriptorType) {
         case vk::DescriptorType::eTensorARM: {
-            const auto *const tensor = findBoundTensor(producerBinding.resourceIndex);
+            const auto *const tensor = findBoundTensor(producerBinding.resourceIndex, batchIndex);
             vk::TensorMemoryBarrierARM tensorBarrier;
             tensorBarrier.srcStageMask = pipelineStage(producer.type);
             tensorBarrier.srcAccessMask = writeAccess(producer.type);
@@ -514,7 +659,7 @@ void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer,
             break;
         }
         case vk::DescriptorType::eStorageBuffer: {
-            const auto *const buffer = findBoundBuffer(producerBinding.resourceIndex);
+            const auto *const buffer = findBoundBuffer(producerBinding.resourceIndex, batchIndex);
             vk::BufferMemoryBarrier2 bufferBarrier;
             bufferBarrier.srcStageMask = pipelineStage(producer.type);
             bufferBarrier.srcAccessMask = writeAccess(producer.type);
@@ -532,7 +677,7 @@ void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer,
         }
         case vk::DescriptorType::eCombinedImageSampler:
         case vk::DescriptorType::eStorageImage: {
-            const auto *const image = findBoundImage(producerBinding.resourceIndex);
+            const auto *const image = findBoundImage(producerBinding.resourceIndex, batchIndex);
             vk::ImageMemoryBarrier2 imageBarrier;
             imageBarrier.srcStageMask = pipelineStage(producer.type);
             imageBarrier.srcAccessMask = writeAccess(producer.type);
@@ -574,19 +719,32 @@ void Session::Impl::insertSegmentBarrier(vk::raii::CommandBuffer &commandBuffer,
     commandBuffer.pipelineBarrier2(dependencyInfo);
 }
 
-void Session::Impl::addBoundTensor(vk::TensorARM tensor, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+void Session::Impl::addBoundTensor(vk::TensorARM tensor, DescriptorBindingInfo binding, BoundMemoryInfo memory,
+                                   uint32_t batchIndex) {
+    const auto &resource = getResource(binding.resourceIndex);
     const vk::TensorViewCreateInfoARM viewCreateInfo({}, tensor, resource.format);
     boundTensors.push_back({binding, tensor, vk::raii::TensorViewARM(device, viewCreateInfo), memory});
+    boundTensorIndices[boundKey(batchIndex, binding.resourceIndex)] = boundTensors.size() - 1;
+    if (resource.aliasGroupId.has_value()) {
+        boundTensorAliasGroups[*resource.aliasGroupId] = boundTensors.size() - 1;
+    }
+    descriptorSetsDirty = true;
 }
 
-void Session::Impl::addBoundBuffer(vk::Buffer buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
+void Session::Impl::addBoundBuffer(vk::Buffer buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory,
+                                   uint32_t batchIndex) {
+    const auto &resource = getResource(binding.resourceIndex);
     boundBuffers.push_back({binding, buffer, memory});
+    boundBufferIndices[boundKey(batchIndex, binding.resourceIndex)] = boundBuffers.size() - 1;
+    if (resource.aliasGroupId.has_value()) {
+        boundBufferAliasGroups[*resource.aliasGroupId] = boundBuffers.size() - 1;
+    }
+    descriptorSetsDirty = true;
 }
 
 void Session::Impl::addBoundImage(vk::Image image, DescriptorBindingInfo binding, BoundMemoryInfo memory,
-                                  vk::ImageLayout currentLayout) {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+                                  vk::ImageLayout currentLayout, uint32_t batchIndex) {
+    const auto &resource = getResource(binding.resourceIndex);
     validateImageFormat(resource.format);
     const vk::ImageSubresourceRange subresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
     const vk::ImageViewCreateInfo viewCreateInfo({}, image, vk::ImageViewType::e2D, resource.format, {},
@@ -604,39 +762,49 @@ void Session::Impl::addBoundImage(vk::Image image, DescriptorBindingInfo binding
 
     boundImages.push_back({binding, image, vk::raii::ImageView(device, viewCreateInfo), std::move(sampler), memory,
                            currentLayout, imageLayout(binding.descriptorType)});
+    boundImageIndices[boundKey(batchIndex, binding.resourceIndex)] = boundImages.size() - 1;
+    if (resource.aliasGroupId.has_value()) {
+        boundImageAliasGroups[*resource.aliasGroupId] = boundImages.size() - 1;
+    }
+    descriptorSetsDirty = true;
 }
 
-void Session::Impl::bindTensor(const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding,
-                               BoundMemoryInfo memory) {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+void Session::Impl::validateManualBinding(const DescriptorBindingInfo &binding, uint32_t batchIndex) const {
+    const auto &resource = getResource(binding.resourceIndex);
     if (resource.category != vgflib::ResourceCategory::INPUT && resource.category != vgflib::ResourceCategory::OUTPUT) {
         throw std::runtime_error(std::string("VGF ") + resourceCategoryName(resource.category) + " resource " +
                                  std::to_string(binding.resourceIndex) + " must not be manually bound");
     }
-    addBoundTensor(*tensor, binding, memory);
+    if (batchIndex >= batchSize) {
+        throw std::runtime_error("Batch index " + std::to_string(batchIndex) + " is out of range for batch size " +
+                                 std::to_string(batchSize));
+    }
+    if (batchIndex != 0 && resource.aliasGroupId.has_value()) {
+        throw std::runtime_error("Aliased VGF resource " + std::to_string(binding.resourceIndex) +
+                                 " can only be bound for batch index 0");
+    }
 }
 
-void Session::Impl::bindBuffer(const vk::raii::Buffer &buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
-    const auto resource = vgf.getResource(binding.resourceIndex);
-    if (resource.category != vgflib::ResourceCategory::INPUT && resource.category != vgflib::ResourceCategory::OUTPUT) {
-        throw std::runtime_error(std::string("VGF ") + resourceCategoryName(resource.category) + " resource " +
-                                 std::to_string(binding.resourceIndex) + " must not be manually bound");
-    }
-    addBoundBuffer(*buffer, binding, memory);
+void Session::Impl::bindTensor(uint32_t batchIndex, const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding,
+                               BoundMemoryInfo memory) {
+    validateManualBinding(binding, batchIndex);
+    addBoundTensor(*tensor, binding, memory, batchIndex);
 }
 
-void Session::Impl::bindImage(const vk::raii::Image &image, DescriptorBindingInfo binding, BoundMemoryInfo memory,
-                              vk::ImageLayout currentLayout) {
-    const auto resource = vgf.getResource(binding.resourceIndex);
-    if (resource.category != vgflib::ResourceCategory::INPUT && resource.category != vgflib::ResourceCategory::OUTPUT) {
-        throw std::runtime_error(std::string("VGF ") + resourceCategoryName(resource.category) + " resource " +
-                                 std::to_string(binding.resourceIndex) + " must not be manually bound");
-    }
-    addBoundImage(*image, binding, memory, currentLayout);
+void Session::Impl::bindBuffer(uint32_t batchIndex, const vk::raii::Buffer &buffer, DescriptorBindingInfo binding,
+                               BoundMemoryInfo memory) {
+    validateManualBinding(binding, batchIndex);
+    addBoundBuffer(*buffer, binding, memory, batchIndex);
+}
+
+void Session::Impl::bindImage(uint32_t batchIndex, const vk::raii::Image &image, DescriptorBindingInfo binding,
+                              BoundMemoryInfo memory, vk::ImageLayout currentLayout) {
+    validateManualBinding(binding, batchIndex);
+    addBoundImage(*image, binding, memory, currentLayout, batchIndex);
 }
 
 vk::raii::TensorARM Session::Impl::createIntermediateTensor(const DescriptorBindingInfo &binding) const {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+    const auto &resource = getResource(binding.resourceIndex);
 
     const vk::TensorDescriptionARM description(vk::TensorTilingARM::eLinear, resource.format,
                                                static_cast<uint32_t>(resource.shape.size()), resource.shape.data(),
@@ -647,13 +815,13 @@ vk::raii::TensorARM Session::Impl::createIntermediateTensor(const DescriptorBind
 }
 
 vk::raii::Buffer Session::Impl::createIntermediateBuffer(const DescriptorBindingInfo &binding) const {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+    const auto &resource = getResource(binding.resourceIndex);
     return vk::raii::Buffer(
         device, vk::BufferCreateInfo({}, resourceByteSize(resource), vk::BufferUsageFlagBits::eStorageBuffer));
 }
 
 vk::raii::Image Session::Impl::createIntermediateImage(const DescriptorBindingInfo &binding, bool aliased) const {
-    const auto resource = vgf.getResource(binding.resourceIndex);
+    const auto &resource = getResource(binding.resourceIndex);
     const vk::ImageCreateInfo createInfo({}, vk::ImageType::e2D, resource.format, imageExtent(resource), 1, 1,
                                          vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal,
                                          imageUsage(binding.descriptorType, aliased), vk::SharingMode::eExclusive, {},
@@ -661,14 +829,27 @@ vk::raii::Image Session::Impl::createIntermediateImage(const DescriptorBindingIn
     return vk::raii::Image(device, createInfo);
 }
 
+MemoryAllocation Session::Impl::allocateMemory(const vk::MemoryRequirements &memoryRequirements) {
+    const auto allocation =
+        ownedMemory.allocator->allocate(memoryRequirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (!allocation.memory || allocation.size < memoryRequirements.size ||
+        (memoryRequirements.alignment != 0 && allocation.offset % memoryRequirements.alignment != 0)) {
+        ownedMemory.allocator->free(allocation);
+        throw std::runtime_error("Allocator returned memory that does not satisfy the requested size or alignment");
+    }
+    ownedMemory.allocations.push_back(allocation);
+    return allocation;
+}
+
 void Session::Impl::allocateIntermediateTensor(const DescriptorBindingInfo &binding) {
     auto ownedTensor = createIntermediateTensor(binding);
     const auto memoryRequirements =
         device.getTensorMemoryRequirementsARM(vk::TensorMemoryRequirementsInfoARM(*ownedTensor));
-    const auto memoryType = findMemoryType(physicalDevice, memoryRequirements.memoryRequirements.memoryTypeBits,
-                                           vk::MemoryPropertyFlagBits::eDeviceLocal);
-    ownedMemory.emplace_back(device, vk::MemoryAllocateInfo(memoryRequirements.memoryRequirements.size, memoryType));
-    device.bindTensorMemoryARM(vk::BindTensorMemoryInfoARM(*ownedTensor, *ownedMemory.back(), 0));
+    const auto allocation = allocateMemory(memoryRequirements.memoryRequirements);
+    device.bindTensorMemoryARM(vk::BindTensorMemoryInfoARM(*ownedTensor, allocation.memory, allocation.offset));
+    intermediateMemory.unaliasedBytes += memoryRequirements.memoryRequirements.size;
+    intermediateMemory.allocatedBytes += memoryRequirements.memoryRequirements.size;
+    intermediateAllocationBytes.push_back(memoryRequirements.memoryRequirements.size);
 
     ownedTensors.push_back(std::move(ownedTensor));
     addBoundTensor(ownedTensors.back(), binding);
@@ -677,10 +858,11 @@ void Session::Impl::allocateIntermediateTensor(const DescriptorBindingInfo &bind
 void Session::Impl::allocateIntermediateBuffer(const DescriptorBindingInfo &binding) {
     auto ownedBuffer = createIntermediateBuffer(binding);
     const auto memoryRequirements = ownedBuffer.getMemoryRequirements();
-    const auto memoryType =
-        findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
-    ownedMemory.emplace_back(device, vk::MemoryAllocateInfo(memoryRequirements.size, memoryType));
-    ownedBuffer.bindMemory(*ownedMemory.back(), 0);
+    const auto allocation = allocateMemory(memoryRequirements);
+    ownedBuffer.bindMemory(allocation.memory, allocation.offset);
+    intermediateMemory.unaliasedBytes += memoryRequirements.size;
+    intermediateMemory.allocatedBytes += memoryRequirements.size;
+    intermediateAllocationBytes.push_back(memoryRequirements.size);
 
     ownedBuffers.push_back(std::move(ownedBuffer));
     addBoundBuffer(ownedBuffers.back(), binding);
@@ -689,13 +871,14 @@ void Session::Impl::allocateIntermediateBuffer(const DescriptorBindingInfo &bind
 void Session::Impl::allocateIntermediateImage(const DescriptorBindingInfo &binding) {
     auto ownedImage = createIntermediateImage(binding, false);
     const auto memoryRequirements = ownedImage.getMemoryRequirements();
-    const auto memoryType =
-        findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
-    ownedMemory.emplace_back(device, vk::MemoryAllocateInfo(memoryRequirements.size, memoryType));
-    ownedImage.bindMemory(*ownedMemory.back(), 0);
+    const auto allocation = allocateMemory(memoryRequirements);
+    ownedImage.bindMemory(allocation.memory, allocation.offset);
+    intermediateMemory.unaliasedBytes += memoryRequirements.size;
+    intermediateMemory.allocatedBytes += memoryRequirements.size;
+    intermediateAllocationBytes.push_back(memoryRequirements.size);
 
     ownedImages.push_back(std::move(ownedImage));
-    addBoundImage(ownedImages.back(), binding, {*ownedMemory.back(), 0, memoryRequirements.size});
+    addBoundImage(ownedImages.back(), binding, {allocation.memory, allocation.offset, memoryRequirements.size});
 }
 
 void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBindingInfo> &bindings) {
@@ -703,7 +886,7 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
     std::vector<std::pair<DescriptorBindingInfo, vk::raii::Buffer>> buffers;
     std::vector<std::pair<DescriptorBindingInfo, vk::raii::Image>> images;
 
-    const auto aliasGroupId = *vgf.getResource(bindings.front().resourceIndex).aliasGroupId;
+    const auto aliasGroupId = *getResource(bindings.front().resourceIndex).aliasGroupId;
 
     std::optional<BoundMemoryInfo> aliasedMemory;
     auto setAliasedMemory = [&](BoundMemoryInfo memory) {
@@ -733,6 +916,7 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
 
     uint32_t memoryTypeBits = std::numeric_limits<uint32_t>::max();
     vk::DeviceSize memorySize = 0;
+    vk::DeviceSize memoryAlignment = 1;
     for (const auto &binding : bindings) {
         if (binding.descriptorType == vk::DescriptorType::eTensorARM) {
             if (binding.resourceCategory != vgflib::ResourceCategory::INTERMEDIATE) {
@@ -756,6 +940,8 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
                         .memoryRequirements;
                 memoryTypeBits &= memoryRequirements.memoryTypeBits;
                 memorySize = std::max(memorySize, memoryRequirements.size);
+                memoryAlignment = std::max(memoryAlignment, memoryRequirements.alignment);
+                intermediateMemory.unaliasedBytes += memoryRequirements.size;
                 tensors.emplace_back(binding, std::move(ownedTensor));
             }
         } else if (binding.descriptorType == vk::DescriptorType::eStorageBuffer) {
@@ -777,6 +963,8 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
                 const auto memoryRequirements = ownedBuffer.getMemoryRequirements();
                 memoryTypeBits &= memoryRequirements.memoryTypeBits;
                 memorySize = std::max(memorySize, memoryRequirements.size);
+                memoryAlignment = std::max(memoryAlignment, memoryRequirements.alignment);
+                intermediateMemory.unaliasedBytes += memoryRequirements.size;
                 buffers.emplace_back(binding, std::move(ownedBuffer));
             }
         } else if (binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
@@ -799,6 +987,8 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
                 const auto memoryRequirements = ownedImage.getMemoryRequirements();
                 memoryTypeBits &= memoryRequirements.memoryTypeBits;
                 memorySize = std::max(memorySize, memoryRequirements.size);
+                memoryAlignment = std::max(memoryAlignment, memoryRequirements.alignment);
+                intermediateMemory.unaliasedBytes += memoryRequirements.size;
                 images.emplace_back(binding, std::move(ownedImage));
             }
         } else {
@@ -812,63 +1002,75 @@ void Session::Impl::allocateAliasedResources(const std::vector<DescriptorBinding
     }
 
     // Allocate and add fully intermediate aliased resources
-    const auto memoryType = findMemoryType(physicalDevice, memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
-    ownedMemory.emplace_back(device, vk::MemoryAllocateInfo(memorySize, memoryType));
-    const vk::DeviceMemory memory = *ownedMemory.back();
+    if (memoryTypeBits == 0) {
+        throw std::runtime_error("Aliased VGF resources have no compatible memory type");
+    }
+    const auto allocation = allocateMemory(vk::MemoryRequirements(memorySize, memoryAlignment, memoryTypeBits));
+    const BoundMemoryInfo boundMemory{allocation.memory, allocation.offset, memorySize};
+    intermediateMemory.allocatedBytes += memorySize;
+    intermediateAllocationBytes.push_back(memorySize);
 
     for (auto &[binding, ownedTensor] : tensors) {
-        device.bindTensorMemoryARM(vk::BindTensorMemoryInfoARM(*ownedTensor, memory, 0));
+        device.bindTensorMemoryARM(vk::BindTensorMemoryInfoARM(*ownedTensor, allocation.memory, allocation.offset));
         ownedTensors.push_back(std::move(ownedTensor));
-        addBoundTensor(*ownedTensors.back(), binding, {*ownedMemory.back(), 0, memorySize});
+        addBoundTensor(*ownedTensors.back(), binding, boundMemory);
     }
 
     for (auto &[binding, ownedBuffer] : buffers) {
-        ownedBuffer.bindMemory(memory, 0);
+        ownedBuffer.bindMemory(allocation.memory, allocation.offset);
         ownedBuffers.push_back(std::move(ownedBuffer));
-        addBoundBuffer(*ownedBuffers.back(), binding, {*ownedMemory.back(), 0, memorySize});
+        addBoundBuffer(*ownedBuffers.back(), binding, boundMemory);
     }
 
     for (auto &[binding, ownedImage] : images) {
-        ownedImage.bindMemory(memory, 0);
+        ownedImage.bindMemory(allocation.memory, allocation.offset);
         ownedImages.push_back(std::move(ownedImage));
-        addBoundImage(*ownedImages.back(), binding, {*ownedMemory.back(), 0, memorySize});
+        addBoundImage(*ownedImages.back(), binding, boundMemory);
     }
 }
 
 void Session::Impl::allocateResources() {
-    std::vector<uint32_t> allocatedResourceIndices;
+    std::vector<bool> allocatedResources(resources.size(), false);
     std::map<uint32_t, std::vector<DescriptorBindingInfo>> aliasGroups;
+    std::vector<DescriptorBindingInfo> arenaBindings;
     for (const auto &segment : segments) {
-        for (const auto &binding : segment.bindings) {
+        for (const auto &binding : segment.compiled->bindings) {
             // Skip if already present
-            if (std::find(allocatedResourceIndices.begin(), allocatedResourceIndices.end(), binding.resourceIndex) !=
-                allocatedResourceIndices.end()) {
+            const auto &resource = getResource(binding.resourceIndex);
+            if (allocatedResources[binding.resourceIndex]) {
                 continue;
             }
 
             // Only allocate non-aliased resources in current loop
-            const auto resource = vgf.getResource(binding.resourceIndex);
             if (binding.resourceCategory != vgflib::ResourceCategory::INTERMEDIATE) {
                 // If aliased Input/Output
                 if (resource.aliasGroupId.has_value()) {
                     aliasGroups[*resource.aliasGroupId].push_back(binding);
                 }
-                allocatedResourceIndices.push_back(binding.resourceIndex);
+                allocatedResources[binding.resourceIndex] = true;
                 continue;
             }
 
             if (resource.aliasGroupId.has_value()) {
                 aliasGroups[*resource.aliasGroupId].push_back(binding);
-                allocatedResourceIndices.push_back(binding.resourceIndex);
+                allocatedResources[binding.resourceIndex] = true;
                 continue;
             }
 
             switch (binding.descriptorType) {
             case vk::DescriptorType::eTensorARM:
-                allocateIntermediateTensor(binding);
+                if (aliasIntermediates) {
+                    arenaBindings.push_back(binding);
+                } else {
+                    allocateIntermediateTensor(binding);
+                }
                 break;
             case vk::DescriptorType::eStorageBuffer:
-                allocateIntermediateBuffer(binding);
+                if (aliasIntermediates) {
+                    arenaBindings.push_back(binding);
+                } else {
+                    allocateIntermediateBuffer(binding);
+                }
                 break;
             case vk::DescriptorType::eCombinedImageSampler:
             case vk::DescriptorType::eStorageImage:
@@ -878,123 +1080,112 @@ void Session::Impl::allocateResources() {
                 throw std::runtime_error("Session does not support descriptor type " +
                                          std::to_string(static_cast<uint32_t>(binding.descriptorType)));
             }
-            allocatedResourceIndices.push_back(binding.resourceIndex);
+            allocatedResources[binding.resourceIndex] = true;
         }
     }
 
+    if (!arenaBindings.empty()) {
+        allocateIntermediateArenas(arenaBindings);
+    }
+
     for (const auto &aliasGroup : aliasGroups) {
         allocateAliasedResources(aliasGroup.second);
     }
 }
 
-void Session::Impl::configureSegment(uint32_t segmentIndex) {
-    const auto segment = vgf.getSegment(segmentIndex);
-    if (segment.type != vgflib::ModuleType::GRAPH && segment.type != vgflib::ModuleType::COMPUTE) {
-        throw std::runtime_error("Session only supports VGF data graph and compute shader segments");
+void Session::Impl::allocateIntermediateArenas(const std::vector<DescriptorBindingInfo> &bindings) {
+    std::map<uint32_t, size_t> bindingIndices;
+    for (size_t index = 0; index < bindings.size(); ++index) {
+        bindingIndices[bindings[index].resourceIndex] = index;
     }
 
-    auto &state = segments.emplace_back();
-    state.type = segment.type;
-    state.bindings = vgf.getDescriptorBindings(segmentIndex);
-    const auto module = vgf.getSPIRVModule(segment.moduleIndex);
-    for (const auto &binding : state.bindings) {
-        if (binding.descriptorType != vk::DescriptorType::eStorageBuffer &&
-            binding.descriptorType != vk::DescriptorType::eTensorARM &&
-            binding.descriptorType != vk::DescriptorType::eCombinedImageSampler &&
-            binding.descriptorType != vk::DescriptorType::eStorageImage) {
-            throw std::runtime_error("Session does not support descriptor type " +
-                                     std::to_string(static_cast<uint32_t>(binding.descriptorType)));
-        }
-        if (binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
-            binding.descriptorType == vk::DescriptorType::eStorageImage) {
-            validateImageFormat(vgf.getResource(binding.resourceIndex).format);
+    std::vector<ArenaInterval> intervals(bindings.size());
+    std::vector<bool> used(bindings.size(), false);
+    for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
+        for (const auto &binding : segments[segmentIndex].compiled->bindings) {
+            const auto found = bindingIndices.find(binding.resourceIndex);
+            if (found == bindingIndices.end()) {
+                continue;
+            }
+            auto &interval = intervals[found->second];
+            if (!used[found->second]) {
+                interval.firstSegment = segmentIndex;
+                used[found->second] = true;
+            }
+            interval.lastSegment = segmentIndex;
         }
     }
 
-    const auto bindingSets = splitBindingsBySet(state.bindings);
-    state.descriptorSetLayouts.reserve(bindingSets.size());
-    for (const auto &setBindings : bindingSets) {
-        std::vector<vk::DescriptorSetLayoutBinding> layoutBindings;
-        layoutBindings.reserve(setBindings.size());
-        for (const auto &binding : setBindings) {
-            layoutBindings.emplace_back(binding.binding, binding.descriptorType, 1, vk::ShaderStageFlagBits::eAll);
+    // Images are excluded: their layout and contents would not survive being overwritten by an alias
+    std::vector<vk::raii::TensorARM> tensors;
+    std::vector<vk::raii::Buffer> buffers;
+    std::vector<uint32_t> memoryTypeBits;
+    tensors.reserve(bindings.size());
+    buffers.reserve(bindings.size());
+    memoryTypeBits.reserve(bindings.size());
+    for (size_t index = 0; index < bindings.size(); ++index) {
+        vk::MemoryRequirements memoryRequirements;
+        if (bindings[index].descriptorType == vk::DescriptorType::eTensorARM) {
+            tensors.push_back(createIntermediateTensor(bindings[index]));
+            buffers.emplace_back(nullptr);
+            memoryRequirements =
+                device.getTensorMemoryRequirementsARM(vk::TensorMemoryRequirementsInfoARM(*tensors.back()))
+                    .memoryRequirements;
+        } else {
+            tensors.emplace_back(nullptr);
+            buffers.push_back(createIntermediateBuffer(bindings[index]));
+            memoryRequirements = buffers.back().getMemoryRequirements();
         }
-        state.descriptorSetLayouts.emplace_back(device, vk::DescriptorSetLayoutCreateInfo({}, layoutBindings));
+        intervals[index].size = memoryRequirements.size;
+        intervals[index].alignment = memoryRequirements.alignment;
+        memoryTypeBits.push_back(memoryRequirements.memoryTypeBits);
+        intermediateMemory.unaliasedBytes += memoryRequirements.size;
     }
 
-    const auto descriptorSetLayouts = rawLayouts(state.descriptorSetLayouts);
-    const vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo({}, descriptorSetLayouts);
-    state.pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutCreateInfo);
-
-    const vk::ShaderModuleCreateInfo shaderCreateInfo({}, module.code.size() * sizeof(uint32_t), module.code.data());
-    state.shaderModule = vk::raii::ShaderModule(device, shaderCreateInfo);
-
-    if (segment.type == vgflib::ModuleType::COMPUTE) {
-        const auto dispatchShape = vgf.getDispatchShape(segmentIndex);
-        if (dispatchShape.size() != state.dispatchShape.size() || dispatchShape[0] == 0 || dispatchShape[1] == 0 ||
-            dispatchShape[2] == 0) {
-            throw std::runtime_error("VGF compute shader segments must have a non-zero 3D dispatch shape");
+    // One arena per set of allowed memory types, each packing intermediates whose lifetimes do not intersect
+    std::map<uint32_t, std::vector<size_t>> arenas;
+    for (size_t index = 0; index < bindings.size(); ++index) {
+        arenas[memoryTypeBits[index]].push_back(index);
+    }
+    for (const auto &[arenaMemoryTypeBits, indices] : arenas) {
+        std::vector<ArenaInterval> arenaIntervals;
+        arenaIntervals.reserve(indices.size());
+        vk::DeviceSize arenaAlignment = 1;
+        for (const auto index : indices) {
+            arenaIntervals.push_back(intervals[index]);
+            arenaAlignment = std::max(arenaAlignment, intervals[index].alignment);
         }
-        std::copy(dispatchShape.begin(), dispatchShape.end(), state.dispatchShape.begin());
-
-        const vk::PipelineShaderStageCreateInfo shaderStageCreateInfo({}, vk::ShaderStageFlagBits::eCompute,
-                                                                      *state.shaderModule, module.entryPoint.c_str());
-        const vk::ComputePipelineCreateInfo pipelineCreateInfo({}, shaderStageCreateInfo, *state.pipelineLayout);
-        const vk::raii::PipelineCache *pipelineCache = nullptr;
-        state.pipeline = vk::raii::Pipeline(device, pipelineCache, pipelineCreateInfo);
-    } else {
-        std::vector<vk::TensorDescriptionARM> tensorDescriptions;
-        std::vector<vk::DataGraphPipelineResourceInfoImageLayoutARM> imageLayouts;
-        std::vector<vk::DataGraphPipelineResourceInfoARM> resourceInfos;
-        tensorDescriptions.reserve(state.bindings.size());
-        imageLayouts.reserve(state.bindings.size());
-        resourceInfos.reserve(state.bindings.size());
-        for (const auto &binding : state.bindings) {
-            const auto resource = vgf.getResource(binding.resourceIndex);
-            const auto tensorTiling = binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
-                                              binding.descriptorType == vk::DescriptorType::eStorageImage
-                                          ? vk::TensorTilingARM::eOptimal
-                                          : vk::TensorTilingARM::eLinear;
-            tensorDescriptions.emplace_back(
-                tensorTiling, resource.format, static_cast<uint32_t>(resource.shape.size()), resource.shape.data(),
-                resource.stride.empty() ? nullptr : resource.stride.data(), vk::TensorUsageFlagBitsARM::eDataGraph);
-            if (binding.descriptorType == vk::DescriptorType::eCombinedImageSampler ||
-                binding.descriptorType == vk::DescriptorType::eStorageImage) {
-                imageLayouts.emplace_back(imageLayout(binding.descriptorType), &tensorDescriptions.back());
-                resourceInfos.emplace_back(binding.set, binding.binding, 0, &imageLayouts.back());
+        const auto arenaSize = assignArenaOffsets(arenaIntervals);
+        const auto allocation = allocateMemory(vk::MemoryRequirements(arenaSize, arenaAlignment, arenaMemoryTypeBits));
+        const vk::DeviceMemory memory = allocation.memory;
+        intermediateMemory.allocatedBytes += arenaSize;
+        intermediateAllocationBytes.push_back(arenaSize);
+
+        for (size_t arenaIndex = 0; arenaIndex < indices.size(); ++arenaIndex) {
+            const auto index = indices[arenaIndex];
+            const auto &interval = arenaIntervals[arenaIndex];
+            const auto offset = allocation.offset + interval.offset;
+            const BoundMemoryInfo boundMemory{memory, offset, interval.size};
+            if (bindings[index].descriptorType == vk::DescriptorType::eTensorARM) {
+                device.bindTensorMemoryARM(vk::BindTensorMemoryInfoARM(*tensors[index], memory, offset));
+                ownedTensors.push_back(std::move(tensors[index]));
+                addBoundTensor(*ownedTensors.back(), bindings[index], boundMemory);
             } else {
-                resourceInfos.emplace_back(binding.set, binding.binding, 0, &tensorDescriptions.back());
+                buffers[index].bindMemory(memory, offset);
+                ownedBuffers.push_back(std::move(buffers[index]));
+                addBoundBuffer(*ownedBuffers.back(), bindings[index], boundMemory);
             }
+            arenaResourceIndices.insert(bindings[index].resourceIndex);
         }
+    }
+}
 
-        const uint32_t numConstants = vgf.getNumConstants(segmentIndex);
-        std::vector<vk::TensorDescriptionARM> constantTensorDescriptions;
-        std::vector<vk::DataGraphPipelineConstantARM> constants;
-        constantTensorDescriptions.reserve(numConstants);
-        constants.reserve(numConstants);
-        for (uint32_t constantIndex = 0; constantIndex < numConstants; ++constantIndex) {
-            const auto constant = vgf.getConstant(segmentIndex, constantIndex);
-            if (constant.sparsityDimension >= 0) {
-                throw std::runtime_error("Sparse VGF graph constants are not supported");
-            }
-            constantTensorDescriptions.emplace_back(vk::TensorTilingARM::eLinear, constant.format,
-                                                    static_cast<uint32_t>(constant.shape.size()), constant.shape.data(),
-                                                    constant.stride.empty() ? nullptr : constant.stride.data(),
-                                                    vk::TensorUsageFlagBitsARM::eDataGraph);
-            constants.emplace_back(constant.graphConstantId, constant.data.data(), &constantTensorDescriptions.back());
-        }
+void Session::Impl::configureSegment(const CompiledSegment &compiled) {
+    auto &state = segments.emplace_back();
+    state.compiled = &compiled;
 
-        const vk::DataGraphPipelineShaderModuleCreateInfoARM shaderModuleInfo(
-            *state.shaderModule, module.entryPoint.c_str(), nullptr, static_cast<uint32_t>(constants.size()),
-            constants.data(), nullptr);
-        const vk::DataGraphPipelineCreateInfoARM pipelineCreateInfo({}, *state.pipelineLayout,
-                                                                    static_cast<uint32_t>(resourceInfos.size()),
-                                                                    resourceInfos.data(), &shaderModuleInfo);
-        const vk::raii::DeferredOperationKHR deferredOperation(nullptr);
-        const vk::raii::PipelineCache *pipelineCache = nullptr;
-        state.pipeline = vk::raii::Pipeline(device, deferredOperation, pipelineCache, pipelineCreateInfo);
-
-        const vk::DataGraphPipelineSessionCreateInfoARM sessionCreateInfo({}, *state.pipeline);
+    if (compiled.type == vgflib::ModuleType::GRAPH) {
+        const vk::DataGraphPipelineSessionCreateInfoARM sessionCreateInfo({}, *compiled.pipeline);
         state.graphSession = vk::raii::DataGraphPipelineSessionARM(device, sessionCreateInfo);
 
         const vk::DataGraphPipelineSessionBindPointRequirementsInfoARM bindPointInfo(*state.graphSession);
@@ -1013,111 +1204,365 @@ void Session::Impl::configureSegment(uint32_t segmentIndex) {
                     continue;
                 }
 
-                const auto memoryType = findMemoryType(physicalDevice, memReqs.memoryRequirements.memoryTypeBits,
-                                                       vk::MemoryPropertyFlagBits::eDeviceLocal);
-                const vk::MemoryAllocateInfo allocateInfo(memReqs.memoryRequirements.size, memoryType);
-                state.sessionMemory.emplace_back(device, allocateInfo);
+                const auto allocation = allocateMemory(memReqs.memoryRequirements);
+                state.sessionMemoryBytes += memReqs.memoryRequirements.size;
                 bindInfos.emplace_back(*state.graphSession, bindPointRequirement.bindPoint, objectIndex,
-                                       *state.sessionMemory.back());
+                                       allocation.memory, allocation.offset);
             }
         }
         if (!bindInfos.empty()) {
             device.bindDataGraphPipelineSessionMemoryARM(bindInfos);
         }
     }
+}
 
+void Session::Impl::allocateDescriptorSets() {
+    // A single pool sized for every segment and batch entry avoids one pool object per segment
     std::map<vk::DescriptorType, uint32_t> descriptorCounts;
-    for (const auto &binding : state.bindings) {
-        ++descriptorCounts[binding.descriptorType];
+    uint32_t setCount = 0;
+    for (const auto &segment : segments) {
+        for (const auto &binding : segment.compiled->bindings) {
+            descriptorCounts[binding.descriptorType] += batchSize;
+        }
+        setCount += static_cast<uint32_t>(segment.compiled->descriptorSetLayouts.size()) * batchSize;
     }
+    if (setCount == 0) {
+        return;
+    }
+
     std::vector<vk::DescriptorPoolSize> poolSizes;
     poolSizes.reserve(descriptorCounts.size());
     for (const auto &[type, count] : descriptorCounts) {
         poolSizes.emplace_back(type, count);
     }
-    state.descriptorPool =
-        vk::raii::DescriptorPool(device, {vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
-                                          static_cast<uint32_t>(state.descriptorSetLayouts.size()), poolSizes});
-    state.descriptorSets = device.allocateDescriptorSets({*state.descriptorPool, descriptorSetLayouts});
+    descriptorPool =
+        vk::raii::DescriptorPool(device, {vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet, setCount, poolSizes});
+    for (auto &segment : segments) {
+        const auto descriptorSetLayouts = rawLayouts(segment.compiled->descriptorSetLayouts);
+        segment.descriptorSets.resize(batchSize);
+        if (descriptorSetLayouts.empty()) {
+            continue;
+        }
+        for (auto &batchDescriptorSets : segment.descriptorSets) {
+            batchDescriptorSets = device.allocateDescriptorSets({*descriptorPool, descriptorSetLayouts});
+        }
+    }
 }
 
-void Session::Impl::configure() {
+void Session::Impl::configure(const std::vector<CompiledSegment> &compiledSegments) {
     if (configured) {
         throw std::runtime_error("Session::configure() must only be called once");
     }
 
-    segments.reserve(vgf.getNumSegments());
-    for (uint32_t segmentIndex = 0; segmentIndex < vgf.getNumSegments(); ++segmentIndex) {
-        configureSegment(segmentIndex);
+    if (ownedMemory.allocator == nullptr) {
+        ownedMemory.allocator = std::make_shared<DefaultAllocator>(physicalDevice, device);
+    }
+    segments.reserve(compiledSegments.size());
+    for (const auto &compiled : compiledSegments) {
+        configureSegment(compiled);
     }
+    allocateDescriptorSets();
     allocateResources();
 
     commandPool = vk::raii::CommandPool(device, {vk::CommandPoolCreateFlagBits::eResetCommandBuffer, queueFamilyIndex});
-    commandBuffer =
-        std::move(device.allocateCommandBuffers({*commandPool, vk::CommandBufferLevel::ePrimary, 1}).front());
-    fence = vk::raii::Fence(device, {vk::FenceCreateFlagBits::eSignaled});
-    configured = true;
-}
+    auto commandBuffers =
+        device.allocateCommandBuffers({*commandPool, vk::CommandBufferLevel::ePrimary, maxSubmissionsInFlight});
+    submissions.reserve(commandBuffers.size());
+    for (auto &commandBuffer : commandBuffers) {
+        submissions.push_back({std::move(commandBuffer)});
+    }
 
-void Session::Impl::run() {
-    if (!configured) {
-        throw std::runtime_error("Session::configure() must be called before Session::run()");
+    vk::SemaphoreTypeCreateInfo semaphoreTypeCreateInfo(vk::SemaphoreType::eTimeline, 0);
+    vk::SemaphoreCreateInfo semaphoreCreateInfo;
+    semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+    timelineSemaphore = vk::raii::Semaphore(device, semaphoreCreateInfo);
+
+    if (profiling && !segments.empty()) {
+        const auto timestampValidBits = physicalDevice.getQueueFamilyProperties()[queueFamilyIndex].timestampValidBits;
+        if (timestampValidBits == 0) {
+            throw std::runtime_error("Session profiling requires a queue family that supports timestamps");
+        }
+        if (timestampValidBits < 64) {
+            timestampMask = (uint64_t{1} << timestampValidBits) - 1;
+        }
+        timestampPeriod = physicalDevice.getProperties().limits.timestampPeriod;
+
+        const auto queriesPerSubmission = queryCount();
+        const vk::QueryPoolCreateInfo queryPoolCreateInfo({}, vk::QueryType::eTimestamp,
+                                                          queriesPerSubmission * maxSubmissionsInFlight);
+        queryPool = vk::raii::QueryPool(device, queryPoolCreateInfo);
+        for (uint32_t index = 0; index < static_cast<uint32_t>(submissions.size()); ++index) {
+            submissions[index].firstQuery = index * queriesPerSubmission;
+        }
     }
+    configured = true;
+}
 
-    for (const auto &segment : segments) {
-        updateDescriptorSets(segment.descriptorSets, segment.bindings);
+void Session::Impl::recordCommandBuffer(vk::raii::CommandBuffer &commandBuffer, uint32_t firstQuery) {
+    commandBuffer.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    if (profiling) {
+        commandBuffer.resetQueryPool(*queryPool, firstQuery, queryCount());
     }
 
-    waitForFence(device, fence);
-    device.resetFences(*fence);
-    commandBuffer.reset();
+    // Submissions may overlap on the queue, so order this one after the writes of the previous one
+    insertFullMemoryBarrier(commandBuffer);
 
-    commandBuffer.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
     insertInitialImageLayoutTransitions(commandBuffer);
-    for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
-        const auto &segment = segments[segmentIndex];
-        const auto pipelineBindPoint = bindPoint(segment.type);
-        for (uint32_t set = 0; set < static_cast<uint32_t>(segment.descriptorSets.size()); ++set) {
-            commandBuffer.bindDescriptorSets(pipelineBindPoint, *segment.pipelineLayout, set,
-                                             *segment.descriptorSets[set], nullptr);
-        }
-        commandBuffer.bindPipeline(pipelineBindPoint, *segment.pipeline);
-        if (segment.type == vgflib::ModuleType::GRAPH) {
-            commandBuffer.dispatchDataGraphARM(*segment.graphSession);
-        } else {
-            commandBuffer.dispatch(segment.dispatchShape[0], segment.dispatchShape[1], segment.dispatchShape[2]);
+    for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+        // Batch entries share intermediates and data graph session memory, so each starts after the previous one
+        if (batchIndex > 0) {
+            insertFullMemoryBarrier(commandBuffer);
         }
 
-        if (segmentIndex + 1 < segments.size()) {
-            insertSegmentBarrier(commandBuffer, segment, segments[segmentIndex + 1]);
+        for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
+            const auto &segment = segments[segmentIndex];
+            const auto &compiled = *segment.compiled;
+            const auto &descriptorSets = segment.descriptorSets[batchIndex];
+            const auto pipelineBindPoint = bindPoint(compiled.type);
+            for (uint32_t set = 0; set < static_cast<uint32_t>(descriptorSets.size()); ++set) {
+                commandBuffer.bindDescriptorSets(pipelineBindPoint, *compiled.pipelineLayout, set, *descriptorSets[set],
+                                                 nullptr);
+            }
+            commandBuffer.bindPipeline(pipelineBindPoint, *compiled.pipeline);
+            const auto segmentQuery =
+                firstQuery + static_cast<uint32_t>((batchIndex * segments.size() + segmentIndex) * 2);
+            if (profiling) {
+                commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, *queryPool, segmentQuery);
+            }
+            if (compiled.type == vgflib::ModuleType::GRAPH) {
+                commandBuffer.dispatchDataGraphARM(*segment.graphSession);
+            } else {
+                commandBuffer.dispatch(compiled.dispatchShape[0], compiled.dispatchShape[1],
+                                       compiled.dispatchShape[2]);
+            }
+            if (profiling) {
+                commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, *queryPool, segmentQuery + 1);
+            }
+
+            if (segmentIndex + 1 < segments.size()) {
+                insertSegmentBarrier(commandBuffer, compiled, *segments[segmentIndex + 1].compiled, batchIndex);
+            }
         }
     }
     commandBuffer.end();
+}
+
+uint64_t Session::Impl::submit(const std::vector<SemaphoreInfo> &waitSemaphores,
+                               const std::vector<SemaphoreInfo> &signalSemaphores) {
+    if (!configured) {
+        throw std::runtime_error("Session::configure() must be called before submitting work");
+    }
+
+    // Descriptor sets are shared by all submissions, so rebinding must wait for pending work to drain
+    if (descriptorSetsDirty) {
+        wait(submittedValue);
+        for (const auto &segment : segments) {
+            for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+                updateDescriptorSets(segment.descriptorSets[batchIndex], segment.compiled->bindings, batchIndex);
+            }
+        }
+        descriptorSetsDirty = false;
+    }
 
-    const vk::SubmitInfo submitInfo({}, {}, *commandBuffer);
-    queue.submit(submitInfo, *fence);
-    waitForFence(device, fence);
+    auto &submission = submissions[nextSubmission];
+    nextSubmission = (nextSubmission + 1) % submissions.size();
+    wait(submission.value);
+
+    submission.commandBuffer.reset();
+    recordCommandBuffer(submission.commandBuffer, submission.firstQuery);
+
+    const uint64_t value = submittedValue + 1;
+    const auto waitInfos = semaphoreSubmitInfos(waitSemaphores);
+    auto signalInfos = semaphoreSubmitInfos(signalSemaphores);
+    signalInfos.emplace_back(*timelineSemaphore, value, vk::PipelineStageFlagBits2::eAllCommands);
+    const vk::CommandBufferSubmitInfo commandBufferInfo(*submission.commandBuffer);
+
+    vk::SubmitInfo2 submitInfo;
+    submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos.size());
+    submitInfo.pWaitSemaphoreInfos = waitInfos.data();
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos.size());
+    submitInfo.pSignalSemaphoreInfos = signalInfos.data();
+    queue.submit2(submitInfo);
+
+    submission.value = value;
+    submittedValue = value;
+    return value;
+}
+
+void Session::Impl::wait(uint64_t value) const {
+    if (value == 0) {
+        return;
+    }
+    if (value > submittedValue) {
+        throw std::runtime_error("Cannot wait for submission " + std::to_string(value) +
+                                 " that has not been submitted");
+    }
+    waitForSemaphore(device, timelineSemaphore, value);
+}
+
+std::vector<Session::SegmentTiming> Session::Impl::getSegmentTimings(uint64_t value) const {
+    if (!profiling) {
+        throw std::runtime_error("Session::setProfiling() must enable profiling before configure()");
+    }
+    const auto submission = std::find_if(submissions.begin(), submissions.end(),
+                                         [value](const Submission &candidate) { return candidate.value == value; });
+    if (value == 0 || submission == submissions.end()) {
+        throw std::runtime_error("Timestamps of submission " + std::to_string(value) +
+                                 " are not available, only the last " + std::to_string(maxSubmissionsInFlight) +
+                                 " submissions are kept");
+    }
+    wait(value);
+    if (segments.empty()) {
+        return {};
+    }
+
+    const auto queries = queryCount();
+    const auto [_, timestamps] = queryPool.getResults<uint64_t>(
+        submission->firstQuery, queries, queries * sizeof(uint64_t), static_cast<vk::DeviceSize>(sizeof(uint64_t)),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+
+    std::vector<SegmentTiming> timings;
+    timings.reserve(segments.size());
+    for (uint32_t segmentIndex = 0; segmentIndex < static_cast<uint32_t>(segments.size()); ++segmentIndex) {
+        // Batched submissions report the total over every batch entry
+        uint64_t ticks = 0;
+        for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+            const auto query = (batchIndex * static_cast<uint32_t>(segments.size()) + segmentIndex) * 2;
+            const auto start = timestamps[query] & timestampMask;
+            const auto end = timestamps[query + 1] & timestampMask;
+            ticks += (end - start) & timestampMask;
+        }
+        timings.push_back({vgf.getSegment(segmentIndex).name, static_cast<double>(ticks) * timestampPeriod});
+    }
+    return timings;
+}
+
+bool Session::Impl::poll(uint64_t value) const {
+    if (value > submittedValue) {
+        throw std::runtime_error("Cannot poll submission " + std::to_string(value) + " that has not been submitted");
+    }
+    return value == 0 || timelineSemaphore.getCounterValue() >= value;
 }
 
 void Session::bindTensor(const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
-    impl_->bindTensor(tensor, binding, memory);
+    impl_->bindTensor(0, tensor, binding, memory);
 }
 
 void Session::bindBuffer(const vk::raii::Buffer &buffer, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
-    impl_->bindBuffer(buffer, binding, memory);
+    impl_->bindBuffer(0, buffer, binding, memory);
 }
 
 void Session::bindImage(const vk::raii::Image &image, DescriptorBindingInfo binding, BoundMemoryInfo memory) {
-    impl_->bindImage(image, binding, memory, imageLayout(binding.descriptorType));
+    impl_->bindImage(0, image, binding, memory, imageLayout(binding.descriptorType));
 }
 
 void Session::bindImage(const vk::raii::Image &image, DescriptorBindingInfo binding, vk::ImageLayout currentLayout,
                         BoundMemoryInfo memory) {
-    impl_->bindImage(image, binding, memory, currentLayout);
+    impl_->bindImage(0, image, binding, memory, currentLayout);
+}
+
+void Session::setBatchSize(uint32_t batchSize) {
+    if (impl_->configured) {
+        throw std::runtime_error("Session::setBatchSize() must be called before Session::configure()");
+    }
+    if (batchSize == 0) {
+        throw std::runtime_error("Session batch size must be at least 1");
+    }
+    impl_->batchSize = batchSize;
+}
+
+void Session::bindTensor(uint32_t batchIndex, const vk::raii::TensorARM &tensor, DescriptorBindingInfo binding,
+                         BoundMemoryInfo memory) {
+    impl_->bindTensor(batchIndex, tensor, binding, memory);
+}
+
+void Session::bindBuffer(uint32_t batchIndex, const vk::raii::Buffer &buffer, DescriptorBindingInfo binding,
+                         BoundMemoryInfo memory) {
+    impl_->bindBuffer(batchIndex, buffer, binding, memory);
 }
 
-void Session::configure() { impl_->configure(); }
+void Session::bindImage(uint32_t batchIndex, const vk::raii::Image &image, DescriptorBindingInfo binding,
+                        vk::ImageLayout currentLayout, BoundMemoryInfo memory) {
+    impl_->bindImage(batchIndex, image, binding, memory, currentLayout);
+}
 
-void Session::run() { impl_->run(); }
+void Session::setAllocator(std::shared_ptr<Allocator> allocator) {
+    if (impl_->configured) {
+        throw std::runtime_error("Session::setAllocator() must be called before Session::configure()");
+    }
+    if (allocator == nullptr) {
+        throw std::runtime_error("Session::setAllocator() requires an allocator");
+    }
+    impl_->ownedMemory.allocator = std::move(allocator);
+}
+
+void Session::setIntermediateMemoryAliasing(bool enable) {
+    if (impl_->configured) {
+        throw std::runtime_error("Session::setIntermediateMemoryAliasing() must be called before Session::configure()");
+    }
+    impl_->aliasIntermediates = enable;
+}
+
+void Session::setProfiling(bool enable) {
+    if (impl_->configured) {
+        throw std::runtime_error("Session::setProfiling() must be called before Session::configure()");
+    }
+    impl_->profiling = enable;
+}
+
+std::vector<Session::SegmentTiming> Session::getSegmentTimings(uint64_t value) const {
+    if (!impl_->configured) {
+        throw std::runtime_error("Session::configure() must be called before Session::getSegmentTimings()");
+    }
+    return impl_->getSegmentTimings(value);
+}
+
+Session::MemoryInfo Session::getMemoryInfo() const {
+    if (!impl_->configured) {
+        throw std::runtime_error("Session::configure() must be called before Session::getMemoryInfo()");
+    }
+    MemoryInfo info;
+    info.segmentSessionMemoryBytes.reserve(impl_->segments.size());
+    for (const auto &segment : impl_->segments) {
+        info.segmentSessionMemoryBytes.push_back(segment.sessionMemoryBytes);
+    }
+    info.intermediateAllocationBytes = impl_->intermediateAllocationBytes;
+    info.intermediates = impl_->intermediateMemory;
+    return info;
+}
+
+Session::IntermediateMemoryInfo Session::getIntermediateMemoryInfo() const {
+    if (!impl_->configured) {
+        throw std::runtime_error("Session::configure() must be called before Session::getIntermediateMemoryInfo()");
+    }
+    return impl_->intermediateMemory;
+}
+
+void Session::configure() {
+    if (impl_->graph == nullptr) {
+        impl_->graph = std::make_shared<const CompiledGraph>(impl_->device, impl_->vgf);
+    }
+    impl_->configure(impl_->graph->impl_->segments);
+}
+
+void Session::run() { impl_->wait(impl_->submit({}, {})); }
+
+uint64_t Session::submit(const std::vector<SemaphoreInfo> &waitSemaphores,
+                         const std::vector<SemaphoreInfo> &signalSemaphores) {
+    return impl_->submit(waitSemaphores, signalSemaphores);
+}
+
+void Session::wait(uint64_t value) const { impl_->wait(value); }
+
+bool Session::poll(uint64_t value) const { return impl_->poll(value); }
+
+vk::Semaphore Session::getTimelineSemaphore() const {
+    if (!impl_->configured) {
+        throw std::runtime_error("Session::configure() must be called before Session::getTimelineSemaphore()");
+    }
+    return *impl_->timelineSemaphore;
+}
 
 } // namespace mlsdk::vgf_runtime
@@ -51,5 +51,33 @@ inline uint32_t findMemoryType(const vk::raii::PhysicalDevice &physicalDevice, u
     throw std::runtime_error("Cannot find a compatible memory type");
 }
 
+inline std::vector<vk::DescriptorSetLayout>
+rawLayouts(const std::vector<vk::raii::DescriptorSetLayout> &descriptorSetLayouts) {
+    std::vector<vk::DescriptorSetLayout> layouts;
+    layouts.reserve(descriptorSetLayouts.size());
+    for (const auto &layout : descriptorSetLayouts) {
+        layouts.push_back(*layout);
+    }
+    return layouts;
+}
+
+inline void validateImageFormat(vk::Format format) {
+    if (format != vk::Format::eR8G8B8A8Snorm) {
+        throw std::runtime_error(
+            "VGF image resources must use eR8G8B8A8Snorm, the only image format CompiledGraph and Session support");
+    }
+}
+
+inline vk::ImageLayout imageLayout(vk::DescriptorType descriptorType) {
+    switch (descriptorType) {
+    case vk::DescriptorType::eCombinedImageSampler:
+        return vk::ImageLayout::eShaderReadOnlyOptimal;
+    case vk::DescriptorType::eStorageImage:
+        return vk::ImageLayout::eGeneral;
+    default:
+        throw std::runtime_error("Descriptor type is not an image descriptor");
+    }
+}
+
 } // namespace vulkan_helpers
 } // namespace vgf_runtime::detail
@@ -141,6 +141,7 @@ class RuntimeSessionExecutionTest : public ::testing::Test {
 
         vulkan12Features.storageBuffer8BitAccess = true;
         vulkan12Features.shaderInt8 = true;
+        vulkan12Features.timelineSemaphore = true;
         vulkan12Features.vulkanMemoryModel = true;
 
         vulkan13Features.synchronization2 = true;
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "utils.hpp"
+#include <vgf_runtime/session.hpp>
+
+#include <gtest/gtest.h>
+#include <vulkan/vulkan_core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Host allocations made while counting is enabled. Every VGF resource decode allocates, so a configuration that
+// looks resources up again while scanning the bound ones allocates quadratically in the resource count.
+std::atomic<bool> countingAllocations{false};
+std::atomic<uint64_t> allocationCount{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using namespace mlsdk::vgf_runtime;
+using namespace vgf_runtime::test;
+
+class VgfRuntimeConfigureTest : public RuntimeSessionExecutionTest {};
+
+const std::vector<mlsdk::vgflib::GraphConstantBindingRef> noGraphConstants;
+
+// Chain of add segments: every segment adds a fresh input to the previous intermediate, so each segment introduces
+// two resources and the VGF holds 2 * segments + 1 resources
+std::string makeAddChainVgf(uint32_t segments) {
+    const auto &code = assembleAddInt32BuffersSpirv();
+    return writeVgf([&](mlsdk::vgflib::Encoder &encoder) {
+        const auto module = encoder.AddModule(mlsdk::vgflib::ModuleType::COMPUTE, "add_int32_buffers", "main", code);
+
+        auto previous = encoder.AddInputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        for (uint32_t segment = 0; segment < segments; ++segment) {
+            const auto input =
+                encoder.AddInputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+            const auto output =
+                segment + 1 == segments
+                    ? encoder.AddOutputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4})
+                    : encoder.AddIntermediateResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+
+            const auto previousBinding = encoder.AddBindingSlot(0, previous);
+            const auto inputBinding = encoder.AddBindingSlot(1, input);
+            const auto outputBinding = encoder.AddBindingSlot(2, output);
+            const auto inputSet = encoder.AddDescriptorSetInfo({previousBinding, inputBinding}, 0);
+            const auto outputSet = encoder.AddDescriptorSetInfo({outputBinding}, 1);
+            encoder.AddSegmentInfo(module, "add_" + std::to_string(segment), {inputSet, outputSet},
+                                   {previousBinding, inputBinding}, {outputBinding}, noGraphConstants, {10, 1, 1});
+            previous = output;
+        }
+    });
+}
+
+/// Host allocations made by configure() on a session over an add chain of @p segments segments
+uint64_t configureAllocations(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device,
+                              uint32_t queueFamilyIndex, const vk::raii::Queue &queue, uint32_t segments) {
+    constexpr vk::DeviceSize bufferSize = 10 * sizeof(int32_t);
+
+    const auto bytes = makeAddChainVgf(segments);
+    const VGF vgf(bytes.data(), bytes.size());
+    const auto graph = std::make_shared<const CompiledGraph>(device, vgf);
+
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    buffers.reserve(segments + 2);
+    Session session(physicalDevice, device, queueFamilyIndex, queue, graph);
+    for (uint32_t segment = 0; segment < segments; ++segment) {
+        const auto bindings = vgf.getDescriptorBindings(segment);
+        if (segment == 0) {
+            buffers.push_back(std::make_unique<Buffer>(physicalDevice, device, bufferSize));
+            session.bindBuffer(buffers.back()->buffer, bindings[0]);
+        }
+        buffers.push_back(std::make_unique<Buffer>(physicalDevice, device, bufferSize));
+        session.bindBuffer(buffers.back()->buffer, bindings[1]);
+        if (segment + 1 == segments) {
+            buffers.push_back(std::make_unique<Buffer>(physicalDevice, device, bufferSize));
+            session.bindBuffer(buffers.back()->buffer, bindings[2]);
+        }
+    }
+
+    allocationCount = 0;
+    countingAllocations = true;
+    session.configure();
+    countingAllocations = false;
+    return allocationCount;
+}
+
+} // namespace
+
+TEST_F(VgfRuntimeConfigureTest, ConfigureScalesLinearlyWithResourceCount) {
+    // 1k and 8k resources: linear configuration allocates about 8 times as often, quadratic 64 times
+    constexpr uint32_t smallSegments = 500;
+    constexpr uint32_t largeSegments = 4000;
+    constexpr uint64_t maxRatio = 12;
+
+    const auto smallAllocations = configureAllocations(physicalDevice, device, queueFamilyIndex, queue, smallSegments);
+    const auto largeAllocations = configureAllocations(physicalDevice, device, queueFamilyIndex, queue, largeSegments);
+
+    ASSERT_GT(smallAllocations, 0U);
+    EXPECT_LT(largeAllocations, smallAllocations * maxRatio)
+        << "configure() made " << smallAllocations << " allocations for " << smallSegments << " segments and "
+        << largeAllocations << " allocations for " << largeSegments << " segments";
+}
@@ -14,6 +14,8 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -319,6 +321,69 @@ std::string makeOutputAliasedToIntermediateBufferVgf() {
     });
 }
 
+std::string makeIntermediateBufferChainVgf() {
+    const auto &code = assembleAddInt32BuffersSpirv();
+    return writeVgf([&](mlsdk::vgflib::Encoder &encoder) {
+        const auto module = encoder.AddModule(mlsdk::vgflib::ModuleType::COMPUTE, "add_int32_buffers", "main", code);
+
+        const auto firstInput =
+            encoder.AddInputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto secondInput =
+            encoder.AddInputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto zeroInput =
+            encoder.AddInputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto output = encoder.AddOutputResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto firstIntermediate =
+            encoder.AddIntermediateResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto secondIntermediate =
+            encoder.AddIntermediateResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+        const auto thirdIntermediate =
+            encoder.AddIntermediateResource(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_FORMAT_R32_SINT, {10}, {4});
+
+        const auto firstInputBinding = encoder.AddBindingSlot(0, firstInput);
+        const auto secondInputBinding = encoder.AddBindingSlot(1, secondInput);
+        const auto firstOutputBinding = encoder.AddBindingSlot(2, firstIntermediate);
+        const auto firstInputSet = encoder.AddDescriptorSetInfo({firstInputBinding, secondInputBinding}, 0);
+        const auto firstOutputSet = encoder.AddDescriptorSetInfo({firstOutputBinding}, 1);
+        encoder.AddSegmentInfo(module, "add_inputs", {firstInputSet, firstOutputSet},
+                               {firstInputBinding, secondInputBinding}, {firstOutputBinding}, noGraphConstants,
+                               {10, 1, 1});
+
+        const auto addCopySegment = [&](const std::string &name, auto source, auto destination) {
+            const auto sourceBinding = encoder.AddBindingSlot(0, source);
+            const auto zeroInputBinding = encoder.AddBindingSlot(1, zeroInput);
+            const auto destinationBinding = encoder.AddBindingSlot(2, destination);
+            const auto inputSet = encoder.AddDescriptorSetInfo({sourceBinding, zeroInputBinding}, 0);
+            const auto outputSet = encoder.AddDescriptorSetInfo({destinationBinding}, 1);
+            encoder.AddSegmentInfo(module, name, {inputSet, outputSet}, {sourceBinding, zeroInputBinding},
+                                   {destinationBinding}, noGraphConstants, {10, 1, 1});
+        };
+        addCopySegment("copy_first_intermediate", firstIntermediate, secondIntermediate);
+        addCopySegment("copy_second_intermediate", secondIntermediate, thirdIntermediate);
+        addCopySegment("copy_third_intermediate", thirdIntermediate, output);
+    });
+}
+
+class CountingAllocator : public Allocator {
+  public:
+    CountingAllocator(const vk::raii::PhysicalDevice &physicalDevice, const vk::raii::Device &device)
+        : allocator(physicalDevice, device) {}
+
+    MemoryAllocation allocate(const vk::MemoryRequirements &requirements, vk::MemoryPropertyFlags properties) override {
+        ++allocations;
+        return allocator.allocate(requirements, properties);
+    }
+
+    void free(const MemoryAllocation &allocation) override {
+        ++frees;
+        allocator.free(allocation);
+    }
+
+    DefaultAllocator allocator;
+    uint32_t allocations = 0;
+    uint32_t frees = 0;
+};
+
 } // namespace
 
 TEST_F(VgfRuntimeFullTest, RunComputeShaderSegment) {
@@ -771,3 +836,293 @@ TEST_F(VgfRuntimeFullTest, RunTwoMaxpoolGraphSegments) {
     const auto firstExpected = expectedMaxpool(firstInput, firstInputTensor.shape);
     EXPECT_EQ(secondOutputTensor.read(secondOutputTensor.numElements()), expectedMaxpool(firstExpected, {1, 8, 8, 16}));
 }
+
+TEST_F(VgfRuntimeFullTest, RunBatchedTwoMaxpoolGraphSegments) {
+    const auto bytes = makeTwoSegmentMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    constexpr uint32_t batchSize = 3;
+
+    std::vector<Tensor> inputTensors;
+    std::vector<Tensor> outputTensors;
+    std::vector<std::vector<int8_t>> inputs;
+    inputTensors.reserve(batchSize);
+    outputTensors.reserve(batchSize);
+    for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+        const std::vector<int64_t> inputShape = {1, 16, 16, 16};
+        const std::vector<int64_t> outputShape = {1, 4, 4, 16};
+        auto &inputTensor = inputTensors.emplace_back(physicalDevice, device, vk::Format::eR8Sint, inputShape);
+        auto &outputTensor = outputTensors.emplace_back(physicalDevice, device, vk::Format::eR8Sint, outputShape);
+        inputs.push_back(makeMaxpoolInput(inputTensor.shape, 43 + batchIndex * 6));
+        inputTensor.write(inputs.back());
+        outputTensor.fill(0, outputTensor.numElements());
+    }
+
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+    EXPECT_THROW(session.setBatchSize(0), std::runtime_error);
+    session.setBatchSize(batchSize);
+    for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+        session.bindTensor(batchIndex, inputTensors[batchIndex].tensor, vgf.getDescriptorBindings(0)[0]);
+        session.bindTensor(batchIndex, outputTensors[batchIndex].tensor, vgf.getDescriptorBindings(1)[1]);
+    }
+    EXPECT_THROW(session.bindTensor(batchSize, inputTensors[0].tensor, vgf.getDescriptorBindings(0)[0]),
+                 std::runtime_error);
+    session.configure();
+    EXPECT_THROW(session.setBatchSize(1), std::runtime_error);
+    session.run();
+
+    for (uint32_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+        const auto &outputTensor = outputTensors[batchIndex];
+        EXPECT_EQ(outputTensor.read(outputTensor.numElements()),
+                  expectedMaxpool(expectedMaxpool(inputs[batchIndex], inputTensors[batchIndex].shape), {1, 8, 8, 16}));
+    }
+}
+
+TEST_F(VgfRuntimeFullTest, SubmitMaxpoolWithoutWaiting) {
+    const auto bytes = makeMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 8, 8, 16});
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+
+    const auto bindings = vgf.getDescriptorBindings(0);
+    session.bindTensor(inputTensor.tensor, bindings[0]);
+    session.bindTensor(outputTensor.tensor, bindings[1]);
+    session.configure();
+
+    const auto input = makeMaxpoolInput(inputTensor.shape, 11);
+    inputTensor.write(input);
+    outputTensor.fill(0, outputTensor.numElements());
+
+    const auto value = session.submit();
+    EXPECT_EQ(value, 1);
+    session.wait(value);
+    EXPECT_TRUE(session.poll(value));
+    EXPECT_EQ(outputTensor.read(outputTensor.numElements()), expectedMaxpool(input, inputTensor.shape));
+}
+
+TEST_F(VgfRuntimeFullTest, SubmitMoreThanRingSizeInFlight) {
+    const auto bytes = makeMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 8, 8, 16});
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+
+    const auto bindings = vgf.getDescriptorBindings(0);
+    session.bindTensor(inputTensor.tensor, bindings[0]);
+    session.bindTensor(outputTensor.tensor, bindings[1]);
+    session.configure();
+
+    const auto input = makeMaxpoolInput(inputTensor.shape, 13);
+    inputTensor.write(input);
+    outputTensor.fill(0, outputTensor.numElements());
+
+    std::vector<uint64_t> values;
+    for (uint32_t i = 0; i < Session::maxSubmissionsInFlight * 2; ++i) {
+        values.push_back(session.submit());
+    }
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    session.wait(values.back());
+    for (const auto value : values) {
+        EXPECT_TRUE(session.poll(value));
+    }
+    EXPECT_EQ(outputTensor.read(outputTensor.numElements()), expectedMaxpool(input, inputTensor.shape));
+}
+
+TEST_F(VgfRuntimeFullTest, SubmitWaitsOnCallerTimelineSemaphore) {
+    const auto bytes = makeMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 8, 8, 16});
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+
+    const auto bindings = vgf.getDescriptorBindings(0);
+    session.bindTensor(inputTensor.tensor, bindings[0]);
+    session.bindTensor(outputTensor.tensor, bindings[1]);
+    session.configure();
+
+    const auto input = makeMaxpoolInput(inputTensor.shape, 17);
+    inputTensor.write(input);
+    outputTensor.fill(0, outputTensor.numElements());
+
+    vk::SemaphoreTypeCreateInfo semaphoreTypeCreateInfo(vk::SemaphoreType::eTimeline, 0);
+    vk::SemaphoreCreateInfo semaphoreCreateInfo;
+    semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+    const vk::raii::Semaphore inputReady(device, semaphoreCreateInfo);
+    const vk::raii::Semaphore outputReady(device, semaphoreCreateInfo);
+
+    const auto value = session.submit({{*inputReady, 1}}, {{*outputReady, 1}});
+    EXPECT_FALSE(session.poll(value));
+
+    device.signalSemaphore(vk::SemaphoreSignalInfo(*inputReady, 1));
+    session.wait(value);
+    EXPECT_EQ(outputReady.getCounterValue(), 1);
+    EXPECT_EQ(outputTensor.read(outputTensor.numElements()), expectedMaxpool(input, inputTensor.shape));
+}
+
+TEST_F(VgfRuntimeFullTest, RunSessionsSharingCompiledGraph) {
+    const auto bytes = makeTwoSegmentMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    const auto graph = std::make_shared<const CompiledGraph>(device, vgf);
+
+    Tensor firstInputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor firstOutputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 4, 4, 16});
+    Tensor secondInputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor secondOutputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 4, 4, 16});
+
+    const auto firstInput = makeMaxpoolInput(firstInputTensor.shape, 19);
+    const auto secondInput = makeMaxpoolInput(secondInputTensor.shape, 23);
+    firstInputTensor.write(firstInput);
+    secondInputTensor.write(secondInput);
+    firstOutputTensor.fill(0, firstOutputTensor.numElements());
+    secondOutputTensor.fill(0, secondOutputTensor.numElements());
+
+    const auto firstBindings = vgf.getDescriptorBindings(0);
+    const auto secondBindings = vgf.getDescriptorBindings(1);
+    Session firstSession(physicalDevice, device, queueFamilyIndex, queue, graph);
+    firstSession.bindTensor(firstInputTensor.tensor, firstBindings[0]);
+    firstSession.bindTensor(firstOutputTensor.tensor, secondBindings[1]);
+    firstSession.configure();
+
+    Session secondSession(physicalDevice, device, queueFamilyIndex, queue, graph);
+    secondSession.bindTensor(secondInputTensor.tensor, firstBindings[0]);
+    secondSession.bindTensor(secondOutputTensor.tensor, secondBindings[1]);
+    secondSession.configure();
+
+    firstSession.run();
+    secondSession.run();
+
+    EXPECT_EQ(firstOutputTensor.read(firstOutputTensor.numElements()),
+              expectedMaxpool(expectedMaxpool(firstInput, firstInputTensor.shape), {1, 8, 8, 16}));
+    EXPECT_EQ(secondOutputTensor.read(secondOutputTensor.numElements()),
+              expectedMaxpool(expectedMaxpool(secondInput, secondInputTensor.shape), {1, 8, 8, 16}));
+}
+
+TEST_F(VgfRuntimeFullTest, RunIntermediateBufferChainWithMemoryAliasing) {
+    constexpr size_t elements = 10;
+    constexpr vk::DeviceSize bufferSize = elements * sizeof(int32_t);
+
+    // VGF layout:
+    //   in0 + in1 -> tmp0, tmp0 + zero -> tmp1, tmp1 + zero -> tmp2, tmp2 + zero -> out
+    // tmp0 and tmp2 have disjoint lifetimes and share memory.
+    const auto bytes = makeIntermediateBufferChainVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    ASSERT_EQ(vgf.getNumSegments(), 4);
+
+    Buffer firstInputBuffer(physicalDevice, device, bufferSize);
+    Buffer secondInputBuffer(physicalDevice, device, bufferSize);
+    Buffer zeroInputBuffer(physicalDevice, device, bufferSize);
+    Buffer outputBuffer(physicalDevice, device, bufferSize);
+
+    const std::vector<int32_t> firstInput = {1, 3, 5, 7, 11, 13, 17, 19, 23, 29};
+    const std::vector<int32_t> secondInput = {2, 4, 6, 8, 10, 12, 14, 16, 18, 20};
+    const std::vector<int32_t> zeros(elements, 0);
+    firstInputBuffer.write(firstInput);
+    secondInputBuffer.write(secondInput);
+    zeroInputBuffer.write(zeros);
+    outputBuffer.write(zeros);
+
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+    session.setIntermediateMemoryAliasing(true);
+    const auto firstSegmentBindings = vgf.getDescriptorBindings(0);
+    session.bindBuffer(firstInputBuffer.buffer, firstSegmentBindings[0]);
+    session.bindBuffer(secondInputBuffer.buffer, firstSegmentBindings[1]);
+    session.bindBuffer(zeroInputBuffer.buffer, vgf.getDescriptorBindings(1)[1]);
+    session.bindBuffer(outputBuffer.buffer, vgf.getDescriptorBindings(3)[2]);
+    session.configure();
+    EXPECT_THROW(session.setIntermediateMemoryAliasing(false), std::runtime_error);
+
+    const auto memoryInfo = session.getIntermediateMemoryInfo();
+    EXPECT_GT(memoryInfo.allocatedBytes, 0);
+    EXPECT_LT(memoryInfo.allocatedBytes, memoryInfo.unaliasedBytes);
+
+    session.run();
+    session.run();
+
+    EXPECT_EQ(outputBuffer.read(elements), addVectors(firstInput, secondInput));
+}
+
+TEST_F(VgfRuntimeFullTest, RunMaxpoolGraphSegmentsWithCustomAllocator) {
+    const auto bytes = makeTwoSegmentMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+    const auto allocator = std::make_shared<CountingAllocator>(physicalDevice, device);
+
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 4, 4, 16});
+    const auto input = makeMaxpoolInput(inputTensor.shape, 29);
+    inputTensor.write(input);
+    outputTensor.fill(0, outputTensor.numElements());
+
+    {
+        Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+        session.setAllocator(allocator);
+        session.bindTensor(inputTensor.tensor, vgf.getDescriptorBindings(0)[0]);
+        session.bindTensor(outputTensor.tensor, vgf.getDescriptorBindings(1)[1]);
+        session.configure();
+        EXPECT_THROW(session.setAllocator(allocator), std::runtime_error);
+
+        // At least the intermediate tensor between the two segments comes from the allocator
+        EXPECT_GE(allocator->allocations, 1);
+        EXPECT_EQ(allocator->frees, 0);
+
+        session.run();
+    }
+    EXPECT_EQ(allocator->frees, allocator->allocations);
+
+    EXPECT_EQ(outputTensor.read(outputTensor.numElements()),
+              expectedMaxpool(expectedMaxpool(input, inputTensor.shape), {1, 8, 8, 16}));
+}
+
+TEST_F(VgfRuntimeFullTest, ProfileMaxpoolGraphSegments) {
+    const auto bytes = makeTwoSegmentMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 4, 4, 16});
+    const auto input = makeMaxpoolInput(inputTensor.shape, 31);
+    inputTensor.write(input);
+    outputTensor.fill(0, outputTensor.numElements());
+
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+    session.setProfiling(true);
+    session.bindTensor(inputTensor.tensor, vgf.getDescriptorBindings(0)[0]);
+    session.bindTensor(outputTensor.tensor, vgf.getDescriptorBindings(1)[1]);
+    session.configure();
+    EXPECT_THROW(session.setProfiling(false), std::runtime_error);
+
+    const auto memoryInfo = session.getMemoryInfo();
+    EXPECT_EQ(memoryInfo.segmentSessionMemoryBytes.size(), 2);
+    ASSERT_EQ(memoryInfo.intermediateAllocationBytes.size(), 1);
+    EXPECT_EQ(memoryInfo.intermediateAllocationBytes[0], memoryInfo.intermediates.allocatedBytes);
+
+    const auto firstValue = session.submit();
+    const auto secondValue = session.submit();
+    for (const auto value : {firstValue, secondValue}) {
+        const auto timings = session.getSegmentTimings(value);
+        ASSERT_EQ(timings.size(), 2);
+        EXPECT_EQ(timings[0].name, vgf.getSegment(0).name);
+        EXPECT_EQ(timings[1].name, vgf.getSegment(1).name);
+        EXPECT_GE(timings[0].durationNs, 0.0);
+        EXPECT_GE(timings[1].durationNs, 0.0);
+    }
+    EXPECT_THROW(session.getSegmentTimings(secondValue + 1), std::runtime_error);
+
+    EXPECT_EQ(outputTensor.read(outputTensor.numElements()),
+              expectedMaxpool(expectedMaxpool(input, inputTensor.shape), {1, 8, 8, 16}));
+}
+
+TEST_F(VgfRuntimeFullTest, SegmentTimingsRequireProfiling) {
+    const auto bytes = makeMaxpoolVgf();
+    const VGF vgf(bytes.data(), bytes.size());
+
+    Tensor inputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 16, 16, 16});
+    Tensor outputTensor(physicalDevice, device, vk::Format::eR8Sint, {1, 8, 8, 16});
+    inputTensor.write(makeMaxpoolInput(inputTensor.shape, 37));
+
+    Session session(physicalDevice, device, queueFamilyIndex, queue, vgf);
+    const auto bindings = vgf.getDescriptorBindings(0);
+    session.bindTensor(inputTensor.tensor, bindings[0]);
+    session.bindTensor(outputTensor.tensor, bindings[1]);
+    session.configure();
+
+    EXPECT_THROW(session.getSegmentTimings(session.submit()), std::runtime_error);
+}
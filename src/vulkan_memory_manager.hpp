@@ -26,7 +26,8 @@ class ResourceMemoryManager {
         if (_memSize == 0) {
             throw std::runtime_error("Allocated memory size must be non-zero");
         }
-        const vk::MemoryAllocateInfo memoryAllocateInfo(_memSize, findMemoryIdx(ctx, _memType, flags));
+        _memoryTypeIndex = findMemoryIdx(ctx, _memType, flags);
+        const vk::MemoryAllocateInfo memoryAllocateInfo(_memSize, _memoryTypeIndex);
         _deviceMemory = vk::raii::DeviceMemory(ctx.device(), memoryAllocateInfo);
 
         // Create the staging buffer
@@ -48,6 +49,7 @@ class ResourceMemoryManager {
 
         const vk::MemoryAllocateInfo memAllocInfo(memReqs.size, memTypeIndex);
         _stagingBufferDeviceMemory = vk::raii::DeviceMemory(ctx.device(), memAllocInfo);
+        _stagingMemSize = memReqs.size;
         _stagingBuffer.bindMemory(*_stagingBufferDeviceMemory, 0);
 
         _initalized = true;
@@ -92,9 +94,27 @@ class ResourceMemoryManager {
 
     uint32_t getMemType() const { return _memType; }
 
+    /// Index of the memory type the device memory was allocated from
+    uint32_t getMemoryTypeIndex() const { return _memoryTypeIndex; }
+
+    vk::DeviceSize getStagingMemSize() const { return _stagingMemSize; }
+
+    bool isStagingReleased() const { return _stagingReleased; }
+
     const vk::raii::DeviceMemory &getDeviceMemory() const { return _deviceMemory; }
 
-    const vk::raii::Buffer &getStagingBuffer() const { return _stagingBuffer; }
+    const vk::raii::Buffer &getStagingBuffer() const {
+        throwIfStagingReleased();
+        return _stagingBuffer;
+    }
+
+    /// Free the staging memory of resources that are no longer uploaded or downloaded
+    void releaseStagingMemory() {
+        _stagingBuffer = nullptr;
+        _stagingBufferDeviceMemory = nullptr;
+        _stagingMemSize = 0;
+        _stagingReleased = true;
+    }
 
     void *mapStagingBufferMemory(uint64_t offset, uint64_t size) const {
         if (!isInitalized()) {
@@ -103,6 +123,7 @@ class ResourceMemoryManager {
         if (offset + size > _memSize) {
             throw std::runtime_error("Attempt to map staging buffer memory out of bounds");
         }
+        throwIfStagingReleased();
         return _stagingBufferDeviceMemory.mapMemory(offset, size);
     }
 
@@ -114,6 +135,7 @@ class ResourceMemoryManager {
     }
 
     void uploadData(const Context &ctx, vk::DeviceSize offset, vk::DeviceSize size) const {
+        throwIfStagingReleased();
         // Create device buffer to copy data to
         vk::BufferCreateInfo bufferCreateInfo{
             vk::BufferCreateFlags(), size,   vk::BufferUsageFlagBits::eTransferDst, vk::SharingMode::eExclusive,
@@ -152,6 +174,7 @@ class ResourceMemoryManager {
     }
 
     void downloadData(const Context &ctx, vk::DeviceSize offset, vk::DeviceSize size) const {
+        throwIfStagingReleased();
         // Create device buffer to copy data from
         vk::BufferCreateInfo bufferCreateInfo{
             vk::BufferCreateFlags(), size,   vk::BufferUsageFlagBits::eTransferSrc, vk::SharingMode::eExclusive,
@@ -190,6 +213,12 @@ class ResourceMemoryManager {
     }
 
   private:
+    void throwIfStagingReleased() const {
+        if (_stagingReleased) {
+            throw std::runtime_error("Staging buffer memory has been released in low memory mode");
+        }
+    }
+
     vk::DeviceSize _memSize{0};
     vk::DeviceSize _subRecOffset{0};
     vk::DeviceSize _rowPitch{0};
@@ -198,10 +227,13 @@ class ResourceMemoryManager {
     vk::ImageType _imType{vk::ImageType::e2D};
     vk::Format _format{vk::Format::eUndefined};
     uint32_t _memType{UINT32_MAX};
+    uint32_t _memoryTypeIndex{UINT32_MAX};
+    vk::DeviceSize _stagingMemSize{0};
     vk::raii::DeviceMemory _deviceMemory{nullptr};
     bool _initalized{false};
     bool _isShared{false};
     bool _hasImageMetadata{false};
+    bool _stagingReleased{false};
     vk::raii::Buffer _stagingBuffer{nullptr};
     vk::raii::DeviceMemory _stagingBufferDeviceMemory{nullptr};
 };
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mlsdk::scenariorunner {
+
+namespace {
+
+/// Pause before a thread retries a task that could not make progress, unless another task is submitted meanwhile
+constexpr std::chrono::microseconds retryDelay{200};
+
+} // namespace
+
+struct WorkerPool::Impl {
+    struct Job {
+        Task task;
+        std::promise<void> done;
+    };
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeWorker.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                // Only reached when stopping with nothing left to run
+                return;
+            }
+            auto job = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+
+            bool finished = true;
+            try {
+                finished = job.task();
+                if (finished) {
+                    job.done.set_value();
+                }
+            } catch (...) {
+                job.done.set_exception(std::current_exception());
+            }
+
+            lock.lock();
+            if (!finished) {
+                queue.push_back(std::move(job));
+                const auto seenSubmissions = submissions;
+                wakeWorker.wait_for(lock, retryDelay,
+                                    [this, seenSubmissions] { return submissions != seenSubmissions; });
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wakeWorker;
+    std::deque<Job> queue;
+    size_t submissions{0};
+    bool stopping{false};
+    // Started last so that every other member is initialized before the threads run
+    std::vector<std::thread> threads;
+};
+
+WorkerPool::WorkerPool(size_t threadCount) : _impl(std::make_unique<Impl>()) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    _impl->threads.reserve(threadCount);
+    for (size_t threadIdx = 0; threadIdx < threadCount; ++threadIdx) {
+        _impl->threads.emplace_back(&Impl::run, _impl.get());
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->stopping = true;
+    }
+    _impl->wakeWorker.notify_all();
+    for (auto &thread : _impl->threads) {
+        thread.join();
+    }
+}
+
+std::future<void> WorkerPool::submit(Task task) {
+    Impl::Job job{std::move(task), {}};
+    auto done = job.done.get_future();
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->queue.push_back(std::move(job));
+        ++_impl->submissions;
+    }
+    _impl->wakeWorker.notify_all();
+    return done;
+}
+
+size_t WorkerPool::threadCount() const { return _impl->threads.size(); }
+
+} // namespace mlsdk::scenariorunner
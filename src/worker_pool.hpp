@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2026 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace mlsdk::scenariorunner {
+
+/// \brief Fixed set of threads running the tasks submitted to it
+///
+/// A task returns false when it cannot make progress yet, for example a deferred operation with no work for another
+/// thread. The task then goes to the back of the queue and its thread moves on to the next task, or sleeps until a
+/// task is submitted or a short retry delay passes, so waiting tasks never spin.
+///
+/// The destructor runs every queued task to completion before joining the threads.
+class WorkerPool {
+  public:
+    /// \brief Task run until it returns true
+    using Task = std::function<bool()>;
+
+    /// \brief Start @p threadCount threads, or one per hardware thread when zero
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// \brief Queue @p task, the future is ready once the task returns true or throws
+    std::future<void> submit(Task task);
+
+    size_t threadCount() const;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+} // namespace mlsdk::scenariorunner